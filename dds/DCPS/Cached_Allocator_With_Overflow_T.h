@@ -17,6 +17,10 @@
 
 #include "dds/DCPS/SafetyProfilePool.h"
 #include "PoolAllocationBase.h"
+#include "PoolAllocator.h"
+
+#include <algorithm>
+#include <utility>
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 # pragma once
@@ -40,17 +44,25 @@ namespace DCPS {
 * If the free list is empty then memory is allocated from the heap.
 * This way the allocations will not fail but may be slower.
 *
+* If @a max_chunks is larger than @a n_chunks the pool grows instead:
+* when the free list is empty another slab, as large as the pool
+* currently is, is added to it until @a max_chunks chunks exist.  The
+* heap is only used after that limit has been reached.  Slabs are
+* kept until the allocator is destroyed.
 */
 template <class T, class ACE_LOCK>
 class Cached_Allocator_With_Overflow : public ACE_New_Allocator, public PoolAllocationBase {
 public:
   /// Create a cached memory pool with @a n_chunks chunks
-  /// each with sizeof (TYPE) size.
-  Cached_Allocator_With_Overflow(size_t n_chunks)
+  /// each with sizeof (TYPE) size, which may grow up to
+  /// @a max_chunks chunks before the heap is used.
+  explicit Cached_Allocator_With_Overflow(size_t n_chunks, size_t max_chunks = 0)
     : allocs_from_heap_(0),
       allocs_from_pool_(0),
       frees_to_heap_(0),
       frees_to_pool_(0),
+      n_chunks_(n_chunks),
+      max_chunks_(max_chunks),
       free_list_(ACE_PURE_FREE_LIST) {
     // To maintain alignment requirements, make sure that each element
     // inserted into the free list is aligned properly for the platform.
@@ -63,24 +75,18 @@ public:
     // take care of the alignment for us), but then the ACE_NEW below would
     // require a default constructor on T - a requirement that is not in
     // previous versions of ACE
-    size_t chunk_size = sizeof(T);
-    chunk_size = ACE_MALLOC_ROUNDUP(chunk_size, ACE_MALLOC_ALIGN);
-    begin_ = static_cast<unsigned char*> (ACE_Allocator::instance()->malloc(n_chunks * chunk_size));
+    begin_ = add_slab(n_chunks);
 
     // Remember end of the pool.
-    end_ = begin_ + n_chunks * chunk_size;
-
-    // Put into free list using placement contructor, no real memory
-    // allocation in the <new> below.
-    for (size_t c = 0; c < n_chunks; c++) {
-      void* placement = begin_ + c * chunk_size;
-      this->free_list_.add(new(placement) ACE_Cached_Mem_Pool_Node<T>);
-    }
+    end_ = begin_ + n_chunks * chunk_size();
   }
 
   /// Clear things up.
   ~Cached_Allocator_With_Overflow() {
     ACE_Allocator::instance()->free(begin_);
+    for (size_t i = 0; i < slabs_.size(); ++i) {
+      ACE_Allocator::instance()->free(slabs_[i].first);
+    }
   }
   /**
   * Get a chunk of memory from free list cache.  Note that @a nbytes is
@@ -97,6 +103,10 @@ public:
     // ACE_Cached_Mem_Pool_Node's internal structure arranged.
     void* rtn =  this->free_list_.remove()->addr();
 
+    if (0 == rtn && grow()) {
+      rtn = this->free_list_.remove()->addr();
+    }
+
     if (0 == rtn) {
       rtn = ACE_Allocator::instance()->malloc(sizeof(T));
       allocs_from_heap_++;
@@ -155,8 +165,7 @@ public:
   /// Return a chunk of memory back to free list cache.
   void free(void * ptr) {
     unsigned char* tmp = static_cast<unsigned char*>(ptr);
-    if (tmp < begin_ ||
-        tmp >= end_) {
+    if ((tmp < begin_ || tmp >= end_) && !in_slab(tmp)) {
       ACE_Allocator::instance()->free(tmp);
       frees_to_heap_++;
 
@@ -212,18 +221,94 @@ public:
     return free_list_.size();
   };
 
+  /** How many chunks the pool holds, including those in use.
+  */
+  size_t capacity() {
+    ACE_GUARD_RETURN(ACE_LOCK, guard, slab_lock_, 0);
+    return n_chunks_;
+  }
+
   ACE_Atomic_Op<ACE_Thread_Mutex, unsigned long> allocs_from_heap_;
   ACE_Atomic_Op<ACE_Thread_Mutex, unsigned long> allocs_from_pool_;
   ACE_Atomic_Op<ACE_Thread_Mutex, unsigned long> frees_to_heap_ ;
   ACE_Atomic_Op<ACE_Thread_Mutex, unsigned long> frees_to_pool_;
 
 private:
+  static size_t chunk_size() {
+    return ACE_MALLOC_ROUNDUP(sizeof(T), ACE_MALLOC_ALIGN);
+  }
+
+  /// Allocate @a n_chunks chunks in one block and put them into the
+  /// free list.
+  unsigned char* add_slab(size_t n_chunks) {
+    const size_t size = chunk_size();
+    unsigned char* const slab =
+      static_cast<unsigned char*>(ACE_Allocator::instance()->malloc(n_chunks * size));
+    if (slab == 0) {
+      return 0;
+    }
+
+    // Put into free list using placement contructor, no real memory
+    // allocation in the <new> below.
+    for (size_t c = 0; c < n_chunks; c++) {
+      void* placement = slab + c * size;
+      this->free_list_.add(new(placement) ACE_Cached_Mem_Pool_Node<T>);
+    }
+    return slab;
+  }
+
+  /// Double the pool, bounded by max_chunks_.  Returns false if the
+  /// pool may not grow any further.
+  bool grow() {
+    ACE_GUARD_RETURN(ACE_LOCK, guard, slab_lock_, false);
+    if (free_list_.size()) {
+      return true;
+    }
+    if (n_chunks_ == 0 || n_chunks_ >= max_chunks_) {
+      return false;
+    }
+    const size_t n_chunks = (std::min)(n_chunks_, max_chunks_ - n_chunks_);
+    unsigned char* const slab = add_slab(n_chunks);
+    if (slab == 0) {
+      return false;
+    }
+    slabs_.push_back(std::make_pair(slab, slab + n_chunks * chunk_size()));
+    n_chunks_ += n_chunks;
+
+    if (DCPS_debug_level >= 2) {
+      ACE_DEBUG((LM_DEBUG,
+                 "(%P|%t) Cached_Allocator_With_Overflow::grow %@"
+                 " added %B chunks for a total of %B\n",
+                 this, n_chunks, n_chunks_));
+    }
+    return true;
+  }
+
+  bool in_slab(const unsigned char* ptr) {
+    ACE_GUARD_RETURN(ACE_LOCK, guard, slab_lock_, false);
+    for (size_t i = 0; i < slabs_.size(); ++i) {
+      if (ptr >= slabs_[i].first && ptr < slabs_[i].second) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   /// Remember how we allocate the memory in the first place so
   /// we can clear things up later.
   unsigned char* begin_;
   /// The end of the pool.
   unsigned char* end_;
 
+  /// Number of chunks in all slabs.
+  size_t n_chunks_;
+  /// Upper bound for n_chunks_ when growing.
+  size_t max_chunks_;
+  /// Slabs added by grow(), as [begin, end) ranges.
+  typedef std::pair<unsigned char*, unsigned char*> Slab;
+  OPENDDS_VECTOR(Slab) slabs_;
+  ACE_LOCK slab_lock_;
+
   /// Maintain a cached memory free list.
   ACE_Locked_Free_List<ACE_Cached_Mem_Pool_Node<T>, ACE_LOCK> free_list_;
 };
@@ -50,6 +50,12 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+namespace {
+  /// Factor by which the sample pools of a reader without a
+  /// max_samples limit may grow beyond their initial size.
+  const size_t POOL_GROWTH_LIMIT = 32;
+}
+
 DataReaderImpl::DataReaderImpl()
 : qos_(TheServiceParticipant->initial_DataReaderQos()),
   reverse_sample_lock_(sample_lock_),
@@ -1133,6 +1139,15 @@ DataReaderImpl::get_matched_publication_data(
 }
 #endif // !defined (DDS_HAS_MINIMUM_BIT)
 
+size_t
+DataReaderImpl::get_max_chunks() const
+{
+  // Without a max_samples limit the pools grow in slabs so that
+  // instance churn beyond n_chunks_ is still served from the pool.
+  return qos_.resource_limits.max_samples == DDS::LENGTH_UNLIMITED
+    ? n_chunks_ * POOL_GROWTH_LIMIT : 0;
+}
+
 DDS::ReturnCode_t
 DataReaderImpl::enable()
 {
@@ -1185,7 +1200,7 @@ DataReaderImpl::enable()
 
   //Note: the QoS used to set n_chunks_ is Changable=No so
   // it is OK that we cannot change the size of our allocators.
-  rd_allocator_.reset(new ReceivedDataAllocator(n_chunks_));
+  rd_allocator_.reset(new ReceivedDataAllocator(n_chunks_, get_max_chunks()));
 
   if (DCPS_debug_level >= 2)
     ACE_DEBUG((LM_DEBUG,"(%P|%t) DataReaderImpl::enable"
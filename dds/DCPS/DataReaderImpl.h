@@ -397,6 +397,9 @@ public:
   size_t get_n_chunks() const {
     return n_chunks_;
   }
+  /// Number of chunks the sample pools may grow to, 0 if they are
+  /// fixed at get_n_chunks().
+  size_t get_max_chunks() const;
 
   void liveliness_lost();
 
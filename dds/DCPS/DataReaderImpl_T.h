@@ -63,6 +63,12 @@ namespace OpenDDS {
       }
     };
 
+    /// Demarshaled sample shared with the other readers of this type.
+    class SharedMessage : public OpenDDS::DCPS::DemarshaledSample {
+    public:
+      MessageType message_;
+    };
+
     struct MessageTypeMemoryBlock {
       MessageTypeWithAllocator element_;
       ACE_New_Allocator* allocator_;
@@ -94,7 +100,7 @@ namespace OpenDDS {
      */
     virtual DDS::ReturnCode_t enable_specific ()
     {
-      data_allocator().reset(new DataAllocator(get_n_chunks ()));
+      data_allocator().reset(new DataAllocator(get_n_chunks(), get_max_chunks()));
       if (OpenDDS::DCPS::DCPS_debug_level >= 2)
         ACE_DEBUG((LM_DEBUG,
                    ACE_TEXT("(%P|%t) %CDataReaderImpl::")
@@ -156,6 +162,50 @@ namespace OpenDDS {
                     view_states, instance_states, 0);
     }
 
+    /**
+     * OpenDDS extension: take up to capacity samples directly into
+     * caller-owned arrays, which can be reused from call to call.  Samples
+     * are assigned into the existing elements, so members keep their
+     * storage wherever the type's assignment allows, and no sequence
+     * allocation or zero-copy loan is involved.  count is set to the
+     * number of samples taken.
+     */
+    DDS::ReturnCode_t take_into (
+                                 MessageType* samples,
+                                 DDS::SampleInfo* infos,
+                                 CORBA::ULong capacity,
+                                 CORBA::ULong& count,
+                                 DDS::SampleStateMask sample_states = DDS::ANY_SAMPLE_STATE,
+                                 DDS::ViewStateMask view_states = DDS::ANY_VIEW_STATE,
+                                 DDS::InstanceStateMask instance_states = DDS::ANY_INSTANCE_STATE)
+    {
+      count = 0;
+      if (!samples || !infos || capacity == 0)
+        {
+          return DDS::RETCODE_BAD_PARAMETER;
+        }
+
+      // Non-owning views of the arrays.  Starting at full length means
+      // setting the real length later only shrinks them, which never
+      // touches the elements.
+      MessageSequenceType received_data(capacity, capacity, samples, false);
+      DDS::SampleInfoSeq info_seq(capacity, capacity, infos, false);
+
+      DDS::ReturnCode_t ret;
+      {
+        ACE_GUARD_RETURN (ACE_Recursive_Thread_Mutex,
+                          guard,
+                          this->sample_lock_,
+                          DDS::RETCODE_ERROR);
+
+        ret = take_i(received_data, info_seq, static_cast<CORBA::Long>(capacity),
+                     sample_states, view_states, instance_states, 0);
+      }
+
+      count = received_data.length();
+      return ret;
+    }
+
     virtual DDS::ReturnCode_t read_w_condition (
                                                   MessageSequenceType & received_data,
                                                   DDS::SampleInfoSeq & sample_info,
@@ -1010,7 +1060,54 @@ protected:
                              bool & filtered,
                              OpenDDS::DCPS::MarshalingType marshaling_type)
   {
-    unique_ptr<MessageTypeWithAllocator> data(new (*data_allocator()) MessageTypeWithAllocator);
+    const bool key_only = marshaling_type == OpenDDS::DCPS::KEY_ONLY_MARSHALING;
+    unique_ptr<MessageTypeWithAllocator> data;
+
+    // Entries are only keyed by type name, so a different type with the
+    // same name is treated as a miss.
+    OpenDDS::DCPS::DemarshalCache* const cache = sample.demarshal_cache_;
+    const OpenDDS::DCPS::DemarshaledSample* const cached =
+      cache ? cache->find(TraitsType::type_name(), key_only) : 0;
+    const SharedMessage* const shared = dynamic_cast<const SharedMessage*>(cached);
+
+    if (shared) {
+      // Another reader in this process already demarshaled the sample.
+      data.reset(new (*data_allocator()) MessageTypeWithAllocator(shared->message_));
+
+    } else if (cache && !cached && !cache->full()) {
+      RcHandle<SharedMessage> message = make_rch<SharedMessage>();
+      if (!demarshal_payload(sample, message->message_, key_only)) {
+        return;
+      }
+      cache->insert(TraitsType::type_name(), key_only, message);
+      data.reset(new (*data_allocator()) MessageTypeWithAllocator(message->message_));
+
+    } else {
+      data.reset(new (*data_allocator()) MessageTypeWithAllocator);
+      if (!demarshal_payload(sample, *data, key_only)) {
+        return;
+      }
+    }
+
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+    if (!sample.header_.content_filter_) { // if this is true, the writer has already filtered
+      using OpenDDS::DCPS::ContentFilteredTopicImpl;
+      if (content_filtered_topic_) {
+        if (sample.header_.message_id_ == OpenDDS::DCPS::SAMPLE_DATA
+            && !content_filtered_topic_->filter(static_cast<MessageType&>(*data))) {
+          filtered = true;
+          return;
+        }
+      }
+    }
+#endif
+
+    store_instance_data(move(data), sample.header_, instance, just_registered, filtered);
+  }
+
+  bool demarshal_payload(const OpenDDS::DCPS::ReceivedDataSample& sample,
+                         MessageType& data, bool key_only)
+  {
     const bool cdr = sample.header_.cdr_encapsulation_;
 
     OpenDDS::DCPS::Serializer ser(
@@ -1024,7 +1121,7 @@ protected:
         ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) %CDataReaderImpl::dds_demarshal ")
                   ACE_TEXT("deserialization header failed, dropping sample.\n"),
                   TraitsType::type_name()));
-        return;
+        return false;
       }
 
       if (Serializer::use_rti_serialization()) {
@@ -1033,33 +1130,20 @@ protected:
       }
     }
 
-    if (marshaling_type == OpenDDS::DCPS::KEY_ONLY_MARSHALING) {
-      ser >> OpenDDS::DCPS::KeyOnly< MessageType>(*data);
+    if (key_only) {
+      ser >> OpenDDS::DCPS::KeyOnly< MessageType>(data);
     } else {
-      ser >> *data;
+      ser >> data;
     }
 
     if (!ser.good_bit()) {
       ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) %CDataReaderImpl::dds_demarshal ")
                  ACE_TEXT("deserialization failed, dropping sample.\n"),
                  TraitsType::type_name()));
-      return;
+      return false;
     }
 
-#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
-    if (!sample.header_.content_filter_) { // if this is true, the writer has already filtered
-      using OpenDDS::DCPS::ContentFilteredTopicImpl;
-      if (content_filtered_topic_) {
-        if (sample.header_.message_id_ == OpenDDS::DCPS::SAMPLE_DATA
-            && !content_filtered_topic_->filter(static_cast<MessageType&>(*data))) {
-          filtered = true;
-          return;
-        }
-      }
-    }
-#endif
-
-    store_instance_data(move(data), sample.header_, instance, just_registered, filtered);
+    return true;
   }
 
   virtual void dispose_unregister(const OpenDDS::DCPS::ReceivedDataSample& sample,
@@ -1781,7 +1865,7 @@ void store_instance_data(
 }
 
 void finish_store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_data, const DataSampleHeader& header,
-  SubscriptionInstance_rch instance_ptr, bool is_dispose_msg, bool is_unregister_msg )
+  const SubscriptionInstance_rch& instance_ptr, bool is_dispose_msg, bool is_unregister_msg )
 {
   if ((this->qos_.resource_limits.max_samples_per_instance !=
         DDS::LENGTH_UNLIMITED) &&
@@ -1326,7 +1326,7 @@ DataWriterImpl::enable()
 
   //Note: the QoS used to set n_chunks_ is Changable=No so
   // it is OK that we cannot change the size of our allocators.
-  data_container_ .reset(new WriteDataContainer(this,
+  unique_ptr<WriteDataContainer> container(new WriteDataContainer(this,
                                            max_samples_per_instance,
                                            history_depth,
                                            max_durable_per_instance,
@@ -1341,6 +1341,14 @@ DataWriterImpl::enable()
 #endif
                                            max_instances,
                                            max_total_samples));
+  {
+    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_,
+                     DDS::RETCODE_ERROR);
+    // The container isn't shared yet, so taking its lock here can't
+    // conflict with the order used elsewhere.
+    container->set_writable_condition(writable_condition_.in());
+    data_container_.reset(container.release());
+  }
 
   // +1 because we might allocate one before releasing another
   // TBD - see if this +1 can be removed.
@@ -2620,6 +2628,35 @@ DataWriterImpl::wait_pending()
   }
 }
 
+size_t
+DataWriterImpl::pending_samples()
+{
+  WriteDataContainer* container;
+  {
+    // enable() creates the container under lock_.
+    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
+    container = data_container_.get();
+  }
+
+  return container ? container->num_pending_samples() : 0;
+}
+
+void
+DataWriterImpl::set_writable_condition(DDS::GuardConditionInterf_ptr condition)
+{
+  WriteDataContainer* container;
+  {
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+    writable_condition_ = DDS::GuardConditionInterf::_duplicate(condition);
+    container = data_container_.get();
+  }
+
+  // Before enable() the condition is handed over with the container.
+  if (container) {
+    container->set_writable_condition(condition);
+  }
+}
+
 void
 DataWriterImpl::get_instance_handles(InstanceHandleVec& instance_handles)
 {
@@ -2644,6 +2681,12 @@ DataWriterImpl::retrieve_inline_qos_data(TransportSendListener::InlineQosData& q
   qos_data.topic_name = this->topic_name_.in();
 }
 
+Priority
+DataWriterImpl::transport_priority() const
+{
+  return this->qos_.transport_priority.value;
+}
+
 bool
 DataWriterImpl::need_sequence_repair()
 {
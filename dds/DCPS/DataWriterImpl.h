@@ -321,6 +321,8 @@ public:
 
   virtual void retrieve_inline_qos_data(TransportSendListener::InlineQosData& qos_data) const;
 
+  virtual Priority transport_priority() const;
+
   virtual bool check_transport_qos(const TransportInst& inst);
 
 #ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
@@ -434,6 +436,20 @@ public:
   /// Wait for pending samples to drain.
   void wait_pending();
 
+  /// Number of written samples the transport has not delivered yet.
+  size_t pending_samples();
+
+  /**
+   * Register a condition that is triggered once samples have been
+   * delivered after a write returned RETCODE_TIMEOUT because the
+   * resource limits were reached.  Combined with a max_blocking_time
+   * of zero this lets an application write without ever blocking and
+   * resume writing when the condition becomes active.  The
+   * application resets the trigger value.  The condition can be set
+   * before the writer is enabled.
+   */
+  void set_writable_condition(DDS::GuardConditionInterf_ptr condition);
+
   /**
    * Get an instance handle for a new instance.
    */
@@ -600,6 +616,9 @@ private:
   /// The lock to protect the activate subscriptions
   /// and status changes.
   ACE_Recursive_Thread_Mutex      lock_;
+  /// Kept here so it can be set before enable() creates data_container_,
+  /// protected by lock_.
+  DDS::GuardConditionInterf_var   writable_condition_;
 
   typedef OPENDDS_MAP_CMP(RepoId, DDS::InstanceHandle_t, GUID_tKeyLessThan) RepoIdToHandleMap;
 
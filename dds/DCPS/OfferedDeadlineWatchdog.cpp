@@ -34,7 +34,7 @@ OpenDDS::DCPS::OfferedDeadlineWatchdog::~OfferedDeadlineWatchdog()
 }
 
 void
-OpenDDS::DCPS::OfferedDeadlineWatchdog::schedule_timer(OpenDDS::DCPS::PublicationInstance_rch instance)
+OpenDDS::DCPS::OfferedDeadlineWatchdog::schedule_timer(const OpenDDS::DCPS::PublicationInstance_rch& instance)
 {
   if (instance->deadline_timer_id_ == -1) {
     intptr_t handle = instance->instance_handle_;
@@ -43,7 +43,7 @@ OpenDDS::DCPS::OfferedDeadlineWatchdog::schedule_timer(OpenDDS::DCPS::Publicatio
 }
 
 void
-OpenDDS::DCPS::OfferedDeadlineWatchdog::cancel_timer(OpenDDS::DCPS::PublicationInstance_rch instance)
+OpenDDS::DCPS::OfferedDeadlineWatchdog::cancel_timer(const OpenDDS::DCPS::PublicationInstance_rch& instance)
 {
   if (instance->deadline_timer_id_ != -1) {
     Watchdog::cancel_timer(instance->deadline_timer_id_);
@@ -69,7 +69,7 @@ OpenDDS::DCPS::OfferedDeadlineWatchdog::handle_timeout(const ACE_Time_Value&, co
 void
 OpenDDS::DCPS::OfferedDeadlineWatchdog::execute(
   DataWriterImpl& writer,
-  PublicationInstance_rch instance,
+  const PublicationInstance_rch& instance,
   bool timer_called)
 {
   if (instance->deadline_timer_id_ != -1) {
@@ -61,13 +61,13 @@ public:
    * @c DDS::OfferedDeadlineMissed structure, and calls
    * @c DataWriterListener::on_requested_deadline_missed().
    */
-  void execute(DataWriterImpl& writer, PublicationInstance_rch instance, bool timer_called);
+  void execute(DataWriterImpl& writer, const PublicationInstance_rch& instance, bool timer_called);
 
   // Schedule timer for the supplied instance.
-  void schedule_timer(PublicationInstance_rch instance);
+  void schedule_timer(const PublicationInstance_rch& instance);
 
   // Cancel timer for the supplied instance.
-  void cancel_timer(PublicationInstance_rch instance);
+  void cancel_timer(const PublicationInstance_rch& instance);
 
   /// Re-schedule timer for all instances of the DataWriter.
   virtual void reschedule_deadline();
@@ -0,0 +1,76 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "LeaseIndex.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace RTPS {
+
+void
+LeaseIndex::schedule(const DCPS::RepoId& id, const ACE_Time_Value& when)
+{
+  const ByTime::iterator check =
+    by_time_.insert(ByTime::value_type(when, id));
+  const std::pair<ById::iterator, bool> result =
+    by_id_.insert(ById::value_type(id, check));
+  if (!result.second) {
+    by_time_.erase(result.first->second);
+    result.first->second = check;
+  }
+}
+
+void
+LeaseIndex::schedule_by(const DCPS::RepoId& id, const ACE_Time_Value& when)
+{
+  const ById::iterator existing = by_id_.find(id);
+  if (existing == by_id_.end()) {
+    schedule(id, when);
+  } else if (when < existing->second->first) {
+    by_time_.erase(existing->second);
+    existing->second = by_time_.insert(ByTime::value_type(when, id));
+  }
+}
+
+void
+LeaseIndex::remove(const DCPS::RepoId& id)
+{
+  const ById::iterator existing = by_id_.find(id);
+  if (existing != by_id_.end()) {
+    by_time_.erase(existing->second);
+    by_id_.erase(existing);
+  }
+}
+
+void
+LeaseIndex::take_due(const ACE_Time_Value& now,
+                     OPENDDS_VECTOR(DCPS::RepoId)& due)
+{
+  while (!by_time_.empty() && by_time_.begin()->first < now) {
+    const ByTime::iterator check = by_time_.begin();
+    due.push_back(check->second);
+    by_id_.erase(check->second);
+    by_time_.erase(check);
+  }
+}
+
+bool
+LeaseIndex::scheduled(const DCPS::RepoId& id, ACE_Time_Value& when) const
+{
+  const ById::const_iterator existing = by_id_.find(id);
+  if (existing == by_id_.end()) {
+    return false;
+  }
+  when = existing->second->first;
+  return true;
+}
+
+} // namespace RTPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
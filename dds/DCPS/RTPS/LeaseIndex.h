@@ -0,0 +1,70 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_RTPS_LEASEINDEX_H
+#define OPENDDS_RTPS_LEASEINDEX_H
+
+#include "dds/DdsDcpsGuidC.h"
+#include "dds/DCPS/GuidUtils.h"
+#include "dds/DCPS/PoolAllocator.h"
+#include "rtps_export.h"
+
+#include "ace/Time_Value.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace RTPS {
+
+/**
+ * @class LeaseIndex
+ *
+ * @brief Participant lease checks ordered by the time they come due.
+ *
+ * Each participant has at most one scheduled check.  Renewing a lease
+ * doesn't have to touch the index: when a check comes due the caller
+ * either acts on it or schedules the next check at the lease's current
+ * end, so only the leases that may have run out are ever visited.
+ */
+class OpenDDS_Rtps_Export LeaseIndex {
+public:
+  /// Schedule the check for 'id' at 'when', replacing any other check.
+  void schedule(const DCPS::RepoId& id, const ACE_Time_Value& when);
+
+  /// Schedule the check for 'id' at 'when' unless one is already
+  /// scheduled at or before that time.
+  void schedule_by(const DCPS::RepoId& id, const ACE_Time_Value& when);
+
+  void remove(const DCPS::RepoId& id);
+
+  /// Remove the checks scheduled before 'now', appending their ids to
+  /// 'due' in the order they came due.
+  void take_due(const ACE_Time_Value& now, OPENDDS_VECTOR(DCPS::RepoId)& due);
+
+  /// Returns false if no check is scheduled for 'id'.
+  bool scheduled(const DCPS::RepoId& id, ACE_Time_Value& when) const;
+
+  size_t size() const { return by_id_.size(); }
+
+private:
+  typedef OPENDDS_MULTIMAP(ACE_Time_Value, DCPS::RepoId) ByTime;
+  typedef OPENDDS_MAP_CMP(DCPS::RepoId, ByTime::iterator,
+                          DCPS::GUID_tKeyLessThan) ById;
+  ByTime by_time_;
+  ById by_id_;
+};
+
+} // namespace RTPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_RTPS_LEASEINDEX_H */
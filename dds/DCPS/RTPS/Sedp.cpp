@@ -466,23 +466,24 @@ Sedp::Task::svc_i(const SPDPdiscoveredParticipantData* ppdata)
 
   //FUTURE: if/when topic propagation is supported, add it here
 
+  ACE_GUARD(ACE_Thread_Mutex, g, sedp_->lock_);
+
   // Process deferred publications and subscriptions.
   for (DeferredSubscriptionMap::iterator pos = sedp_->deferred_subscriptions_.lower_bound (proto.remote_id_),
          limit = sedp_->deferred_subscriptions_.upper_bound (proto.remote_id_);
        pos != limit;
        /* Increment in body. */) {
-    sedp_->data_received (pos->second.first, pos->second.second);
+    sedp_->data_received_i (pos->second.first, pos->second.second);
     sedp_->deferred_subscriptions_.erase (pos++);
   }
   for (DeferredPublicationMap::iterator pos = sedp_->deferred_publications_.lower_bound (proto.remote_id_),
          limit = sedp_->deferred_publications_.upper_bound (proto.remote_id_);
        pos != limit;
        /* Increment in body. */) {
-    sedp_->data_received (pos->second.first, pos->second.second);
+    sedp_->data_received_i (pos->second.first, pos->second.second);
     sedp_->deferred_publications_.erase (pos++);
   }
 
-  ACE_GUARD(ACE_Thread_Mutex, g, sedp_->lock_);
   if (spdp_->shutting_down()) { return; }
 
   proto.remote_id_.entityId = ENTITYID_PARTICIPANT;
@@ -914,16 +915,8 @@ Sedp::Task::shutdown()
 }
 
 void
-Sedp::Task::svc_i(DCPS::MessageId message_id,
-                  const OpenDDS::DCPS::DiscoveredWriterData* pwdata)
-{
-  DCPS::unique_ptr<const OpenDDS::DCPS::DiscoveredWriterData> delete_the_data(pwdata);
-  sedp_->data_received(message_id, *pwdata);
-}
-
-void
-Sedp::data_received(DCPS::MessageId message_id,
-                    const OpenDDS::DCPS::DiscoveredWriterData& wdata)
+Sedp::data_received_i(DCPS::MessageId message_id,
+                      const OpenDDS::DCPS::DiscoveredWriterData& wdata)
 {
   if (spdp_.shutting_down()) { return; }
 
@@ -931,7 +924,6 @@ Sedp::data_received(DCPS::MessageId message_id,
   RepoId guid_participant = guid;
   guid_participant.entityId = ENTITYID_PARTICIPANT;
 
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
   if (ignoring(guid)
       || ignoring(guid_participant)
       || ignoring(wdata.ddsPublicationData.topic_name)) {
@@ -1074,16 +1066,8 @@ Sedp::data_received(DCPS::MessageId message_id,
 }
 
 void
-Sedp::Task::svc_i(DCPS::MessageId message_id,
-                  const OpenDDS::DCPS::DiscoveredReaderData* prdata)
-{
-  DCPS::unique_ptr<const OpenDDS::DCPS::DiscoveredReaderData> delete_the_data(prdata);
-  sedp_->data_received(message_id, *prdata);
-}
-
-void
-Sedp::data_received(DCPS::MessageId message_id,
-                    const OpenDDS::DCPS::DiscoveredReaderData& rdata)
+Sedp::data_received_i(DCPS::MessageId message_id,
+                      const OpenDDS::DCPS::DiscoveredReaderData& rdata)
 {
   if (spdp_.shutting_down()) { return; }
 
@@ -1091,8 +1075,6 @@ Sedp::data_received(DCPS::MessageId message_id,
   RepoId guid_participant = guid;
   guid_participant.entityId = ENTITYID_PARTICIPANT;
 
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
-
   if (ignoring(guid)
       || ignoring(guid_participant)
       || ignoring(rdata.ddsSubscriptionData.topic_name)) {
@@ -1425,7 +1407,8 @@ Sedp::Writer::control_dropped(const DCPS::Message_Block_Ptr& /* sample */, bool)
 DDS::ReturnCode_t
 Sedp::Writer::write_sample(const ParameterList& plist,
                            const DCPS::RepoId& reader,
-                           DCPS::SequenceNumber& sequence)
+                           DCPS::SequenceNumber& sequence,
+                           DCPS::SendStateDataSampleList* batch)
 {
   DDS::ReturnCode_t result = DDS::RETCODE_OK;
 
@@ -1465,15 +1448,28 @@ Sedp::Writer::write_sample(const ParameterList& plist,
       list_el->set_num_subs(1);
     }
 
-    DCPS::SendStateDataSampleList list;
-    list.enqueue_tail(list_el);
+    if (batch) {
+      batch->enqueue_tail(list_el);
+    } else {
+      DCPS::SendStateDataSampleList list;
+      list.enqueue_tail(list_el);
 
-    send(list);
+      send(list);
+    }
   }
   delete payload.cont();
   return result;
 }
 
+void
+Sedp::Writer::send_batch(const DCPS::SendStateDataSampleList& batch)
+{
+  // TransportClient::send() brackets the whole list with send_start() and
+  // send_stop(), letting the transport pack the samples into as few RTPS
+  // messages as the maximum message size allows.
+  send(batch);
+}
+
 DDS::ReturnCode_t
 Sedp::Writer::write_sample(const ParticipantMessageData& pmd,
                            const DCPS::RepoId& reader,
@@ -1840,9 +1836,11 @@ void
 Sedp::write_durable_publication_data(const DCPS::RepoId& reader)
 {
   LocalPublicationIter pub, end = local_publications_.end();
+  DCPS::SendStateDataSampleList batch;
   for (pub = local_publications_.begin(); pub != end; ++pub) {
-    write_publication_data(pub->first, pub->second, reader);
+    write_publication_data(pub->first, pub->second, reader, &batch);
   }
+  publications_writer_.send_batch(batch);
   publications_writer_.end_historic_samples(reader);
 }
 
@@ -1850,9 +1848,11 @@ void
 Sedp::write_durable_subscription_data(const DCPS::RepoId& reader)
 {
   LocalSubscriptionIter sub, end = local_subscriptions_.end();
+  DCPS::SendStateDataSampleList batch;
   for (sub = local_subscriptions_.begin(); sub != end; ++sub) {
-    write_subscription_data(sub->first, sub->second, reader);
+    write_subscription_data(sub->first, sub->second, reader, &batch);
   }
+  subscriptions_writer_.send_batch(batch);
   subscriptions_writer_.end_historic_samples(reader);
 }
 
@@ -1870,7 +1870,8 @@ DDS::ReturnCode_t
 Sedp::write_publication_data(
     const RepoId& rid,
     LocalPublication& lp,
-    const DCPS::RepoId& reader)
+    const DCPS::RepoId& reader,
+    DCPS::SendStateDataSampleList* batch)
 {
   DDS::ReturnCode_t result = DDS::RETCODE_OK;
   if (spdp_.associated() && (reader != GUID_UNKNOWN ||
@@ -1888,7 +1889,7 @@ Sedp::write_publication_data(
       result = DDS::RETCODE_ERROR;
     }
     if (DDS::RETCODE_OK == result) {
-      result = publications_writer_.write_sample(plist, reader, lp.sequence_);
+      result = publications_writer_.write_sample(plist, reader, lp.sequence_, batch);
     }
   } else if (DCPS::DCPS_debug_level > 3) {
     ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) Sedp::write_publication_data - ")
@@ -1901,7 +1902,8 @@ DDS::ReturnCode_t
 Sedp::write_subscription_data(
     const RepoId& rid,
     LocalSubscription& ls,
-    const DCPS::RepoId& reader)
+    const DCPS::RepoId& reader,
+    DCPS::SendStateDataSampleList* batch)
 {
   DDS::ReturnCode_t result = DDS::RETCODE_OK;
   if (spdp_.associated() && (reader != GUID_UNKNOWN ||
@@ -1919,7 +1921,7 @@ Sedp::write_subscription_data(
       result = DDS::RETCODE_ERROR;
     }
     if (DDS::RETCODE_OK == result) {
-      result = subscriptions_writer_.write_sample(plist, reader, ls.sequence_);
+      result = subscriptions_writer_.write_sample(plist, reader, ls.sequence_, batch);
     }
   } else if (DCPS::DCPS_debug_level > 3) {
     ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) Sedp::write_subscription_data - ")
@@ -2020,10 +2022,9 @@ Sedp::Task::svc()
       svc_i(msg->dpdata_);
       break;
     case Msg::MSG_WRITER:
-      svc_i(msg->id_, msg->wdata_);
-      break;
     case Msg::MSG_READER:
-      svc_i(msg->id_, msg->rdata_);
+      delete_the_msg.release();
+      svc_endpoints(msg);
       break;
     case Msg::MSG_PARTICIPANT_DATA:
       svc_i(msg->id_, msg->pmdata_);
@@ -2056,6 +2057,58 @@ Sedp::Task::svc()
   return 0;
 }
 
+void
+Sedp::Task::svc_endpoints(Msg* first)
+{
+  // A remote participant with many endpoints announces them back-to-back,
+  // so drain everything of the same kind that is already waiting instead of
+  // taking the discovery lock once per endpoint.
+  static const size_t MAX_ENDPOINT_BATCH = 256;
+  MsgBatch batch;
+  batch.push_back(first);
+
+  Msg* next = 0;
+  ACE_Time_Value no_wait(ACE_Time_Value::zero);
+  while (batch.size() < MAX_ENDPOINT_BATCH &&
+         msg_queue()->peek_dequeue_head(next, &no_wait) != -1 &&
+         next->is_endpoint() &&
+         getq(next, &no_wait) != -1) {
+    batch.push_back(next);
+  }
+
+  if (DCPS::DCPS_debug_level > 5) {
+    ACE_DEBUG((LM_DEBUG, "(%P|%t) Sedp::Task::svc_endpoints "
+      "processing %B endpoint messages\n", batch.size()));
+  }
+
+  sedp_->data_received(batch);
+
+  for (MsgBatch::iterator it = batch.begin(); it != batch.end(); ++it) {
+    if ((*it)->type_ == Msg::MSG_WRITER) {
+      delete (*it)->wdata_;
+    } else {
+      delete (*it)->rdata_;
+    }
+    delete *it;
+  }
+}
+
+void
+Sedp::data_received(const MsgBatch& batch)
+{
+  if (spdp_.shutting_down()) { return; }
+
+  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  for (MsgBatch::const_iterator it = batch.begin(); it != batch.end(); ++it) {
+    if (spdp_.shutting_down()) { return; }
+    if ((*it)->type_ == Msg::MSG_WRITER) {
+      data_received_i((*it)->id_, *(*it)->wdata_);
+    } else {
+      data_received_i((*it)->id_, *(*it)->rdata_);
+    }
+  }
+}
+
 Sedp::Task::~Task()
 {
   shutdown();
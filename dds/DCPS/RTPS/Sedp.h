@@ -124,7 +124,10 @@ private:
       : type_(mt), id_(id), pmdata_(pmdata) {}
     Msg(MsgType mt, DCPS::MessageId id, DDS::InstanceHandle_t ih)
       : type_(mt), id_(id), ih_(ih) {}
+
+    bool is_endpoint() const { return type_ == MSG_WRITER || type_ == MSG_READER; }
   };
+  typedef OPENDDS_VECTOR(Msg*) MsgBatch;
 
   class Endpoint : public DCPS::TransportClient {
   public:
@@ -176,14 +179,21 @@ private:
     void remove_associations(const DCPS::ReaderIdSeq&, bool) {}
     void retrieve_inline_qos_data(InlineQosData&) const {}
 
+    /// If 'batch' is non-null the sample is appended to it instead of
+    /// being sent, see send_batch().
     DDS::ReturnCode_t write_sample(const ParameterList& plist,
                                    const DCPS::RepoId& reader,
-                                   DCPS::SequenceNumber& sequence);
+                                   DCPS::SequenceNumber& sequence,
+                                   DCPS::SendStateDataSampleList* batch = 0);
     DDS::ReturnCode_t write_sample(const ParticipantMessageData& pmd,
                                    const DCPS::RepoId& reader,
                                    DCPS::SequenceNumber& sequence);
     DDS::ReturnCode_t write_unregister_dispose(const DCPS::RepoId& rid);
 
+    /// Send all samples accumulated by write_sample() in one transport
+    /// send so they can share RTPS messages.
+    void send_batch(const DCPS::SendStateDataSampleList& batch);
+
     void end_historic_samples(const DCPS::RepoId& reader);
 
   private:
@@ -256,11 +266,13 @@ private:
     int svc();
 
     void svc_i(const SPDPdiscoveredParticipantData* pdata);
-    void svc_i(DCPS::MessageId id, const OpenDDS::DCPS::DiscoveredWriterData* wdata);
-    void svc_i(DCPS::MessageId id, const OpenDDS::DCPS::DiscoveredReaderData* rdata);
     void svc_i(DCPS::MessageId id, const ParticipantMessageData* data);
     void svc_i(Msg::MsgType which_bit, const DDS::InstanceHandle_t bit_ih);
 
+    /// Process 'first' along with the run of MSG_WRITER/MSG_READER messages
+    /// queued directly behind it.
+    void svc_endpoints(Msg* first);
+
     Spdp* spdp_;
     Sedp* sedp_;
     bool shutting_down_;
@@ -293,13 +305,19 @@ private:
   typedef LocalParticipantMessageMap::const_iterator LocalParticipantMessageCIter;
   LocalParticipantMessageMap local_participant_messages_;
 
-  void data_received(DCPS::MessageId message_id,
-                     const OpenDDS::DCPS::DiscoveredWriterData& wdata);
-  void data_received(DCPS::MessageId message_id,
-                     const OpenDDS::DCPS::DiscoveredReaderData& rdata);
   void data_received(DCPS::MessageId message_id,
                      const ParticipantMessageData& data);
 
+  /// Process a batch of DiscoveredWriterData/DiscoveredReaderData messages
+  /// under one acquisition of lock_.
+  void data_received(const MsgBatch& batch);
+
+  // lock_ must be held by the caller
+  void data_received_i(DCPS::MessageId message_id,
+                       const OpenDDS::DCPS::DiscoveredWriterData& wdata);
+  void data_received_i(DCPS::MessageId message_id,
+                       const OpenDDS::DCPS::DiscoveredReaderData& rdata);
+
   typedef std::pair<DCPS::MessageId, OpenDDS::DCPS::DiscoveredWriterData> MsgIdWtrDataPair;
   typedef OPENDDS_MAP_CMP(DCPS::RepoId, MsgIdWtrDataPair,
                    DCPS::GUID_tKeyLessThan) DeferredPublicationMap;
@@ -355,10 +373,12 @@ private:
 
   DDS::ReturnCode_t write_publication_data(const DCPS::RepoId& rid,
                                            LocalPublication& pub,
-                                           const DCPS::RepoId& reader = DCPS::GUID_UNKNOWN);
+                                           const DCPS::RepoId& reader = DCPS::GUID_UNKNOWN,
+                                           DCPS::SendStateDataSampleList* batch = 0);
   DDS::ReturnCode_t write_subscription_data(const DCPS::RepoId& rid,
                                             LocalSubscription& pub,
-                                            const DCPS::RepoId& reader = DCPS::GUID_UNKNOWN);
+                                            const DCPS::RepoId& reader = DCPS::GUID_UNKNOWN,
+                                            DCPS::SendStateDataSampleList* batch = 0);
   DDS::ReturnCode_t write_participant_message_data(const DCPS::RepoId& rid,
                                                    LocalParticipantMessage& part,
                                                    const DCPS::RepoId& reader = DCPS::GUID_UNKNOWN);
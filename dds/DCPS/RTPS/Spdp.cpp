@@ -165,6 +165,8 @@ Spdp::data_received(const DataSubmessage& data, const ParameterList& plist)
 
     // add a new participant
     participants_[guid] = DiscoveredParticipant(pdata, time);
+    lease_index_.schedule(guid,
+                          time + ACE_Time_Value(pdata.leaseDuration.seconds));
     DDS::InstanceHandle_t bit_instance_handle = DDS::HANDLE_NIL;
 #ifndef DDS_HAS_MINIMUM_BIT
     DCPS::ParticipantBuiltinTopicDataDataReaderImpl* bit = part_bit();
@@ -219,6 +221,9 @@ Spdp::data_received(const DataSubmessage& data, const ParameterList& plist)
     if (iter != participants_.end()) {
       iter->second.pdata_ = pdata;
       iter->second.last_seen_ = time;
+      // Only a shortened lease needs an earlier check.
+      lease_index_.schedule_by(guid,
+                               time + ACE_Time_Value(pdata.leaseDuration.seconds));
     }
   }
 }
@@ -228,28 +233,39 @@ Spdp::remove_expired_participants()
 {
   // Find and remove any expired discovered participant
   ACE_GUARD (ACE_Thread_Mutex, g, lock_);
-  // Iterate through a copy of the repo Ids, rather than the map
-  //   as it gets unlocked in remove_discovered_participant()
-  DCPS::RepoIdSet participant_ids;
-  get_discovered_participant_ids(participant_ids);
-  for (DCPS::RepoIdSet::iterator participant_id = participant_ids.begin();
-       participant_id != participant_ids.end();
+  const ACE_Time_Value now = ACE_OS::gettimeofday();
+
+  // Only visit the lease checks that have come due.  Iterate through a
+  // copy of their ids since remove_discovered_participant() unlocks.
+  OPENDDS_VECTOR(DCPS::RepoId) due;
+  lease_index_.take_due(now, due);
+
+  for (OPENDDS_VECTOR(DCPS::RepoId)::const_iterator participant_id = due.begin();
+       participant_id != due.end();
        ++participant_id)
   {
     DiscoveredParticipantIter part = participants_.find(*participant_id);
-    if (part != participants_.end()) {
-      if (part->second.last_seen_ <
-          ACE_OS::gettimeofday() -
-          ACE_Time_Value(part->second.pdata_.leaseDuration.seconds)) {
-        if (DCPS::DCPS_debug_level > 1) {
-          DCPS::GuidConverter conv(part->first);
-          ACE_DEBUG((LM_WARNING,
-            ACE_TEXT("(%P|%t) Spdp::remove_expired_participants() - ")
-            ACE_TEXT("participant %C exceeded lease duration, removing\n"),
-            OPENDDS_STRING(conv).c_str()));
-        }
-        remove_discovered_participant(part);
-      }
+    if (part == participants_.end()) {
+      continue;
+    }
+    const ACE_Time_Value lease(part->second.pdata_.leaseDuration.seconds);
+    if (part->second.last_seen_ >= now - lease) {
+      // Renewed since the check was scheduled
+      lease_index_.schedule_by(part->first, part->second.last_seen_ + lease);
+      continue;
+    }
+    if (DCPS::DCPS_debug_level > 1) {
+      DCPS::GuidConverter conv(part->first);
+      ACE_DEBUG((LM_WARNING,
+        ACE_TEXT("(%P|%t) Spdp::remove_expired_participants() - ")
+        ACE_TEXT("participant %C exceeded lease duration, removing\n"),
+        OPENDDS_STRING(conv).c_str()));
+    }
+    remove_discovered_participant(part);
+
+    // If it couldn't be removed, check it again on the next pass
+    if (participants_.find(*participant_id) != participants_.end()) {
+      lease_index_.schedule_by(*participant_id, now);
     }
   }
 }
@@ -19,6 +19,7 @@
 
 #include "RtpsCoreC.h"
 #include "Sedp.h"
+#include "LeaseIndex.h"
 #include "rtps_export.h"
 
 #include "ace/Atomic_Op.h"
@@ -122,6 +123,12 @@ private:
   void remove_expired_participants();
   void get_discovered_participant_ids(DCPS::RepoIdSet& results) const;
 
+  /// Lease checks for participants_.  Renewing a lease only updates
+  /// DiscoveredParticipant::last_seen_, a check that comes due is either
+  /// acted on, rescheduled at the lease's current end, or discarded if the
+  /// participant is gone.
+  LeaseIndex lease_index_;
+
   Sedp sedp_;
   // wait for acknowledgments from SpdpTransport and Sedp::Task
   // when BIT is being removed (fini_bit)
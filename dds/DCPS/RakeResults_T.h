@@ -45,7 +45,7 @@ public:
   /// Returns false if the sample will definitely not be part of the
   /// resulting dataset, however if this returns true it still may be
   /// excluded (due to sorting and max_samples).
-  bool insert_sample(ReceivedDataElement* sample, SubscriptionInstance_rch i,
+  bool insert_sample(ReceivedDataElement* sample, const SubscriptionInstance_rch& i,
                      size_t index_in_instance);
 
   bool copy_to_user();
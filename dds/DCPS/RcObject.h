@@ -12,11 +12,63 @@
 #include "dds/DCPS/PoolAllocationBase.h"
 #include "RcHandle_T.h"
 
+#ifdef ACE_HAS_CPP11
+#include <atomic>
+#endif
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
 namespace DCPS {
 
+  /// Reference count shared by RcObject and WeakObject.  Increments
+  /// only need to be atomic while decrements must also order the
+  /// owner's prior writes before the object is deleted.  Without C++11
+  /// this falls back to ACE_Atomic_Op, which uses a lock where the
+  /// platform has no native atomics.
+  class RcCount {
+  public:
+    explicit RcCount(long value)
+      : value_(value)
+    {
+    }
+
+#ifdef ACE_HAS_CPP11
+    void increment() {
+      value_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    long decrement() {
+      return value_.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+
+    long value() const {
+      return value_.load(std::memory_order_acquire);
+    }
+
+  private:
+    std::atomic<long> value_;
+#else
+    void increment() {
+      ++value_;
+    }
+
+    long decrement() {
+      return --value_;
+    }
+
+    long value() const {
+      return value_.value();
+    }
+
+  private:
+    ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> value_;
+#endif
+
+    RcCount(const RcCount&);
+    RcCount& operator=(const RcCount&);
+  };
+
   class RcObject;
 
   class WeakObject : public PoolAllocationBase
@@ -30,11 +82,11 @@ namespace DCPS {
     }
 
     void _add_ref() {
-      ++this->ref_count_;
+      this->ref_count_.increment();
     }
 
     void _remove_ref(){
-      const long new_count = --this->ref_count_;
+      const long new_count = this->ref_count_.decrement();
 
       if (new_count == 0) {
         delete this;
@@ -44,7 +96,7 @@ namespace DCPS {
     RcObject* lock();
     bool set_expire();
   private:
-    ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> ref_count_;
+    RcCount ref_count_;
     ACE_SYNCH_MUTEX mx_;
     RcObject* const ptr_;
     bool expired_;
@@ -58,11 +110,13 @@ namespace DCPS {
     }
 
     virtual void _add_ref() {
-      ++this->ref_count_;
+      this->ref_count_.increment();
     }
 
     virtual void _remove_ref() {
-      const long new_count = --this->ref_count_;
+      // The weak object's lock is only taken when the last strong
+      // reference goes away, copies on the data path stay lock-free.
+      const long new_count = this->ref_count_.decrement();
       if (new_count == 0 && weak_object_->set_expire()) {
         delete this;
       }
@@ -89,7 +143,7 @@ namespace DCPS {
 
   private:
 
-    ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> ref_count_;
+    RcCount ref_count_;
     WeakObject*  weak_object_;
 
     RcObject(const RcObject&);
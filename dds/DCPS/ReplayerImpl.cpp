@@ -946,6 +946,12 @@ ReplayerImpl::retrieve_inline_qos_data(TransportSendListener::InlineQosData& qos
   qos_data.topic_name = this->topic_name_.in();
 }
 
+Priority
+ReplayerImpl::transport_priority() const
+{
+  return this->qos_.transport_priority.value;
+}
+
 DDS::ReturnCode_t
 ReplayerImpl::write (const RawDataSample*   samples,
                      int                    num_samples,
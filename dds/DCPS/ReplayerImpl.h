@@ -128,6 +128,8 @@ public:
 
   virtual void retrieve_inline_qos_data(InlineQosData& qos_data) const;
 
+  virtual Priority transport_priority() const;
+
   // implement DataWriterCallbacks
   virtual void add_association(const RepoId&            yourId,
                                const ReaderAssociation& reader,
@@ -37,7 +37,7 @@ OpenDDS::DCPS::RequestedDeadlineWatchdog::~RequestedDeadlineWatchdog()
 
 void
 OpenDDS::DCPS::RequestedDeadlineWatchdog::schedule_timer(
-  OpenDDS::DCPS::SubscriptionInstance_rch instance)
+  const OpenDDS::DCPS::SubscriptionInstance_rch& instance)
 {
   if (instance->deadline_timer_id_ == -1) {
     intptr_t handle = instance->instance_handle_;
@@ -54,7 +54,7 @@ OpenDDS::DCPS::RequestedDeadlineWatchdog::schedule_timer(
 
 void
 OpenDDS::DCPS::RequestedDeadlineWatchdog::cancel_timer(
-  OpenDDS::DCPS::SubscriptionInstance_rch instance)
+  const OpenDDS::DCPS::SubscriptionInstance_rch& instance)
 {
   if (instance->deadline_timer_id_ != -1) {
     Watchdog::cancel_timer(instance->deadline_timer_id_);
@@ -82,7 +82,7 @@ OpenDDS::DCPS::RequestedDeadlineWatchdog::handle_timeout(const ACE_Time_Value&,
 }
 
 void
-OpenDDS::DCPS::RequestedDeadlineWatchdog::execute(SubscriptionInstance_rch instance, bool timer_called)
+OpenDDS::DCPS::RequestedDeadlineWatchdog::execute(const SubscriptionInstance_rch& instance, bool timer_called)
 {
   if (instance->deadline_timer_id_ != -1) {
     bool missed = false;
@@ -52,10 +52,10 @@ public:
   virtual ~RequestedDeadlineWatchdog();
 
   /// Schedule timer for the supplied instance.
-  void schedule_timer(OpenDDS::DCPS::SubscriptionInstance_rch instance);
+  void schedule_timer(const OpenDDS::DCPS::SubscriptionInstance_rch& instance);
 
   /// Cancel timer for the supplied instance.
-  void cancel_timer(OpenDDS::DCPS::SubscriptionInstance_rch instance);
+  void cancel_timer(const OpenDDS::DCPS::SubscriptionInstance_rch& instance);
 
   virtual int handle_timeout(const ACE_Time_Value&, const void* act);
 
@@ -65,7 +65,7 @@ public:
    * @c DDS::RequestedDeadlineMissed structure, and calls
    * @c DataReaderListener::on_requested_deadline_missed().
    */
-  void execute(OpenDDS::DCPS::SubscriptionInstance_rch, bool timer_called);
+  void execute(const OpenDDS::DCPS::SubscriptionInstance_rch&, bool timer_called);
 
   /// Re-schedule timer for all instances of the DataReader.
   virtual void reschedule_deadline();
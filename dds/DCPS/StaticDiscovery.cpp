@@ -21,20 +21,35 @@ namespace DCPS {
 
 void EndpointRegistry::match()
 {
+  // Bucket the readers by topic so that each writer is only compared with
+  // the readers of its own topic instead of every configured reader.
+  typedef OPENDDS_VECTOR(ReaderMapType::iterator) ReaderIterVec;
+  typedef OPENDDS_MAP(OPENDDS_STRING, ReaderIterVec) TopicReaderMapType;
+  TopicReaderMapType readers_by_topic;
+  for (ReaderMapType::iterator rp = reader_map.begin(), rp_limit = reader_map.end();
+       rp != rp_limit;
+       ++rp) {
+    readers_by_topic[rp->second.topic_name].push_back(rp);
+  }
+
   for (WriterMapType::iterator wp = writer_map.begin(), wp_limit = writer_map.end();
        wp != wp_limit;
        ++wp) {
     const RepoId& writerid = wp->first;
     Writer& writer = wp->second;
-    for (ReaderMapType::iterator rp = reader_map.begin(), rp_limit = reader_map.end();
+    const TopicReaderMapType::const_iterator bucket =
+      readers_by_topic.find(writer.topic_name);
+    if (bucket == readers_by_topic.end()) {
+      continue;
+    }
+    for (ReaderIterVec::const_iterator rp = bucket->second.begin(), rp_limit = bucket->second.end();
          rp != rp_limit;
          ++rp) {
-      const RepoId& readerid = rp->first;
-      Reader& reader = rp->second;
+      const RepoId& readerid = (*rp)->first;
+      Reader& reader = (*rp)->second;
 
       if (StaticDiscGuidDomainEqual()(readerid.guidPrefix, writerid.guidPrefix) &&
-          !StaticDiscGuidPartEqual()(readerid.guidPrefix, writerid.guidPrefix) &&
-          reader.topic_name == writer.topic_name) {
+          !StaticDiscGuidPartEqual()(readerid.guidPrefix, writerid.guidPrefix)) {
         // Different participants, same topic.
         IncompatibleQosStatus writerStatus = {0, 0, 0, DDS::QosPolicyCountSeq()};
         IncompatibleQosStatus readerStatus = {0, 0, 0, DDS::QosPolicyCountSeq()};
@@ -756,6 +771,8 @@ namespace {
 int
 StaticDiscovery::load_configuration(ACE_Configuration_Heap& cf)
 {
+  const ACE_Time_Value start = ACE_OS::gettimeofday();
+
   if (parse_topics(cf) ||
       parse_datawriterqos(cf) ||
       parse_datareaderqos(cf) ||
@@ -765,8 +782,19 @@ StaticDiscovery::load_configuration(ACE_Configuration_Heap& cf)
     return -1;
   }
 
+  const ACE_Time_Value parsed = ACE_OS::gettimeofday();
   registry.match();
 
+  if (DCPS_debug_level > 0) {
+    const ACE_Time_Value matched = ACE_OS::gettimeofday();
+    ACE_DEBUG((LM_DEBUG,
+               ACE_TEXT("(%P|%t) StaticDiscovery::load_configuration ")
+               ACE_TEXT("%B writers, %B readers: parsed in %d ms, matched in %d ms\n"),
+               registry.writer_map.size(), registry.reader_map.size(),
+               static_cast<int>((parsed - start).msec()),
+               static_cast<int>((matched - parsed).msec())));
+  }
+
   return 0;
 }
 
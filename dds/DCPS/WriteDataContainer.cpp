@@ -96,8 +96,10 @@ WriteDataContainer::WriteDataContainer(
     max_num_samples_(max_total_samples),
     max_blocking_time_(max_blocking_time),
     waiting_on_release_(false),
+    writable_pending_(false),
     condition_(lock_),
     empty_condition_(lock_),
+    delivering_(false),
     wfa_condition_(this->wfa_lock_),
     n_chunks_(n_chunks),
     sample_list_element_allocator_(2 * n_chunks_),
@@ -537,10 +539,55 @@ WriteDataContainer::data_delivered(const DataSampleElement* sample)
                           ACE_TEXT(" %@\n"), sample));
   }
 
-  ACE_GUARD(ACE_Recursive_Thread_Mutex,
-            guard,
-            this->lock_);
+  // The transport thread should not queue up behind a writing thread.
+  // If the container is busy the sample is handed to the one thread
+  // that is already waiting for the lock to process deliveries.
+  ACE_Guard<ACE_Recursive_Thread_Mutex> guard(this->lock_, 0);
+
+  if (guard.locked()) {
+    data_delivered_i(sample);
+    return;
+  }
+
+  {
+    ACE_GUARD(ACE_Thread_Mutex, delivered_guard, this->delivered_lock_);
+    delivered_.push_back(sample);
+    if (delivering_) {
+      return;
+    }
+    delivering_ = true;
+  }
+
+  if (guard.acquire() == -1) {
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) ERROR: WriteDataContainer::data_delivered, ")
+               ACE_TEXT("failed to acquire lock\n")));
+    ACE_GUARD(ACE_Thread_Mutex, delivered_guard, this->delivered_lock_);
+    delivering_ = false;
+    return;
+  }
+
+  for (;;) {
+    DeliveredSamples delivered;
+    {
+      ACE_GUARD(ACE_Thread_Mutex, delivered_guard, this->delivered_lock_);
+      if (delivered_.empty()) {
+        delivering_ = false;
+        break;
+      }
+      delivered.swap(delivered_);
+    }
+
+    for (DeliveredSamples::const_iterator it = delivered.begin();
+         it != delivered.end(); ++it) {
+      data_delivered_i(*it);
+    }
+  }
+}
 
+void
+WriteDataContainer::data_delivered_i(const DataSampleElement* sample)
+{
   // Delivered samples _must_ be on sending_data_ list
 
   // If it is not found in one of the lists, an invariant
@@ -660,6 +707,7 @@ WriteDataContainer::data_delivered(const DataSampleElement* sample)
     }
 
     this->wakeup_blocking_writers (stale);
+    this->notify_writable();
   }
   if (DCPS_debug_level > 9) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) WriteDataContainer::data_delivered: ")
@@ -796,6 +844,7 @@ WriteDataContainer::data_dropped(const DataSampleElement* sample,
   }
 
   this->wakeup_blocking_writers (stale);
+  this->notify_writable();
 
   if (!pending_data())
     empty_condition_.broadcast();
@@ -1167,6 +1216,9 @@ WriteDataContainer::obtain_buffer(DataSampleElement*& element,
                               ACE_TEXT(" releasing allotted sample and returning\n"),
                               handle));
       }
+      if (ret == DDS::RETCODE_TIMEOUT) {
+        writable_pending_ = true;
+      }
       this->release_buffer(element);
       return ret;
     }
@@ -1493,6 +1545,32 @@ WriteDataContainer::wakeup_blocking_writers (DataSampleElement* stale)
   }
 }
 
+void
+WriteDataContainer::notify_writable()
+{
+  if (writable_pending_ && !CORBA::is_nil(writable_condition_.in())) {
+    writable_pending_ = false;
+    writable_condition_->set_trigger_value(true);
+  }
+}
+
+size_t
+WriteDataContainer::num_pending_samples()
+{
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex,
+                   guard,
+                   this->lock_,
+                   0);
+  return unsent_data_.size() + sending_data_.size();
+}
+
+void
+WriteDataContainer::set_writable_condition(DDS::GuardConditionInterf_ptr condition)
+{
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+  writable_condition_ = DDS::GuardConditionInterf::_duplicate(condition);
+}
+
 void
 WriteDataContainer::log_send_state_lists (OPENDDS_STRING description)
 {
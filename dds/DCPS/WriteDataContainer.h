@@ -261,6 +261,8 @@ public:
    * this container will be moved from sending_data_ list to the
    * internal sent_data_ list. If there are any threads waiting for
    * available space, it wakes up these threads.
+   * If another thread holds the container lock the sample may be
+   * processed later by the transport thread already waiting for it.
    */
   void data_delivered(const DataSampleElement* sample);
 
@@ -334,6 +336,19 @@ public:
    */
   void wait_pending();
 
+  /**
+   * Return the number of samples that have not been delivered
+   * yet.  This includes sending and unsent data.
+   */
+  size_t num_pending_samples();
+
+  /**
+   * Set the condition that is triggered when a sample has been
+   * delivered after obtain_buffer() failed because of resource
+   * limits.  Passing nil removes the condition.
+   */
+  void set_writable_condition(DDS::GuardConditionInterf_ptr condition);
+
   /**
    * Returns a vector of handles for the instances registered for this
    * data writer.
@@ -405,6 +420,13 @@ private:
 
   void log_send_state_lists (OPENDDS_STRING description);
 
+  /// Process a delivered sample, lock_ must be held.
+  void data_delivered_i(const DataSampleElement* sample);
+
+  /// Trigger writable_condition_ if a write ran into the resource
+  /// limits since it was last triggered.
+  void notify_writable();
+
   DisjointSequence acked_sequences_;
 
   /// List of data that has not been sent yet.
@@ -474,6 +496,14 @@ private:
   /// The block waiting flag.
   bool                            waiting_on_release_;
 
+  /// Set when obtain_buffer() gave up because of resource limits,
+  /// cleared when writable_condition_ is triggered.
+  bool                            writable_pending_;
+
+  /// Condition triggered when space frees up after writable_pending_
+  /// was set.
+  DDS::GuardConditionInterf_var   writable_condition_;
+
   /// This lock is used to protect the container and the map
   /// in the type-specific DataWriter.
   /// This lock can be accessible via the datawriter.
@@ -487,6 +517,14 @@ private:
   ACE_Condition<ACE_Recursive_Thread_Mutex> condition_;
   ACE_Condition<ACE_Recursive_Thread_Mutex> empty_condition_;
 
+  /// Samples delivered while lock_ was held by another thread.  They
+  /// are processed in a batch by the thread that set delivering_,
+  /// which is the only transport thread blocked on lock_.
+  typedef OPENDDS_VECTOR(const DataSampleElement*) DeliveredSamples;
+  DeliveredSamples delivered_;
+  bool delivering_;
+  ACE_Thread_Mutex delivered_lock_;
+
   /// Lock used for wait_for_acks() processing.
   ACE_Thread_Mutex wfa_lock_;
 
@@ -23,6 +23,7 @@ namespace OpenDDS {
 namespace DCPS {
 
 class TransportSendListener;
+class TransportSendElement;
 class DataSampleElement;
 class DataLinkSet;
 typedef RcHandle<DataLinkSet> DataLinkSet_rch;
@@ -45,6 +46,15 @@ public:
   /// Send a control message that is wrapped in a DataSampleElement
   void send_control(DataSampleElement* sample);
 
+  typedef OPENDDS_VECTOR(DataLink_rch) LinkList;
+
+  /// Send to each DataLink in links, which need not be members of a set.
+  static void send(DataSampleElement* sample, const LinkList& links);
+
+  /// Send a control message that is wrapped in a DataSampleElement to
+  /// each DataLink in links.
+  static void send_control(DataSampleElement* sample, const LinkList& links);
+
   /// Send control message to each DataLink in the set.
   SendControlStatus send_control(RepoId                           pub_id,
                                  const TransportSendListener_rch& listener,
@@ -63,6 +73,9 @@ public:
   /// the links from link_set to *this.
   void send_start(DataLinkSet* link_set);
 
+  /// Same as above for links that are not held in a DataLinkSet.
+  void send_start(const LinkList& links);
+
   /// Calls send_stop() on the links with ID repoId and then
   /// clears the set.
   void send_stop(RepoId repoId);
@@ -87,6 +100,15 @@ public:
 
 private:
 
+  /// Hands sample (or a copy customized for link) to link.
+  static void send_to(const DataLink_rch& link,
+                      TransportSendElement* send_element,
+                      DataSampleElement* sample,
+                      bool custom_header);
+
+  /// Adds link to map_ and tells it about send_start() if it is new.
+  void send_start_i(const DataLinkIdType& id, const DataLink_rch& link);
+
   /// Hash map for DataLinks.
   MapType map_;
 
@@ -18,6 +18,45 @@
 #include "TransportCustomizedElement.h"
 #endif
 
+ACE_INLINE void
+OpenDDS::DCPS::DataLinkSet::send_to(const DataLink_rch& link,
+                                    TransportSendElement* send_element,
+                                    DataSampleElement* sample,
+                                    bool custom_header)
+{
+#ifndef OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
+  if (custom_header) {
+    typedef std::map<DataLinkIdType, GUIDSeq_var>::iterator FilterIter;
+    FilterIter fi = sample->get_filter_per_link().find(link->id());
+    GUIDSeq* guids = 0;
+    if (fi != sample->get_filter_per_link().end()) {
+      guids = fi->second.ptr();
+    }
+
+    VDBG_LVL((LM_DEBUG,
+      "(%P|%t) DBG: DataLink %@ filtering %d subscribers.\n",
+      link.in(), guids ? guids->length() : 0), 5);
+
+    Message_Block_Ptr mb (send_element->msg()->duplicate());
+
+    DataSampleHeader::add_cfentries(guids, mb.get());
+
+    TransportCustomizedElement* tce =
+      new TransportCustomizedElement(send_element, false);
+    tce->set_msg(move(mb)); // tce now owns ACE_Message_Block chain
+
+    link->send(tce);
+    return;
+  }
+#else
+  ACE_UNUSED_ARG(sample);
+  ACE_UNUSED_ARG(custom_header);
+#endif // OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
+
+  // Tell the DataLink to send it.
+  link->send(send_element);
+}
+
 ACE_INLINE void
 OpenDDS::DCPS::DataLinkSet::send(DataSampleElement* sample)
 {
@@ -26,47 +65,31 @@ OpenDDS::DCPS::DataLinkSet::send(DataSampleElement* sample)
             sample), 5);
   GuardType guard(this->lock_);
 
-#ifndef OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
   const bool customHeader =
     DataSampleHeader::test_flag(CONTENT_FILTER_FLAG, sample->get_sample());
-#endif
 
   TransportSendElement* send_element = new TransportSendElement(static_cast<int>(map_.size()), sample);
 
   for (MapType::iterator itr = map_.begin(); itr != map_.end(); ++itr) {
+    send_to(itr->second, send_element, sample, customHeader);
+  }
+}
 
-#ifndef OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
-    if (customHeader) {
-      typedef std::map<DataLinkIdType, GUIDSeq_var>::iterator FilterIter;
-      FilterIter fi = sample->get_filter_per_link().find(itr->first);
-      GUIDSeq* guids = 0;
-      if (fi != sample->get_filter_per_link().end()) {
-        guids = fi->second.ptr();
-      }
-
-      VDBG_LVL((LM_DEBUG,
-        "(%P|%t) DBG: DataLink %@ filtering %d subscribers.\n",
-        itr->second.in(), guids ? guids->length() : 0), 5);
-
-      Message_Block_Ptr mb (send_element->msg()->duplicate());
-
-      DataSampleHeader::add_cfentries(guids, mb.get());
-
-      TransportCustomizedElement* tce =
-        new TransportCustomizedElement(send_element, false);
-      tce->set_msg(move(mb)); // tce now owns ACE_Message_Block chain
-
-      itr->second->send(tce);
+ACE_INLINE void
+OpenDDS::DCPS::DataLinkSet::send(DataSampleElement* sample,
+                                 const LinkList& links)
+{
+  DBG_ENTRY_LVL("DataLinkSet", "send", 6);
+  VDBG_LVL((LM_DEBUG, "(%P|%t) DBG: DataLinkSet::send element %@.\n",
+            sample), 5);
 
-    } else {
-#endif // OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
+  const bool customHeader =
+    DataSampleHeader::test_flag(CONTENT_FILTER_FLAG, sample->get_sample());
 
-      // Tell the DataLink to send it.
-      itr->second->send(send_element);
+  TransportSendElement* send_element = new TransportSendElement(static_cast<int>(links.size()), sample);
 
-#ifndef OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
-    }
-#endif
+  for (LinkList::const_iterator itr = links.begin(); itr != links.end(); ++itr) {
+    send_to(*itr, send_element, sample, customHeader);
   }
 }
 
@@ -84,6 +107,20 @@ OpenDDS::DCPS::DataLinkSet::send_control(DataSampleElement* sample)
   }
 }
 
+ACE_INLINE void
+OpenDDS::DCPS::DataLinkSet::send_control(DataSampleElement* sample,
+                                         const LinkList& links)
+{
+  DBG_ENTRY_LVL("DataLinkSet", "send_control", 6);
+  VDBG((LM_DEBUG, "(%P|%t) DBG: DataLinkSet::send_control %@.\n", sample));
+  TransportSendControlElement* send_element =
+    new TransportSendControlElement(static_cast<int>(links.size()), sample);
+
+  for (LinkList::const_iterator itr = links.begin(); itr != links.end(); ++itr) {
+    (*itr)->send(send_element);
+  }
+}
+
 ACE_INLINE OpenDDS::DCPS::SendControlStatus
 OpenDDS::DCPS::DataLinkSet::send_control(RepoId                           pub_id,
                                          const TransportSendListener_rch& listener,
@@ -179,6 +216,29 @@ OpenDDS::DCPS::DataLinkSet::remove_all_msgs(RepoId pub_id)
   return true;
 }
 
+ACE_INLINE void
+OpenDDS::DCPS::DataLinkSet::send_start_i(const DataLinkIdType& id,
+                                         const DataLink_rch& link)
+{
+  // Attempt to add the DataLink to this set.
+  int result = OpenDDS::DCPS::bind(map_, id, link);
+
+  if (result == 0) {
+    // We successfully added the DataLink to this set, meaning that it
+    // wasn't already a member.  We should tell the DataLink about the
+    // send_start() event.
+    link->send_start();
+
+  } else if (result == -1) {
+    ACE_ERROR((LM_ERROR,
+               "(%P|%t) ERROR: Failed to bind data link into set.\n"));
+  }
+
+  // Note that there is a possibility that the result == 1, which
+  // means that the DataLink already exists in our map_->  We skip
+  // all of these cases.
+}
+
 ACE_INLINE void
 OpenDDS::DCPS::DataLinkSet::send_start(DataLinkSet* link_set)
 {
@@ -188,23 +248,17 @@ OpenDDS::DCPS::DataLinkSet::send_start(DataLinkSet* link_set)
   for (MapType::iterator itr = link_set->map_.begin();
        itr != link_set->map_.end();
        ++itr) {
-    // Attempt to add the current DataLink to this set.
-    int result = OpenDDS::DCPS::bind(map_, itr->first, itr->second);
-
-    if (result == 0) {
-      // We successfully added the current DataLink to this set,
-      // meaning that it wasn't already a member.  We should tell
-      // the DataLink about the send_start() event.
-      itr->second->send_start();
-
-    } else if (result == -1) {
-      ACE_ERROR((LM_ERROR,
-                 "(%P|%t) ERROR: Failed to bind data link into set.\n"));
-    }
+    send_start_i(itr->first, itr->second);
+  }
+}
 
-    // Note that there is a possibility that the result == 1, which
-    // means that the DataLink already exists in our map_->  We skip
-    // all of these cases.
+ACE_INLINE void
+OpenDDS::DCPS::DataLinkSet::send_start(const LinkList& links)
+{
+  DBG_ENTRY_LVL("DataLinkSet","send_start",6);
+  GuardType guard(this->lock_);
+  for (LinkList::const_iterator itr = links.begin(); itr != links.end(); ++itr) {
+    send_start_i((*itr)->id(), *itr);
   }
 }
 
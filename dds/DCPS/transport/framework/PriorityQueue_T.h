@@ -0,0 +1,250 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_PRIORITYQUEUE_T_H
+#define OPENDDS_DCPS_PRIORITYQUEUE_T_H
+
+#include "BasicQueue_T.h"
+#include "TransportDefs.h"
+#include "dds/DCPS/PoolAllocationBase.h"
+#include "dds/DCPS/PoolAllocator.h"
+#include "dds/DCPS/GuidUtils.h"
+
+#include <functional>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class PriorityQueue
+ *
+ * @brief A BasicQueue replacement that keeps one FIFO per priority.
+ *
+ * Elements are ordered by the value returned from T::priority().
+ * Elements of the same priority stay in FIFO order.  The highest
+ * priority level is served first, but a lower level that has been
+ * passed over FAIR_SHARE times in a row is served once so that bulk
+ * traffic at low priority still gets a share of the link.
+ *
+ * While a publication (T::publication_id()) has elements queued, its
+ * new elements go to the level of the queued ones even if its priority
+ * has changed since, so that one writer's samples are never reordered.
+ *
+ * peek(), replace_head() and get() all operate on the same element
+ * as long as the queue is not modified in between.
+ */
+template <typename T>
+class PriorityQueue : public PoolAllocationBase {
+private:
+
+  typedef BasicQueueVisitor<T> VisitorType;
+  typedef BasicQueue<T> Level;
+
+  struct LevelInfo {
+    LevelInfo() : skipped_(0) {}
+    Level queue_;
+    size_t skipped_;
+  };
+
+  typedef OPENDDS_MAP_CMP(Priority, LevelInfo, std::greater<Priority>) Levels;
+  typedef typename Levels::iterator iterator;
+
+  /// Level and number of queued elements of a publication.
+  struct Pinned {
+    Pinned() : level_(0), count_(0) {}
+    Priority level_;
+    size_t count_;
+  };
+
+  typedef OPENDDS_MAP_CMP(RepoId, Pinned, GUID_tKeyLessThan) PinnedMap;
+
+  Levels levels_;
+  PinnedMap pinned_;
+  size_t size_;
+
+public:
+
+  /// Number of times a non-empty level may be passed over by higher
+  /// priority levels before it is served.
+  static const size_t FAIR_SHARE = 8;
+
+  PriorityQueue() : size_(0) {}
+
+  /// Put a pointer to an element (T*) on to the queue.
+  int put(T* elem) {
+    Pinned& pinned = pin(elem);
+    if (pinned.count_ == 1) {
+      pinned.level_ = elem->priority();
+    }
+    levels_[pinned.level_].queue_.put(elem);
+    ++size_;
+    return 0;
+  }
+
+  /// Peek at the element that get() would return next.
+  T* peek() const {
+    const typename Levels::const_iterator level = select();
+    return level == levels_.end() ? 0 : level->second.queue_.peek();
+  }
+
+  void replace_head(T* value) {
+    const iterator level = select();
+    if (level != levels_.end()) {
+      unpin(level->second.queue_.peek());
+      pin(value).level_ = level->first;
+      level->second.queue_.replace_head(value);
+    }
+  }
+
+  /// Extract the next element from the queue.  Returns 0 if there
+  /// are no elements in the queue.
+  T* get() {
+    const iterator level = select();
+    if (level == levels_.end()) {
+      return 0;
+    }
+
+    // Everything waiting ahead of or behind the served level is
+    // charged with a skip, the served level starts over.
+    for (iterator it = levels_.begin(); it != levels_.end(); ++it) {
+      if (it == level) {
+        it->second.skipped_ = 0;
+      } else if (it->second.queue_.size()) {
+        ++it->second.skipped_;
+      }
+    }
+
+    T* const result = level->second.queue_.get();
+    unpin(result);
+    --size_;
+    if (level->second.queue_.size() == 0) {
+      levels_.erase(level);
+    }
+    return result;
+  }
+
+  /// Accessor for the current number of elements in the queue.
+  size_t size() const {
+    return size_;
+  }
+
+  /// Visit the elements from the highest to the lowest priority.
+  void accept_visitor(VisitorType& visitor) const {
+    for (typename Levels::const_iterator it = levels_.begin();
+         it != levels_.end(); ++it) {
+      it->second.queue_.accept_visitor(visitor);
+    }
+  }
+
+  /// Visit the elements from the highest to the lowest priority,
+  /// removing those the visitor selects.  As with BasicQueue the
+  /// visitor stops visitation by returning 0, which also ends the
+  /// visitation of the remaining levels.
+  void accept_remove_visitor(VisitorType& visitor) {
+    StopDetector detector(visitor);
+    iterator it = levels_.begin();
+    while (it != levels_.end() && !detector.stopped_) {
+      it->second.queue_.accept_remove_visitor(detector);
+      if (it->second.queue_.size() == 0) {
+        levels_.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+    recount();
+  }
+
+  void swap(PriorityQueue& other)
+  {
+    levels_.swap(other.levels_);
+    pinned_.swap(other.pinned_);
+    std::swap(size_, other.size_);
+  }
+
+private:
+
+  /// Forwards to the wrapped visitor and records whether it asked to
+  /// stop, so that accept_remove_visitor() does not continue with the
+  /// next level.
+  struct StopDetector : VisitorType {
+    explicit StopDetector(VisitorType& visitor)
+      : visitor_(visitor), stopped_(false) {}
+
+    int visit_element_remove(T* element, int& remove) {
+      const int keep_going = visitor_.visit_element_remove(element, remove);
+      if (keep_going == 0) {
+        stopped_ = true;
+      }
+      return keep_going;
+    }
+
+    VisitorType& visitor_;
+    bool stopped_;
+  };
+
+  iterator select() {
+    iterator result = levels_.begin();
+    for (iterator it = levels_.begin(); it != levels_.end(); ++it) {
+      if (it->second.skipped_ >= FAIR_SHARE) {
+        result = it;
+      }
+    }
+    return result;
+  }
+
+  typename Levels::const_iterator select() const {
+    return const_cast<PriorityQueue*>(this)->select();
+  }
+
+  /// Counts elem against its publication, a publication without queued
+  /// elements comes back with a count of 1 and level_ still to be set.
+  Pinned& pin(T* elem) {
+    Pinned& pinned = pinned_[elem->publication_id()];
+    ++pinned.count_;
+    return pinned;
+  }
+
+  void unpin(T* elem) {
+    const typename PinnedMap::iterator it = pinned_.find(elem->publication_id());
+    if (it != pinned_.end() && --it->second.count_ == 0) {
+      pinned_.erase(it);
+    }
+  }
+
+  /// Rebuilds size_ and pinned_ from the elements left in the levels.
+  struct Recounter : VisitorType {
+    Recounter(PriorityQueue& queue, Priority level)
+      : queue_(queue), level_(level) {}
+
+    int visit_element(T* element) {
+      queue_.pin(element).level_ = level_;
+      ++queue_.size_;
+      return 1;
+    }
+
+    PriorityQueue& queue_;
+    Priority level_;
+  };
+
+  void recount() {
+    size_ = 0;
+    pinned_.clear();
+    for (iterator it = levels_.begin(); it != levels_.end(); ++it) {
+      Recounter recounter(*this, it->first);
+      it->second.queue_.accept_visitor(recounter);
+    }
+  }
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* OPENDDS_DCPS_PRIORITYQUEUE_T_H */
@@ -107,14 +107,19 @@ ReceiveListenerSet::data_received(const ReceivedDataSample& sample,
     }
   }
 
+  // Readers of the same type share the demarshaled sample through the cache.
+  DemarshalCache cache;
+  const bool share = handles.size() > 1 && sample.sample_;
+
   for (size_t i = 0; i < handles.size(); ++i) {
     TransportReceiveListener_rch listener = handles[i].lock();
     if (!listener)
       continue;
-    if (i < handles.size() - 1 && sample.sample_) {
+    if (share) {
       // demarshal (in data_received()) updates the rd_ptr() of any of
       // the message blocks in the chain, so give it a duplicated chain.
       ReceivedDataSample rds(sample);
+      rds.demarshal_cache_ = &cache;
       listener->data_received(rds);
     } else {
       listener->data_received(sample);
@@ -12,3 +12,51 @@
 #if !defined (__ACE_INLINE__)
 # include "ReceivedDataSample.inl"
 #endif /* !__ACE_INLINE__ */
+
+#include <cstring>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+DemarshaledSample::~DemarshaledSample()
+{
+}
+
+DemarshalCache::DemarshalCache()
+  : size_(0)
+{
+}
+
+const DemarshaledSample*
+DemarshalCache::find(const char* type_name, bool key_only) const
+{
+  for (size_t i = 0; i < size_; ++i) {
+    const Entry& entry = entries_[i];
+    if (entry.key_only_ == key_only &&
+        (entry.type_name_ == type_name ||
+         std::strcmp(entry.type_name_, type_name) == 0)) {
+      return entry.sample_.in();
+    }
+  }
+  return 0;
+}
+
+void
+DemarshalCache::insert(const char* type_name, bool key_only,
+                       const RcHandle<DemarshaledSample>& sample)
+{
+  if (full()) {
+    return;
+  }
+  Entry& entry = entries_[size_++];
+  entry.type_name_ = type_name;
+  entry.key_only_ = key_only;
+  entry.sample_ = sample;
+}
+
+}
+}
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
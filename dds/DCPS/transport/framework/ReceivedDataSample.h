@@ -9,6 +9,8 @@
 #define OPENDDS_DCPS_RECEIVEDDATASAMPLE_H
 
 #include "dds/DCPS/DataSampleHeader.h"
+#include "dds/DCPS/RcObject.h"
+#include "dds/DCPS/PoolAllocator.h"
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 class ACE_Message_Block;
@@ -19,6 +21,52 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+/**
+ * @class DemarshaledSample
+ *
+ * @brief Base for a type-specific, demarshaled copy of a sample.
+ */
+class OpenDDS_Dcps_Export DemarshaledSample : public RcObject {
+public:
+  virtual ~DemarshaledSample();
+};
+
+/**
+ * @class DemarshalCache
+ *
+ * @brief Demarshaled forms of one received sample, shared by the readers
+ *        in this process that receive it.
+ *
+ * Each entry is keyed by the type name and whether only the key fields were
+ * demarshaled, so readers of the same type only deserialize the payload
+ * once.  The entries are immutable, readers copy out of them.  The cache
+ * lives on the stack of the thread that delivers the sample to its
+ * listeners and holds a few entries, once it is full readers demarshal
+ * for themselves.
+ */
+class OpenDDS_Dcps_Export DemarshalCache {
+public:
+  DemarshalCache();
+
+  const DemarshaledSample* find(const char* type_name, bool key_only) const;
+  void insert(const char* type_name, bool key_only,
+              const RcHandle<DemarshaledSample>& sample);
+  bool full() const { return size_ == CAPACITY; }
+
+private:
+  DemarshalCache(const DemarshalCache&);
+  DemarshalCache& operator=(const DemarshalCache&);
+
+  enum { CAPACITY = 4 };
+  struct Entry {
+    const char* type_name_;
+    bool key_only_;
+    RcHandle<DemarshaledSample> sample_;
+  };
+  Entry entries_[CAPACITY];
+  size_t size_;
+};
+
 /**
  * @class ReceivedDataSample
  *
@@ -45,6 +93,10 @@ public:
 
   /// The "data" part (ie, no "header" part) of the sample.
   Message_Block_Ptr sample_;
+
+  /// Set while the sample is delivered to more than one reader, copies of
+  /// the sample don't keep it.
+  DemarshalCache* demarshal_cache_;
 };
 
 void swap(ReceivedDataSample&, ReceivedDataSample&);
@@ -16,6 +16,7 @@ namespace DCPS {
 ACE_INLINE
 ReceivedDataSample::ReceivedDataSample(ACE_Message_Block* payload)
   : sample_(payload)
+  , demarshal_cache_(0)
 {
   DBG_ENTRY_LVL("ReceivedDataSample", "ReceivedDataSample",6);
 }
@@ -24,6 +25,7 @@ ACE_INLINE
 ReceivedDataSample::ReceivedDataSample(const ReceivedDataSample& other)
   : header_(other.header_)
   , sample_(ACE_Message_Block::duplicate(other.sample_.get()))
+  , demarshal_cache_(0)
 {
   DBG_ENTRY_LVL("ReceivedDataSample", "ReceivedDataSample(copy)", 6);
 }
@@ -49,6 +51,7 @@ swap(ReceivedDataSample& a, ReceivedDataSample& b)
   using std::swap;
   swap(a.header_, b.header_);
   swap(a.sample_, b.sample_);
+  swap(a.demarshal_cache_, b.demarshal_cache_);
 }
 
 }
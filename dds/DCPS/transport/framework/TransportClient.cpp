@@ -19,6 +19,7 @@
 #include "dds/DCPS/SendStateDataSampleList.h"
 #include "dds/DCPS/GuidConverter.h"
 #include "dds/DCPS/Definitions.h"
+#include "dds/DCPS/Util.h"
 
 #include "ace/Reactor_Timer_Interface.h"
 
@@ -32,6 +33,7 @@ namespace DCPS {
 
 TransportClient::TransportClient()
   : pending_assoc_timer_(make_rch<PendingAssocTimer> (TheServiceParticipant->reactor(), TheServiceParticipant->reactor_owner()))
+  , routes_(make_rch<RouteTable>())
   , expected_transaction_id_(1)
   , max_transaction_id_seen_(0)
   , max_transaction_tail_(0)
@@ -520,6 +522,7 @@ TransportClient::add_link(const DataLink_rch& link, const RepoId& peer)
 {
   links_.insert_link(link);
   data_link_index_[peer] = link;
+  update_routes();
 
   TransportReceiveListener_rch trl = get_receive_listener();
 
@@ -531,6 +534,29 @@ TransportClient::add_link(const DataLink_rch& link, const RepoId& peer)
   }
 }
 
+void
+TransportClient::update_routes()
+{
+  const RouteTable_rch table = make_rch<RouteTable>();
+  typedef OPENDDS_MAP(DataLinkIdType, size_t) LinkSlots;
+  LinkSlots link_slots;
+
+  for (DataLinkIndex::const_iterator it = data_link_index_.begin();
+       it != data_link_index_.end(); ++it) {
+    const std::pair<LinkSlots::iterator, bool> slot =
+      link_slots.insert(std::make_pair(it->second->id(), table->links_.size()));
+    if (slot.second) {
+      table->links_.push_back(it->second);
+      table->peers_.push_back(0);
+    }
+    ++table->peers_[slot.first->second];
+    table->slots_[it->first] = slot.first->second;
+  }
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, routes_lock_);
+  routes_ = table;
+}
+
 void
 TransportClient::stop_associating()
 {
@@ -592,6 +618,7 @@ TransportClient::disassociate(const RepoId& peerId)
   //now that an _rch is created for the link, remove the iterator from data_link_index_ while still holding lock
   //otherwise it could be removed in transport_detached()
   data_link_index_.erase(found);
+  update_routes();
   DataLinkSetMap released;
 
     if (DCPS_debug_level > 4) {
@@ -753,13 +780,21 @@ TransportClient::send_i(SendStateDataSampleList send_list, ACE_UINT64 transactio
     }
     DataLinkSet send_links;
 
+    RouteTable_rch routes;
+    {
+      ACE_GUARD(ACE_Thread_Mutex, guard, routes_lock_);
+      routes = routes_;
+    }
+    const RouteTable::SlotMap::const_iterator no_slot = routes->slots_.end();
+    const size_t n_slots = routes->links_.size();
+
     while (true) {
       // VERY IMPORTANT NOTE:
       //
       // We have to be very careful in how we deal with the current
       // DataSampleElement.  The issue is that once we have invoked
       // data_delivered() on the send_listener_ object, or we have invoked
-      // send() on the pub_links, we can no longer access the current
+      // send() on the selected links, we can no longer access the current
       // DataSampleElement!Thus, we need to get the next
       // DataSampleElement (pointer) from the current element now,
       // while it is safe.
@@ -769,12 +804,28 @@ TransportClient::send_i(SendStateDataSampleList send_list, ACE_UINT64 transactio
       } else {
         next_elem = max_transaction_tail_;
       }
-      DataLinkSet_rch pub_links =
-        (cur->get_num_subs() > 0)
-        ? DataLinkSet_rch(links_.select_links(cur->get_sub_ids(), cur->get_num_subs()))
-        : DataLinkSet_rch(&links_, inc_count());
 
-      if (pub_links.is_nil() || pub_links->empty()) {
+      // Select the route slots this sample goes to: all of them, or
+      // only those reaching the sample's directed subscribers.
+      size_t n_selected = n_slots;
+      const CORBA::ULong num_subs = cur->get_num_subs();
+      if (num_subs > 0) {
+        route_selected_.assign(n_slots, 0);
+        n_selected = 0;
+        const RepoId* const sub_ids = cur->get_sub_ids();
+        for (CORBA::ULong i = 0; i < num_subs; ++i) {
+          const RouteTable::SlotMap::const_iterator slot =
+            routes->slots_.find(sub_ids[i]);
+          if (slot != no_slot && !route_selected_[slot->second]) {
+            route_selected_[slot->second] = 1;
+            ++n_selected;
+          }
+        }
+      } else {
+        route_selected_.assign(n_slots, 1);
+      }
+
+      if (n_selected == 0) {
         // NOTE: This is the "local publisher id is not currently
         //       associated with any remote subscriber ids" case.
 
@@ -800,42 +851,51 @@ TransportClient::send_i(SendStateDataSampleList send_list, ACE_UINT64 transactio
 
   #ifndef OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
 
-        // Content-Filtering adjustment to the pub_links:
+        // Content-Filtering adjustment to the selected links:
         // - If the sample should be filtered out of all subscriptions on a given
         //   DataLink, then exclude that link from the subset that we'll send to.
         // - If the sample should be filtered out of some (or none) of the subs,
         //   then record that information in the DataSampleElement so that the
         //   header's content_filter_entries_ can be marshaled before it's sent.
         if (cur->filter_out_.ptr()) {
-          DataLinkSet_rch subset;
-          DataLinkSet::GuardType guard(pub_links->lock());
-          typedef DataLinkSet::MapType MapType;
-          MapType& map = pub_links->map();
-
-          for (MapType::iterator itr = map.begin(); itr != map.end(); ++itr) {
-            size_t n_subs;
-            GUIDSeq_var ti =
-              itr->second->target_intersection(cur->get_pub_id(),
-                                               cur->filter_out_.in(), n_subs);
-
-            if (ti.ptr() == 0 || ti->length() != n_subs) {
-              if (!subset.in()) {
-                subset = make_rch<DataLinkSet>();
-              }
-
-              subset->insert_link(itr->second);
-              cur->filter_per_link_[itr->first] = ti._retn();
+          const GUIDSeq& filter_out = cur->filter_out_.in();
+          const CORBA::ULong n_filtered = filter_out.length();
+          route_filtered_.assign(n_slots, 0);
+          route_filter_slots_.resize(n_filtered);
+
+          for (CORBA::ULong i = 0; i < n_filtered; ++i) {
+            const RouteTable::SlotMap::const_iterator slot =
+              routes->slots_.find(filter_out[i]);
+            route_filter_slots_[i] = slot == no_slot ? n_slots : slot->second;
+            if (slot != no_slot) {
+              ++route_filtered_[slot->second];
+            }
+          }
 
-            } else {
+          for (size_t s = 0; s < n_slots; ++s) {
+            if (route_selected_[s] && route_filtered_[s] == routes->peers_[s]) {
               VDBG((LM_DEBUG,
                     "(%P|%t) DBG: DataLink completely filtered-out %@.\n",
-                    itr->second.in()));
+                    routes->links_[s].in()));
+              route_selected_[s] = 0;
+              --n_selected;
             }
           }
 
-          if (!subset.in()) {
+          for (CORBA::ULong i = 0; i < n_filtered; ++i) {
+            const size_t s = route_filter_slots_[i];
+            if (s != n_slots && route_selected_[s]) {
+              GUIDSeq_var& guids = cur->filter_per_link_[routes->links_[s]->id()];
+              if (guids.ptr() == 0) {
+                guids = new GUIDSeq(route_filtered_[s]);
+              }
+              push_back(guids.inout(), filter_out[i]);
+            }
+          }
+
+          if (n_selected == 0) {
             VDBG((LM_DEBUG, "(%P|%t) DBG: filtered-out of all DataLinks.\n"));
-            // similar to the "if (pub_links.is_nil())" case above, no links
+            // similar to the "no links" case above
             cur->get_send_listener()->data_delivered(cur);
             if (cur != max_transaction_tail_) {
               // Move on to the next DataSampleElement to send.
@@ -845,25 +905,31 @@ TransportClient::send_i(SendStateDataSampleList send_list, ACE_UINT64 transactio
               break;
             }
           }
-
-          pub_links = subset;
         }
 
   #endif // OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
 
+        route_links_.clear();
+        for (size_t s = 0; s < n_slots; ++s) {
+          if (route_selected_[s]) {
+            route_links_.push_back(routes->links_[s]);
+          }
+        }
+
         // This will do several things, including adding to the membership
         // of the send_links set.  Any DataLinks added to the send_links
         // set will be also told about the send_start() event.  Those
-        // DataLinks (in the pub_links set) that are already in the
+        // DataLinks (in route_links_) that are already in the
         // send_links set will not be told about the send_start() event
         // since they heard about it when they were inserted into the
         // send_links set.
-        send_links.send_start(pub_links.in());
+        send_links.send_start(route_links_);
         if (cur->get_header().message_id_ != SAMPLE_DATA) {
-          pub_links->send_control(cur);
+          DataLinkSet::send_control(cur, route_links_);
         } else {
-          pub_links->send(cur);
+          DataLinkSet::send(cur, route_links_);
         }
+        route_links_.clear();
       }
       if (cur != max_transaction_tail_) {
         // Move on to the next DataSampleElement to send.
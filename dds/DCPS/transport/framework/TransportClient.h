@@ -155,6 +155,9 @@ private:
 
   void send_i(SendStateDataSampleList send_list, ACE_UINT64 transaction_id);
 
+  /// Rebuilds routes_ from data_link_index_, called with lock_ held.
+  void update_routes();
+
   // A class, normally provided by an unit test, who needs access to a client's
   // privates.
   friend class ::DDS_TEST;
@@ -183,6 +186,23 @@ private:
 
   typedef OPENDDS_MAP_CMP(RepoId, PendingAssoc_rch, GUID_tKeyLessThan) PendingMap;
 
+  /// Snapshot of the links used by send_i(), indexed by slot.  A new
+  /// table replaces the old one whenever an association is added or
+  /// removed, so routing a sample needs neither the link set's lock nor
+  /// the DataLinks' association maps.
+  struct RouteTable : RcObject {
+    typedef OPENDDS_MAP_CMP(RepoId, size_t, GUID_tKeyLessThan) SlotMap;
+
+    /// Link for each slot.
+    DataLinkSet::LinkList links_;
+    /// Number of associated peers reached through the link in each slot.
+    OPENDDS_VECTOR(CORBA::ULong) peers_;
+    /// Slot of the link that reaches each associated peer.
+    SlotMap slots_;
+  };
+
+  typedef RcHandle<RouteTable> RouteTable_rch;
+
   class PendingAssocTimer : public ReactorInterceptor {
   public:
     PendingAssocTimer(ACE_Reactor* reactor,
@@ -268,6 +288,17 @@ private:
 
   DataLinkIndex data_link_index_;
 
+  /// Current routing table and the lock protecting the handle to it.
+  RouteTable_rch routes_;
+  ACE_Thread_Mutex routes_lock_;
+
+  /// Scratch space for send_i(), indexed by route slot and reused
+  /// across samples.  Protected by send_transaction_lock_.
+  OPENDDS_VECTOR(CORBA::ULong) route_selected_;
+  OPENDDS_VECTOR(CORBA::ULong) route_filtered_;
+  OPENDDS_VECTOR(size_t) route_filter_slots_;
+  DataLinkSet::LinkList route_links_;
+
   // Used to allow sends to completed as a transaction and block
   // multi-threaded writers from proceeding to send data
   // on two thread simultaneously, which could cause out-of-order data.
@@ -36,6 +36,8 @@ public:
 
   virtual SequenceNumber sequence() const;
 
+  virtual Priority priority() const;
+
   virtual bool owned_by_transport() { return false; }
 
   virtual bool is_fragment() const { return fragment_; }
@@ -33,6 +33,13 @@ TransportCustomizedElement::sequence() const
     : SequenceNumber::SEQUENCENUMBER_UNKNOWN();
 }
 
+ACE_INLINE
+Priority
+TransportCustomizedElement::priority() const
+{
+  return this->orig_ ? this->orig_->priority() : 0;
+}
+
 } // namespace DCPS
 } // namespace OpenDDS
 
@@ -225,7 +225,8 @@ enum {
   DEFAULT_CONFIG_QUEUE_INITIAL_POOLS     = 5,
   DEFAULT_CONFIG_MAX_PACKET_SIZE         = 2147481599,
   DEFAULT_CONFIG_MAX_SAMPLES_PER_PACKET  = 10,
-  DEFAULT_CONFIG_OPTIMUM_PACKET_SIZE     = 4096
+  DEFAULT_CONFIG_OPTIMUM_PACKET_SIZE     = 4096,
+  DEFAULT_CONFIG_RECEIVE_POOL_BUFFERS    = 100
 };
 
 /// used by DataLink::remove_sample(), TransportSendStrategy, *RemoveVisitor
@@ -45,6 +45,9 @@ OpenDDS::DCPS::TransportInst::load(ACE_Configuration_Heap& cf,
   // for control messages.
   GET_CONFIG_VALUE(cf, sect, ACE_TEXT("datalink_control_chunks"), this->datalink_control_chunks_, size_t)
 
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("receive_pool_buffers"), this->receive_pool_buffers_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("receive_pool_max_buffers"), this->receive_pool_max_buffers_, size_t)
+
   ACE_TString stringvalue;
   if (cf.get_string_value (sect, ACE_TEXT("passive_connect_duration"), stringvalue) == 0) {
     ACE_DEBUG ((LM_WARNING,
@@ -98,6 +101,8 @@ OpenDDS::DCPS::TransportInst::dump_to_str() const
   ret += formatNameForDump("thread_per_connection")   + (this->thread_per_connection_ ? "true" : "false") + '\n';
   ret += formatNameForDump("datalink_release_delay")  + to_dds_string(this->datalink_release_delay_) + '\n';
   ret += formatNameForDump("datalink_control_chunks") + to_dds_string(unsigned(this->datalink_control_chunks_)) + '\n';
+  ret += formatNameForDump("receive_pool_buffers")    + to_dds_string(unsigned(this->receive_pool_buffers_)) + '\n';
+  ret += formatNameForDump("receive_pool_max_buffers") + to_dds_string(unsigned(this->receive_pool_max_buffers_)) + '\n';
   return ret;
 }
 
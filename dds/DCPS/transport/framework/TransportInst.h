@@ -96,6 +96,16 @@ public:
   /// samples. The default value is 32.
   size_t datalink_control_chunks_;
 
+  /// Number of RECEIVE_DATA_BUFFER_SIZE receive buffers each receive
+  /// strategy caches up front.  The default value is 100.
+  size_t receive_pool_buffers_;
+
+  /// Number of receive buffers the cache may grow to, in slabs, before
+  /// receive buffers come from the heap.  Slabs are kept until the
+  /// receive strategy is destroyed, so growing is opt-in: the default
+  /// value of 0 keeps the cache at receive_pool_buffers_.
+  size_t receive_pool_max_buffers_;
+
   /// Does the transport as configured support RELIABLE_RELIABILITY_QOS?
   virtual bool is_reliable() const = 0;
 
@@ -21,6 +21,8 @@ OpenDDS::DCPS::TransportInst::TransportInst(const char* type,
     thread_per_connection_(0),
     datalink_release_delay_(10000),
     datalink_control_chunks_(32),
+    receive_pool_buffers_(DEFAULT_CONFIG_RECEIVE_POOL_BUFFERS),
+    receive_pool_max_buffers_(0),
     name_(name)
 {
   DBG_ENTRY_LVL("TransportInst", "TransportInst", 6);
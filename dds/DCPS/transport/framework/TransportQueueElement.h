@@ -13,6 +13,7 @@
 #include "dds/DCPS/GuidUtils.h"
 #include "dds/DCPS/PoolAllocationBase.h"
 #include "dds/DCPS/SequenceNumber.h"
+#include "TransportDefs.h"
 
 #include <utility>
 
@@ -112,6 +113,11 @@ public:
     return SequenceNumber::SEQUENCENUMBER_UNKNOWN();
   }
 
+  /// TRANSPORT_PRIORITY of the sample, used to order queued elements.
+  virtual Priority priority() const {
+    return 0;
+  }
+
   /// The marshalled sample (sample header + sample data)
   virtual const ACE_Message_Block* msg() const = 0;
 
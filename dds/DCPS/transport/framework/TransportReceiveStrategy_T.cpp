@@ -6,6 +6,7 @@
  */
 
 #include "TransportReceiveStrategy_T.h"
+#include "TransportInst.h"
 #include "ace/INET_Addr.h"
 #include "ace/Min_Max.h"
 
@@ -19,12 +20,13 @@ namespace OpenDDS {
 namespace DCPS {
 
 template<typename TH, typename DSH>
-TransportReceiveStrategy<TH, DSH>::TransportReceiveStrategy()
+TransportReceiveStrategy<TH, DSH>::TransportReceiveStrategy(const TransportInst& config)
   : gracefully_disconnected_(false),
     receive_sample_remaining_(0),
-    mb_allocator_(MESSAGE_BLOCKS),
-    db_allocator_(DATA_BLOCKS),
-    data_allocator_(DATA_BLOCKS),
+    mb_allocator_(config.receive_pool_buffers_ * MESSAGE_BLOCKS_PER_BUFFER,
+                  config.receive_pool_max_buffers_ * MESSAGE_BLOCKS_PER_BUFFER),
+    db_allocator_(config.receive_pool_buffers_, config.receive_pool_max_buffers_),
+    data_allocator_(config.receive_pool_buffers_, config.receive_pool_max_buffers_),
     buffer_index_(0),
     payload_(0),
     good_pdu_(true),
@@ -34,14 +36,14 @@ TransportReceiveStrategy<TH, DSH>::TransportReceiveStrategy()
 
   if (Transport_debug_level >= 2) {
     ACE_DEBUG((LM_DEBUG,"(%P|%t) TransportReceiveStrategy-mb"
-               " Cached_Allocator_With_Overflow %x with %d chunks\n",
-               &mb_allocator_, MESSAGE_BLOCKS));
+               " Cached_Allocator_With_Overflow %x with %B chunks\n",
+               &mb_allocator_, mb_allocator_.capacity()));
     ACE_DEBUG((LM_DEBUG,"(%P|%t) TransportReceiveStrategy-db"
-               " Cached_Allocator_With_Overflow %x with %d chunks\n",
-               &db_allocator_, DATA_BLOCKS));
+               " Cached_Allocator_With_Overflow %x with %B chunks\n",
+               &db_allocator_, db_allocator_.capacity()));
     ACE_DEBUG((LM_DEBUG,"(%P|%t) TransportReceiveStrategy-data"
-               " Cached_Allocator_With_Overflow %x with %d chunks\n",
-               &data_allocator_, DATA_BLOCKS));
+               " Cached_Allocator_With_Overflow %x with %B chunks\n",
+               &data_allocator_, data_allocator_.capacity()));
   }
 
   ACE_OS::memset(this->receive_buffers_, 0, sizeof(this->receive_buffers_));
@@ -62,6 +64,28 @@ TransportReceiveStrategy<TH, DSH>::~TransportReceiveStrategy()
                  size));
     }
   }
+
+  if (Transport_debug_level >= 2) {
+    const ReceivePoolStats stats = receive_pool_stats();
+    ACE_DEBUG((LM_DEBUG,
+               ACE_TEXT("(%P|%t) TransportReceiveStrategy::~TransportReceiveStrategy() - ")
+               ACE_TEXT("receive pool held %B buffers, %B available, ")
+               ACE_TEXT("%Q pool allocations, %Q heap allocations\n"),
+               stats.buffers_, stats.buffers_available_,
+               stats.pool_allocs_, stats.heap_allocs_));
+  }
+}
+
+template<typename TH, typename DSH>
+ReceivePoolStats
+TransportReceiveStrategy<TH, DSH>::receive_pool_stats()
+{
+  ReceivePoolStats stats;
+  stats.buffers_ = data_allocator_.capacity();
+  stats.buffers_available_ = data_allocator_.available();
+  stats.pool_allocs_ = data_allocator_.allocs_from_pool_.value();
+  stats.heap_allocs_ = data_allocator_.allocs_from_heap_.value();
+  return stats;
 }
 
 template<typename TH, typename DSH>
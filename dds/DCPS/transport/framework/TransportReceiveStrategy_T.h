@@ -23,6 +23,18 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+class TransportInst;
+
+/// Snapshot of a receive strategy's receive buffer pool.
+struct ReceivePoolStats {
+  /// Receive buffers currently held by the pool, in use or not.
+  size_t buffers_;
+  /// Receive buffers in the pool that are not in use.
+  size_t buffers_available_;
+  /// Receive buffers handed out from the pool and from the heap.
+  ACE_UINT64 pool_allocs_, heap_allocs_;
+};
+
 /**
  * This class provides buffer for data received by transports, de-assemble
  * the data to individual samples and deliver them.
@@ -54,8 +66,13 @@ public:
   const DSH& received_sample_header() const;
   DSH& received_sample_header();
 
+  /// Allocation statistics of the receive buffer pool.
+  ReceivePoolStats receive_pool_stats();
+
 protected:
-  TransportReceiveStrategy();
+  /// Size the receive buffer pool from the receive_pool_* settings
+  /// of @a config.
+  explicit TransportReceiveStrategy(const TransportInst& config);
 
   /// Only our subclass knows how to do this.
   virtual ssize_t receive_bytes(iovec          iov[],
@@ -118,8 +135,7 @@ private:
   // Message Block Allocators are more plentiful since they hold samples
   // as well as data read from the handle(s).
   //
-  enum { MESSAGE_BLOCKS   = 1000 };
-  enum { DATA_BLOCKS      =  100 };
+  enum { MESSAGE_BLOCKS_PER_BUFFER = 10 };
 
 //MJM: We should probably bring the allocator typedefs down into this
 //MJM: class since they are limited to this scope.
@@ -59,6 +59,13 @@ TransportSendControlElement::requires_exclusive_packet() const
   return true;
 }
 
+Priority
+TransportSendControlElement::priority() const
+{
+  // Control messages must not overtake the writer's queued samples.
+  return this->listener_ ? this->listener_->transport_priority() : 0;
+}
+
 namespace
 {
   void handle_message(const bool dropped,
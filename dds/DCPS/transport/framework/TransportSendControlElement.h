@@ -65,6 +65,8 @@ public:
 
   virtual SequenceNumber sequence() const;
 
+  virtual Priority priority() const;
+
   /// Is the element a "control" sample from the specified pub_id?
   virtual bool is_control(RepoId pub_id) const;
   virtual bool owned_by_transport ();
@@ -20,6 +20,12 @@ OpenDDS::DCPS::TransportSendElement::~TransportSendElement()
   DBG_ENTRY_LVL("TransportSendElement","~TransportSendElement",6);
 }
 
+OpenDDS::DCPS::Priority
+OpenDDS::DCPS::TransportSendElement::priority() const
+{
+  return this->element_->get_send_listener()->transport_priority();
+}
+
 void
 OpenDDS::DCPS::TransportSendElement::release_element(bool dropped_by_transport)
 {
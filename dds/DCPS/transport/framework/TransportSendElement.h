@@ -37,6 +37,8 @@ public:
 
   virtual SequenceNumber sequence() const;
 
+  virtual Priority priority() const;
+
   /// Original sample from send listener.
   const DataSampleElement* sample() const;
 
@@ -77,6 +77,12 @@ TransportSendListener::retrieve_inline_qos_data(InlineQosData& qos_data) const
   qos_data.topic_name = "";
 }
 
+Priority
+TransportSendListener::transport_priority() const
+{
+  return 0;
+}
+
 } }
 
 OPENDDS_END_VERSIONED_NAMESPACE_DECL
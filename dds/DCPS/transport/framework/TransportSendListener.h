@@ -70,6 +70,9 @@ public:
 
   virtual void retrieve_inline_qos_data(InlineQosData& qos_data) const;
 
+  /// TRANSPORT_PRIORITY applied to samples queued by the transport.
+  virtual Priority transport_priority() const;
+
 protected:
 
   TransportSendListener();
@@ -762,7 +762,7 @@ TransportSendStrategy::clear(SendMode mode)
 
   send_delayed_notifications();
   QueueType elems;
-  QueueType queue;
+  PriorityQueueType queue;
   {
     GuardType guard(this->lock_);
 
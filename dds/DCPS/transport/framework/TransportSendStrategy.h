@@ -15,6 +15,7 @@
 #include "ThreadSynchWorker.h"
 #include "TransportDefs.h"
 #include "BasicQueue_T.h"
+#include "PriorityQueue_T.h"
 #include "TransportHeader.h"
 #include "TransportReplacedElement.h"
 #include "TransportRetainedElement.h"
@@ -127,6 +128,7 @@ public:
   bool isDirectMode();
 
   typedef BasicQueue<TransportQueueElement> QueueType;
+  typedef PriorityQueue<TransportQueueElement> PriorityQueueType;
 
   /// Convert ACE_Message_Block chain into iovec[] entries for send(),
   /// returns number of iovec[] entries used (up to MAX_SEND_BLOCKS).
@@ -311,7 +313,8 @@ private:
   /// completely unsent.
   /// Also used as a bucket for packets which still have to become
   /// part of a packet.
-  QueueType queue_;
+  /// Samples are taken by TRANSPORT_PRIORITY, see PriorityQueue.
+  PriorityQueueType queue_;
 
   /// Maximum marshalled size of the transport packet header.
   size_t max_header_size_;
@@ -16,7 +16,8 @@ namespace OpenDDS {
 namespace DCPS {
 
 MulticastReceiveStrategy::MulticastReceiveStrategy(MulticastDataLink* link)
-  : link_(link)
+  : TransportReceiveStrategy<>(link->impl().config())
+  , link_(link)
 {
 }
 
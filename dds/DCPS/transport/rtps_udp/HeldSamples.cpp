@@ -0,0 +1,157 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "HeldSamples.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+void
+HeldSamples::hold(const SequenceNumber& seq, const ReceivedDataSample& sample,
+                  size_t depth)
+{
+  if (!ring_held_ && seq > base_) {
+    // Nothing in the ring, so its window can start at this sample.
+    // Samples still in overflow_ below the new base are delivered first.
+    base_ = seq;
+    absorb();
+  }
+
+  if (depth && seq >= base_) {
+    const size_t offset =
+      static_cast<size_t>(seq.getValue() - base_.getValue());
+    if (offset < depth) {
+      grow(offset + 1, depth);
+      put(seq, sample);
+      return;
+    }
+  }
+  overflow_.insert(std::make_pair(seq, sample));
+}
+
+bool
+HeldSamples::pop(const SequenceNumber& ca, ReceivedDataSample& sample)
+{
+  if (next(ca, sample)) {
+    return true;
+  }
+  if (!ring_held_ && !slots_.empty()) {
+    // The gap was filled, give the ring back until the next one.
+    OPENDDS_VECTOR(Slot) none;
+    slots_.swap(none);
+  }
+  return false;
+}
+
+bool
+HeldSamples::next(const SequenceNumber& ca, ReceivedDataSample& sample)
+{
+  while (true) {
+    if (!overflow_.empty() && overflow_.begin()->first < base_) {
+      // Held behind the window: these precede everything in the ring.
+      const OPENDDS_MAP(SequenceNumber, ReceivedDataSample)::iterator first =
+        overflow_.begin();
+      if (first->first > ca) {
+        return false;
+      }
+      swap(sample, first->second);
+      overflow_.erase(first);
+      return true;
+    }
+
+    if (base_ > ca) {
+      return false;
+    }
+
+    if (!ring_held_) {
+      // Skip straight past the acknowledged range, anything held in
+      // overflow_ up to 'ca' is now behind the window.
+      base_ = ca + 1;
+      absorb();
+      continue;
+    }
+
+    Slot& slot = slots_[index(base_)];
+    const bool held = slot.held_;
+    if (held) {
+      swap(sample, slot.sample_);
+      slot.held_ = false;
+      --ring_held_;
+    }
+    ++base_;
+    absorb();
+    if (held) {
+      return true;
+    }
+  }
+}
+
+void
+HeldSamples::grow(size_t needed, size_t depth)
+{
+  if (needed <= slots_.size()) {
+    return;
+  }
+
+  size_t size = slots_.empty() ? size_t(MIN_SLOTS) : slots_.size();
+  while (size < needed) {
+    size *= 2;
+  }
+  if (size > depth) {
+    size = depth;
+  }
+
+  // Held samples move to the slot their sequence number maps to in the
+  // larger ring.
+  OPENDDS_VECTOR(Slot) slots(size);
+  SequenceNumber seq = base_;
+  for (size_t i = 0; ring_held_ && i < slots_.size(); ++i, ++seq) {
+    Slot& from = slots_[index(seq)];
+    if (from.held_) {
+      Slot& to = slots[static_cast<size_t>(seq.getValue() % size)];
+      swap(to.sample_, from.sample_);
+      to.held_ = true;
+    }
+  }
+  slots_.swap(slots);
+  absorb();
+}
+
+void
+HeldSamples::put(const SequenceNumber& seq, const ReceivedDataSample& sample)
+{
+  Slot& slot = slots_[index(seq)];
+  if (!slot.held_) {
+    slot.sample_ = sample;
+    slot.held_ = true;
+    ++ring_held_;
+  }
+}
+
+void
+HeldSamples::absorb()
+{
+  if (overflow_.empty() || slots_.empty()) {
+    return;
+  }
+  typedef OPENDDS_MAP(SequenceNumber, ReceivedDataSample)::iterator iter;
+  iter it = overflow_.lower_bound(base_);
+  while (it != overflow_.end() && in_window(it->first)) {
+    Slot& slot = slots_[index(it->first)];
+    swap(slot.sample_, it->second);
+    slot.held_ = true;
+    ++ring_held_;
+    overflow_.erase(it++);
+  }
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,96 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef DCPS_RTPSUDP_HELDSAMPLES_H
+#define DCPS_RTPSUDP_HELDSAMPLES_H
+
+#include "Rtps_Udp_Export.h"
+
+#include "dds/DCPS/transport/framework/ReceivedDataSample.h"
+#include "dds/DCPS/SequenceNumber.h"
+#include "dds/DCPS/PoolAllocator.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class HeldSamples
+ *
+ * @brief Samples from one remote writer that arrived ahead of a gap and
+ *        are waiting for it to be filled.
+ *
+ * Samples within 'depth' of the next sequence number to deliver sit in a
+ * ring indexed by sequence number, anything outside of that window is kept
+ * in an ordered map and moved into the ring once the window reaches it.
+ * The ring starts small and doubles as far as the gap requires, up to
+ * 'depth' slots.  It is released once every held sample was delivered, so
+ * a writer that isn't missing anything costs no ring at all.
+ */
+class OpenDDS_Rtps_Udp_Export HeldSamples {
+public:
+  HeldSamples() : base_(SequenceNumber::MIN_VALUE), ring_held_(0) {}
+
+  /// Keep a copy of 'sample' (which shares its payload) until 'seq'
+  /// can be delivered.
+  void hold(const SequenceNumber& seq, const ReceivedDataSample& sample,
+            size_t depth);
+
+  /// Swap the lowest held sample at or below 'ca' into 'sample'.
+  /// Returns false when there are no more samples to deliver up to 'ca'.
+  bool pop(const SequenceNumber& ca, ReceivedDataSample& sample);
+
+  /// Number of held samples.
+  size_t size() const { return ring_held_ + overflow_.size(); }
+
+  /// Number of slots currently allocated for the ring.
+  size_t capacity() const { return slots_.size(); }
+
+  enum { MIN_SLOTS = 8 };
+
+private:
+  struct Slot {
+    Slot() : held_(false), sample_(0) {}
+    bool held_;
+    ReceivedDataSample sample_;
+  };
+
+  size_t index(const SequenceNumber& seq) const
+  {
+    return static_cast<size_t>(seq.getValue() % slots_.size());
+  }
+
+  bool in_window(const SequenceNumber& seq) const
+  {
+    return seq >= base_ &&
+      static_cast<size_t>(seq.getValue() - base_.getValue()) < slots_.size();
+  }
+
+  bool next(const SequenceNumber& ca, ReceivedDataSample& sample);
+  void grow(size_t needed, size_t depth);
+  void put(const SequenceNumber& seq, const ReceivedDataSample& sample);
+  void absorb();
+
+  /// Sequence number seq in the window lives in slots_[seq % size].
+  OPENDDS_VECTOR(Slot) slots_;
+  SequenceNumber base_;
+  size_t ring_held_;
+  /// Held samples outside of [base_, base_ + slots_.size()).
+  OPENDDS_MAP(SequenceNumber, ReceivedDataSample) overflow_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* DCPS_RTPSUDP_HELDSAMPLES_H */
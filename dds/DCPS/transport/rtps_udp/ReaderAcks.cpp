@@ -0,0 +1,70 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ReaderAcks.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+bool
+ReaderAcks::add(const RepoId& id)
+{
+  const ById::iterator existing = by_id_.find(id);
+  if (existing != by_id_.end()) {
+    return false;
+  }
+  by_id_.insert(ById::value_type(id, acks_.insert(SequenceNumber())));
+  return true;
+}
+
+void
+ReaderAcks::remove(const RepoId& id)
+{
+  const ById::iterator existing = by_id_.find(id);
+  if (existing != by_id_.end()) {
+    acks_.erase(existing->second);
+    by_id_.erase(existing);
+  }
+}
+
+void
+ReaderAcks::update(const RepoId& id, const SequenceNumber& ack)
+{
+  const ById::iterator existing = by_id_.find(id);
+  if (existing == by_id_.end() || *existing->second == ack) {
+    return;
+  }
+  acks_.erase(existing->second);
+  existing->second = acks_.insert(ack);
+}
+
+bool
+ReaderAcks::ack(const RepoId& id, SequenceNumber& ack) const
+{
+  const ById::const_iterator existing = by_id_.find(id);
+  if (existing == by_id_.end()) {
+    return false;
+  }
+  ack = *existing->second;
+  return true;
+}
+
+SequenceNumber
+ReaderAcks::acked_by_all() const
+{
+  if (acks_.empty()) {
+    return SequenceNumber::MAX_VALUE;
+  }
+  return *acks_.begin();
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
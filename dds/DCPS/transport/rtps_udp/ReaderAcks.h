@@ -0,0 +1,70 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef DCPS_RTPSUDP_READERACKS_H
+#define DCPS_RTPSUDP_READERACKS_H
+
+#include "Rtps_Udp_Export.h"
+
+#include "dds/DdsDcpsGuidC.h"
+#include "dds/DCPS/GuidUtils.h"
+#include "dds/DCPS/SequenceNumber.h"
+#include "dds/DCPS/PoolAllocator.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class ReaderAcks
+ *
+ * @brief Cumulative acknowledgements of the remote readers of one local
+ *        writer, ordered so the lowest is found without visiting every
+ *        reader.
+ *
+ * A reader's acknowledgement starts at the default SequenceNumber and
+ * only changes through update(), so the ordered set and the per-reader
+ * values can't disagree.
+ */
+class OpenDDS_Rtps_Udp_Export ReaderAcks {
+public:
+  /// Track 'id', unless it already is.  Returns false if it was.
+  bool add(const RepoId& id);
+
+  void remove(const RepoId& id);
+
+  /// Record that 'id' has acknowledged every change before 'ack'.
+  /// Nothing is recorded for an id that isn't tracked.
+  void update(const RepoId& id, const SequenceNumber& ack);
+
+  /// Returns false if 'id' isn't tracked.
+  bool ack(const RepoId& id, SequenceNumber& ack) const;
+
+  /// The lowest acknowledgement, SequenceNumber::MAX_VALUE if there are
+  /// no readers.
+  SequenceNumber acked_by_all() const;
+
+  size_t size() const { return by_id_.size(); }
+
+private:
+  typedef OPENDDS_MULTISET_CMP(SequenceNumber, std::less<SequenceNumber>) AckSet;
+  typedef OPENDDS_MAP_CMP(RepoId, AckSet::iterator, GUID_tKeyLessThan) ById;
+  AckSet acks_;
+  ById by_id_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* DCPS_RTPSUDP_READERACKS_H */
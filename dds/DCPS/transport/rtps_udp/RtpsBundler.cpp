@@ -0,0 +1,162 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "RtpsBundler.h"
+
+#include "dds/DCPS/RTPS/RtpsCoreTypeSupportImpl.h"
+
+#include "dds/DCPS/Serializer.h"
+
+namespace {
+  enum { FLAG_E = 1 };
+}
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+RtpsBundler::RtpsBundler(Sender& sender, const char* rtps_header,
+                         size_t max_size)
+  : sender_(sender)
+  , rtps_header_(rtps_header)
+  , max_size_(max_size)
+{
+  ACE_Message_Block info_dst_mb(info_dst_reset_, sizeof info_dst_reset_);
+  Serializer ser(&info_dst_mb, false, Serializer::ALIGN_CDR);
+  const RTPS::InfoDestinationSubmessage info_dst = {
+    {RTPS::INFO_DST, ACE_CDR_BYTE_ORDER, RTPS::INFO_DST_SZ},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+  };
+  ser << info_dst;
+}
+
+bool
+RtpsBundler::add(const iovec iov[], int n, size_t size,
+                 const ACE_INET_Addr& addr)
+{
+  Bundle& bundle = bundles_[addr];
+  if (bundle.mb_ && bundle.mb_->length()) {
+    const size_t pad = bundle.open_ == NONE ? 0 : (4 - bundle.mb_->length() % 4) % 4;
+    if (bundle.mb_->length() + pad + INFO_DST_TOTAL + size - RTPS::RTPSHDR_SZ
+        > max_size_ || !close(bundle)) {
+      send(addr);
+    }
+  }
+
+  if (!bundle.mb_) {
+    bundle.mb_.reset(new ACE_Message_Block(max_size_));
+  }
+  ACE_Message_Block& mb = *bundle.mb_;
+  const bool started = mb.length() == 0;
+  if (started) {
+    mb.copy(rtps_header_, RTPS::RTPSHDR_SZ);
+  } else {
+    mb.copy(info_dst_reset_, INFO_DST_TOTAL);
+  }
+
+  const size_t start = mb.length();
+  size_t skip = RTPS::RTPSHDR_SZ;
+  for (int i = 0; i < n; ++i) {
+    const size_t len = iov[i].iov_len;
+    if (skip >= len) {
+      skip -= len;
+      continue;
+    }
+    mb.copy(static_cast<const char*>(iov[i].iov_base) + skip, len - skip);
+    skip = 0;
+  }
+  bundle.open_ = find_open(mb, start);
+  return started;
+}
+
+bool
+RtpsBundler::close(Bundle& bundle)
+{
+  if (bundle.open_ == NONE) {
+    return true;
+  }
+  ACE_Message_Block& mb = *bundle.mb_;
+  const size_t pad = (4 - mb.length() % 4) % 4;
+  const size_t length = mb.length() + pad - bundle.open_ - RTPS::SMHDR_SZ;
+  if (length > 0xFFFF) {
+    return false;
+  }
+
+  static const char zeros[4] = {0, 0, 0, 0};
+  mb.copy(zeros, pad);
+  char* const smhdr = mb.rd_ptr() + bundle.open_;
+  const bool little_endian = smhdr[1] & FLAG_E;
+  smhdr[little_endian ? 2 : 3] = static_cast<char>(length & 0xFF);
+  smhdr[little_endian ? 3 : 2] = static_cast<char>(length >> 8);
+  bundle.open_ = NONE;
+  return true;
+}
+
+size_t
+RtpsBundler::find_open(const ACE_Message_Block& mb, size_t offset)
+{
+  const unsigned char* const data =
+    reinterpret_cast<const unsigned char*>(mb.rd_ptr());
+  const size_t end = mb.length();
+  while (offset + RTPS::SMHDR_SZ <= end) {
+    const unsigned char kind = data[offset];
+    const bool little_endian = data[offset + 1] & FLAG_E;
+    const size_t length = little_endian
+      ? data[offset + 2] | (data[offset + 3] << 8)
+      : (data[offset + 2] << 8) | data[offset + 3];
+    if (length == 0 && kind != RTPS::PAD && kind != RTPS::INFO_TS) {
+      return offset;
+    }
+    offset += RTPS::SMHDR_SZ + length;
+  }
+  return NONE;
+}
+
+void
+RtpsBundler::send(const ACE_INET_Addr& addr)
+{
+  const BundleMap::iterator iter = bundles_.find(addr);
+  if (iter == bundles_.end() || !iter->second.mb_ ||
+      iter->second.mb_->length() == 0) {
+    return;
+  }
+  ACE_Message_Block& bundle = *iter->second.mb_;
+  iovec iov[1];
+  iov[0].iov_base = bundle.rd_ptr();
+  iov[0].iov_len = static_cast<u_long>(bundle.length());
+  sender_.send_bundle(iov, 1, addr);
+  bundle.reset();
+  iter->second.open_ = NONE;
+}
+
+void
+RtpsBundler::send_all()
+{
+  for (BundleMap::iterator iter = bundles_.begin(); iter != bundles_.end();) {
+    if (!iter->second.mb_ || iter->second.mb_->length() == 0) {
+      // Nothing was sent to this address for a whole bundle_delay.
+      bundles_.erase(iter++);
+    } else {
+      send(iter->first);
+      ++iter;
+    }
+  }
+}
+
+size_t
+RtpsBundler::pending(const ACE_INET_Addr& addr) const
+{
+  const BundleMap::const_iterator iter = bundles_.find(addr);
+  return (iter == bundles_.end() || !iter->second.mb_)
+    ? 0 : iter->second.mb_->length();
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,113 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef DCPS_RTPSBUNDLER_H
+#define DCPS_RTPSBUNDLER_H
+
+#include "Rtps_Udp_Export.h"
+
+#include "dds/DCPS/RTPS/MessageTypes.h"
+
+#include "dds/DCPS/Message_Block_Ptr.h"
+#include "dds/DCPS/PoolAllocator.h"
+
+#include "ace/INET_Addr.h"
+#include "ace/os_include/sys/os_uio.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class RtpsBundler
+ *
+ * @brief Collects small RTPS messages into one RTPS message per
+ *        destination address.
+ *
+ * Each bundle starts with the RTPS header, the submessages of the messages
+ * added to it follow without their own header.  Submessages of different
+ * messages are separated by an INFO_DST with an unknown GuidPrefix, which
+ * resets the destination the receiver assumes for the following
+ * submessages (RTPS 8.3.7.7.4).  A message whose last submessage has an
+ * octetsToNextHeader of 0, as DATA does, extends to the end of the RTPS
+ * message (RTPS 9.4.5.1.3): before anything follows it, that submessage
+ * gets its real length and is padded to the next 4 byte boundary.  The
+ * bundler isn't locked, its owner serializes the calls.
+ */
+class OpenDDS_Rtps_Udp_Export RtpsBundler {
+public:
+  /// Receives the bundles that are ready to be sent.
+  class Sender {
+  public:
+    virtual ~Sender() {}
+    virtual void send_bundle(const iovec iov[], int n,
+                             const ACE_INET_Addr& addr) = 0;
+  };
+
+  /// Bundles start with the RTPSHDR_SZ bytes at 'rtps_header', which must
+  /// outlive the bundler, and hold up to 'max_size' bytes.
+  RtpsBundler(Sender& sender, const char* rtps_header, size_t max_size);
+
+  size_t max_size() const { return max_size_; }
+
+  /// Add the RTPS message in iov, 'size' bytes including its header, to
+  /// the bundle for 'addr'.  If it doesn't fit that bundle is sent first.
+  /// 'size' must not exceed max_size().  Returns true if the message
+  /// started a new bundle.
+  bool add(const iovec iov[], int n, size_t size, const ACE_INET_Addr& addr);
+
+  /// Send the bundle for 'addr', if it holds anything.
+  void send(const ACE_INET_Addr& addr);
+
+  /// Send every bundle.  Addresses that had nothing to send since the
+  /// previous call are forgotten.
+  void send_all();
+
+  /// Bytes waiting to be sent to 'addr'.
+  size_t pending(const ACE_INET_Addr& addr) const;
+
+  enum { INFO_DST_TOTAL = RTPS::SMHDR_SZ + RTPS::INFO_DST_SZ };
+
+private:
+  Sender& sender_;
+  const char* const rtps_header_;
+  const size_t max_size_;
+  /// INFO_DST submessage that restores the default destination.
+  char info_dst_reset_[INFO_DST_TOTAL];
+
+  struct Bundle {
+    Bundle() : open_(NONE) {}
+    Message_Block_Ptr mb_;
+    /// Offset in mb_ of a last submessage that extends to the end of the
+    /// message, NONE if there is none.
+    size_t open_;
+  };
+  static const size_t NONE = static_cast<size_t>(-1);
+
+  /// Give the open submessage of 'bundle' its length and pad it, returns
+  /// false if its length can't be represented.
+  static bool close(Bundle& bundle);
+
+  /// Offset of the submessage that extends to the end of the message
+  /// starting at 'offset' in 'mb', NONE if every submessage has a length.
+  static size_t find_open(const ACE_Message_Block& mb, size_t offset);
+
+  typedef OPENDDS_MAP(ACE_INET_Addr, Bundle) BundleMap;
+  BundleMap bundles_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* DCPS_RTPSBUNDLER_H */
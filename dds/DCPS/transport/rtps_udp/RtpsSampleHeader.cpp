@@ -595,6 +595,62 @@ namespace {
   const size_t FRAG_START_OFFSET = 24, FRAG_SAMPLE_SIZE_OFFSET = 32;
 }
 
+ACE_Message_Block*
+RtpsSampleHeader::marshal_data_sample_header(const ACE_Message_Block& orig,
+                                             const DataSampleElement& dsle)
+{
+  using namespace RTPS;
+  const DataSampleHeader& header = dsle.get_header();
+  const ACE_CDR::Octet flags = header.byte_order_;
+  const bool swap_bytes = ACE_CDR_BYTE_ORDER != bool(flags & FLAG_E);
+  const bool info_dst = dsle.get_num_subs() == 1;
+
+  // Same layout populate_data_sample_submessages() produces for a
+  // SAMPLE_DATA message without inline QoS.
+  static const size_t INFO_TS_TOTAL = SMHDR_SZ + INFO_TS_SZ,
+    INFO_DST_TOTAL = SMHDR_SZ + INFO_DST_SZ,
+    DATA_TOTAL = SMHDR_SZ + 4 + DATA_OCTETS_TO_IQOS;
+
+  Message_Block_Ptr hdr(DataSampleHeader::alloc_msgblock(orig,
+    INFO_TS_TOTAL + (info_dst ? INFO_DST_TOTAL : 0) + DATA_TOTAL, false));
+  if (!hdr) {
+    return 0;
+  }
+
+  hdr->wr_ptr()[0] = INFO_TS;
+  hdr->wr_ptr()[1] = flags;
+  hdr->wr_ptr(2);
+  write(hdr, INFO_TS_SZ, swap_bytes);
+  write(hdr, static_cast<ACE_CDR::ULong>(header.source_timestamp_sec_), swap_bytes);
+  write(hdr, static_cast<ACE_CDR::ULong>(
+    header.source_timestamp_nanosec_ * NANOS_TO_RTPS_FRACS + .5), swap_bytes);
+
+  EntityId_t readerId = ENTITYID_UNKNOWN;
+  if (info_dst) {
+    const GUID_t& sub = dsle.get_sub_id(0);
+    readerId = sub.entityId;
+    hdr->wr_ptr()[0] = INFO_DST;
+    hdr->wr_ptr()[1] = flags;
+    hdr->wr_ptr(2);
+    write(hdr, INFO_DST_SZ, swap_bytes);
+    hdr->copy(reinterpret_cast<const char*>(sub.guidPrefix), sizeof(GuidPrefix_t));
+  }
+
+  hdr->wr_ptr()[0] = DATA;
+  hdr->wr_ptr()[1] = flags | FLAG_D;
+  hdr->wr_ptr(2);
+  std::memset(hdr->wr_ptr(), 0, 4); // octetsToNextHeader, extraFlags
+  hdr->wr_ptr(4);
+  write(hdr, DATA_OCTETS_TO_IQOS, swap_bytes);
+  hdr->copy(reinterpret_cast<const char*>(&readerId), sizeof(EntityId_t));
+  hdr->copy(reinterpret_cast<const char*>(&dsle.get_pub_id().entityId),
+            sizeof(EntityId_t));
+  write(hdr, static_cast<ACE_CDR::ULong>(header.sequence_.getHigh()), swap_bytes);
+  write(hdr, header.sequence_.getLow(), swap_bytes);
+
+  return hdr.release();
+}
+
 SequenceRange
 RtpsSampleHeader::split(const ACE_Message_Block& orig, size_t size,
                         Message_Block_Ptr& head, Message_Block_Ptr& tail)
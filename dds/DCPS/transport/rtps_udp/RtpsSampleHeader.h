@@ -80,6 +80,12 @@ public:
   static void populate_data_sample_submessages(RTPS::SubmessageSeq& subm,
                                                const DataSampleElement& dsle,
                                                bool requires_inline_qos);
+  /// Marshal INFO_TS, INFO_DST (if the sample has a single destination)
+  /// and DATA directly into a block allocated like @a orig, skipping the
+  /// SubmessageSeq.  Only for samples that need neither inline QoS nor
+  /// preceding submessages; returns 0 if the block can't be allocated.
+  static ACE_Message_Block* marshal_data_sample_header(const ACE_Message_Block& orig,
+                                                       const DataSampleElement& dsle);
   static void populate_data_control_submessages(RTPS::SubmessageSeq& subm,
                                                 const TransportSendControlElement& tsce,
                                                 bool requires_inline_qos);
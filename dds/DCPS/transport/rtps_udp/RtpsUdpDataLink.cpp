@@ -79,6 +79,8 @@ RtpsUdpDataLink::RtpsUdpDataLink(RtpsUdpTransport& transport,
              false,     // is_loopback
              false),    // is_active
     reactor_task_(reactor_task),
+    locators_version_(1),
+    shmem_inbox_(0),
     multi_buff_(this, config.nak_depth_),
     best_effort_heartbeat_count_(0),
     nack_reply_(this, &RtpsUdpDataLink::send_nack_replies,
@@ -87,6 +89,7 @@ RtpsUdpDataLink::RtpsUdpDataLink(RtpsUdpTransport& transport,
                      config.heartbeat_response_delay_),
   heartbeat_(make_rch<HeartBeat>(reactor_task->get_reactor(), reactor_task->get_reactor_owner(), this, &RtpsUdpDataLink::send_heartbeats)),
   heartbeatchecker_(make_rch<HeartBeat>(reactor_task->get_reactor(), reactor_task->get_reactor_owner(), this, &RtpsUdpDataLink::check_heartbeats)),
+  bundle_timer_(make_rch<BundleTimer>(reactor_task->get_reactor(), reactor_task->get_reactor_owner(), this)),
   held_data_delivery_handler_(this)
 {
   this->send_strategy_ = make_rch<RtpsUdpSendStrategy>(this, local_prefix);
@@ -100,6 +103,12 @@ RtpsUdpDataLink::config() const
   return static_cast<RtpsUdpTransport&>(impl()).config();
 }
 
+ACE_Thread_Mutex&
+RtpsUdpDataLink::reliability_lock(EntityKind kind) const
+{
+  return kind == KIND_WRITER ? writers_lock_ : readers_lock_;
+}
+
 bool
 RtpsUdpDataLink::add_delayed_notification(TransportQueueElement* element)
 {
@@ -161,9 +170,11 @@ void RtpsUdpDataLink::do_remove_sample(const RepoId& pub_id,
 }
 
 bool
-RtpsUdpDataLink::open(const ACE_SOCK_Dgram& unicast_socket)
+RtpsUdpDataLink::open(const ACE_SOCK_Dgram& unicast_socket,
+                      RtpsShmemInbox* shmem_inbox)
 {
   unicast_socket_ = unicast_socket;
+  shmem_inbox_ = shmem_inbox;
 
   RtpsUdpInst& config = this->config();
 
@@ -242,8 +253,19 @@ RtpsUdpDataLink::add_locator(const RepoId& remote_id,
                              const ACE_INET_Addr& address,
                              bool requires_inline_qos)
 {
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
-  locators_[remote_id] = RemoteInfo(address, requires_inline_qos);
+  ACE_GUARD(ACE_Thread_Mutex, g, locators_lock_);
+  RemoteInfo& info = locators_[remote_id];
+  if (info.addr_ != address) {
+    ++locators_version_;
+  }
+  info = RemoteInfo(address, requires_inline_qos);
+}
+
+void
+RtpsUdpDataLink::add_shmem_peer(const ACE_INET_Addr& address,
+                                const Locator_t& locator)
+{
+  send_strategy()->add_shmem_peer(address, locator);
 }
 
 void
@@ -253,6 +275,7 @@ RtpsUdpDataLink::get_locators(const RepoId& local_id,
   typedef OPENDDS_MAP_CMP(RepoId, RemoteInfo, GUID_tKeyLessThan)::const_iterator iter_t;
 
   if (local_id == GUID_UNKNOWN) {
+    ACE_GUARD(ACE_Thread_Mutex, g, locators_lock_);
     for (iter_t iter = locators_.begin(); iter != locators_.end(); ++iter) {
       addrs.insert(iter->second.addr_);
     }
@@ -263,8 +286,9 @@ RtpsUdpDataLink::get_locators(const RepoId& local_id,
   if (!peers.ptr()) {
     return;
   }
+  ACE_GUARD(ACE_Thread_Mutex, g, locators_lock_);
   for (CORBA::ULong i = 0; i < peers->length(); ++i) {
-    const ACE_INET_Addr addr = get_locator(peers[i]);
+    const ACE_INET_Addr addr = get_locator_i(peers[i]);
     if (addr != ACE_INET_Addr()) {
       addrs.insert(addr);
     }
@@ -273,6 +297,26 @@ RtpsUdpDataLink::get_locators(const RepoId& local_id,
 
 ACE_INET_Addr
 RtpsUdpDataLink::get_locator(const RepoId& remote_id) const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, locators_lock_, ACE_INET_Addr());
+  return get_locator_i(remote_id);
+}
+
+bool
+RtpsUdpDataLink::find_locator(const RepoId& remote_id, ACE_INET_Addr& addr) const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, locators_lock_, false);
+  typedef OPENDDS_MAP_CMP(RepoId, RemoteInfo, GUID_tKeyLessThan)::const_iterator iter_t;
+  const iter_t iter = locators_.find(remote_id);
+  if (iter == locators_.end()) {
+    return false;
+  }
+  addr = iter->second.addr_;
+  return true;
+}
+
+ACE_INET_Addr
+RtpsUdpDataLink::get_locator_i(const RepoId& remote_id) const
 {
   typedef OPENDDS_MAP_CMP(RepoId, RemoteInfo, GUID_tKeyLessThan)::const_iterator iter_t;
   const iter_t iter = locators_.find(remote_id);
@@ -296,15 +340,17 @@ RtpsUdpDataLink::associated(const RepoId& local_id, const RepoId& remote_id,
 
   bool enable_heartbeat = false;
 
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
   const GuidConverter conv(local_id);
   const EntityKind kind = conv.entityKind();
+  ACE_GUARD(ACE_Thread_Mutex, g, reliability_lock(kind));
   if (kind == KIND_WRITER && remote_reliable) {
     // Insert count if not already there.
     heartbeat_counts_.insert(HeartBeatCountMapType::value_type(local_id, 0));
     RtpsWriter& w = writers_[local_id];
-    w.remote_readers_[remote_id].durable_ = remote_durable;
+    w.add_reader(remote_id).durable_ = remote_durable;
     w.durable_ = local_durable;
+    w.reader_addrs_version_ = 0;
+    w.readers_pending_ = true;
     enable_heartbeat = true;
 
   } else if (kind == KIND_READER) {
@@ -353,7 +399,7 @@ RtpsUdpDataLink::register_for_reader(const RepoId& writerid,
                                      const ACE_INET_Addr& address,
                                      OpenDDS::DCPS::DiscoveryListener* listener)
 {
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  ACE_GUARD(ACE_Thread_Mutex, g, writers_lock_);
   bool enableheartbeat = interesting_readers_.empty();
   interesting_readers_.insert(InterestingRemoteMapType::value_type(readerid, InterestingRemote(writerid, address, listener)));
   heartbeat_counts_[writerid] = 0;
@@ -367,7 +413,7 @@ void
 RtpsUdpDataLink::unregister_for_reader(const RepoId& writerid,
                                        const RepoId& readerid)
 {
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  ACE_GUARD(ACE_Thread_Mutex, g, writers_lock_);
   for (InterestingRemoteMapType::iterator pos = interesting_readers_.lower_bound(readerid),
          limit = interesting_readers_.upper_bound(readerid);
        pos != limit;
@@ -386,7 +432,7 @@ RtpsUdpDataLink::register_for_writer(const RepoId& readerid,
                                      const ACE_INET_Addr& address,
                                      OpenDDS::DCPS::DiscoveryListener* listener)
 {
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  ACE_GUARD(ACE_Thread_Mutex, g, readers_lock_);
   bool enableheartbeatchecker = interesting_writers_.empty();
   interesting_writers_.insert(InterestingRemoteMapType::value_type(writerid, InterestingRemote(readerid, address, listener)));
   g.release();
@@ -399,7 +445,7 @@ void
 RtpsUdpDataLink::unregister_for_writer(const RepoId& readerid,
                                        const RepoId& writerid)
 {
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  ACE_GUARD(ACE_Thread_Mutex, g, readers_lock_);
   for (InterestingRemoteMapType::iterator pos = interesting_writers_.lower_bound(writerid),
          limit = interesting_writers_.upper_bound(writerid);
        pos != limit;
@@ -420,7 +466,7 @@ RtpsUdpDataLink::pre_stop_i()
   OPENDDS_VECTOR(TransportQueueElement*) to_deliver;
   OPENDDS_VECTOR(TransportQueueElement*) to_drop;
   {
-    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    ACE_GUARD(ACE_Thread_Mutex, g, writers_lock_);
 
     typedef OPENDDS_MULTIMAP(SequenceNumber, TransportQueueElement*)::iterator iter_t;
 
@@ -475,7 +521,7 @@ RtpsUdpDataLink::send_i(TransportQueueElement* element, bool relink)
   // Lock here to maintain the locking order:
   // RtpsUdpDataLink before RtpsUdpSendStrategy
   // which is required for resending due to nacks
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  ACE_GUARD(ACE_Thread_Mutex, g, writers_lock_);
   DataLink::send_i(element, relink);
 }
 
@@ -483,7 +529,7 @@ RemoveResult
 RtpsUdpDataLink::remove_sample(const DataSampleElement* sample, void*)
 {
   // see comment in RtpsUdpDataLink::send_i() for lock order
-  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, REMOVE_ERROR);
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, writers_lock_, REMOVE_ERROR);
   return DataLink::remove_sample(sample, &g);
 }
 
@@ -493,15 +539,16 @@ RtpsUdpDataLink::release_reservations_i(const RepoId& remote_id,
 {
   OPENDDS_VECTOR(TransportQueueElement*) to_deliver;
   OPENDDS_VECTOR(TransportQueueElement*) to_drop;
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
   using std::pair;
   const GuidConverter conv(local_id);
   const EntityKind kind = conv.entityKind();
+  ACE_GUARD(ACE_Thread_Mutex, g, reliability_lock(kind));
   if (kind == KIND_WRITER) {
     const RtpsWriterMap::iterator rw = writers_.find(local_id);
 
     if (rw != writers_.end()) {
-      rw->second.remote_readers_.erase(remote_id);
+      rw->second.remove_reader(remote_id);
+      rw->second.reader_addrs_version_ = 0;
 
       if (rw->second.remote_readers_.empty()) {
         RtpsWriter& writer = rw->second;
@@ -570,6 +617,55 @@ RtpsUdpDataLink::release_reservations_i(const RepoId& remote_id,
     (*drop_it)->data_dropped(true);
     ++drop_it;
   }
+
+  if (config().use_shmem_) {
+    release_shmem_peer(remote_id);
+  }
+}
+
+void
+RtpsUdpDataLink::release_shmem_peer(const RepoId& remote_id)
+{
+  ACE_INET_Addr addr;
+  if (!find_locator(remote_id, addr)) {
+    return;
+  }
+
+  // Remote endpoints that are still associated, writers_lock_ and
+  // readers_lock_ are never held together.
+  RepoIdSet remotes;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, writers_lock_);
+    for (RtpsWriterMap::const_iterator rw = writers_.begin();
+         rw != writers_.end(); ++rw) {
+      for (ReaderInfoMap::const_iterator ri = rw->second.remote_readers_.begin();
+           ri != rw->second.remote_readers_.end(); ++ri) {
+        remotes.insert(ri->first);
+      }
+    }
+  }
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, readers_lock_);
+    for (RtpsReaderIndex::const_iterator ri = reader_index_.begin();
+         ri != reader_index_.end(); ++ri) {
+      remotes.insert(ri->first);
+    }
+  }
+
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, locators_lock_);
+    typedef OPENDDS_MAP_CMP(RepoId, RemoteInfo, GUID_tKeyLessThan)::const_iterator iter_t;
+    for (RepoIdSet::const_iterator r = remotes.begin(); r != remotes.end(); ++r) {
+      const iter_t iter = locators_.find(*r);
+      if (iter != locators_.end() && iter->second.addr_ == addr) {
+        return;
+      }
+    }
+  }
+
+  // An association with the same peer that is being made now uses UDP
+  // until its next add_shmem_peer().
+  send_strategy()->remove_shmem_peer(addr);
 }
 
 void
@@ -577,7 +673,9 @@ RtpsUdpDataLink::stop_i()
 {
   nack_reply_.cancel();
   heartbeat_reply_.cancel();
+  bundle_timer_->cancel();
   heartbeat_->disable();
+  send_strategy()->send_bundles();
   unicast_socket_.close();
   multicast_socket_.close();
 }
@@ -588,7 +686,7 @@ RtpsUdpDataLink::stop_i()
 void
 RtpsUdpDataLink::MultiSendBuffer::retain_all(RepoId pub_id)
 {
-  ACE_GUARD(ACE_Thread_Mutex, g, outer_->lock_);
+  ACE_GUARD(ACE_Thread_Mutex, g, outer_->writers_lock_);
   const RtpsWriterMap::iterator wi = outer_->writers_.find(pub_id);
   if (wi != outer_->writers_.end() && !wi->second.send_buff_.is_nil()) {
     wi->second.send_buff_->retain_all(pub_id);
@@ -601,7 +699,7 @@ RtpsUdpDataLink::MultiSendBuffer::insert(SequenceNumber /*transport_seq*/,
                                          ACE_Message_Block* chain)
 {
   // Called from TransportSendStrategy::send_packet().
-  // RtpsUdpDataLink is already locked.
+  // RtpsUdpDataLink::writers_lock_ is already held.
   const TransportQueueElement* const tqe = q->peek();
   const SequenceNumber seq = tqe->sequence();
   if (seq == SequenceNumber::SEQUENCENUMBER_UNKNOWN()) {
@@ -674,6 +772,26 @@ namespace {
   }
 }
 
+void
+RtpsUdpDataLink::marshal_data_sample(Message_Block_Ptr& hdr,
+                                     RTPS::SubmessageSeq& subm,
+                                     const ACE_Message_Block& msg,
+                                     const DataSampleElement& dsle,
+                                     const RepoId& pub_id)
+{
+  const bool inline_qos = requires_inline_qos(pub_id);
+  // Without in-line GAPs or QoS the header is marshaled directly,
+  // otherwise the submessages are built up and serialized.
+  if (subm.length() == 0 && !inline_qos &&
+      dsle.get_header().message_id_ == SAMPLE_DATA) {
+    hdr.reset(RtpsSampleHeader::marshal_data_sample_header(msg, dsle));
+    if (hdr) {
+      return;
+    }
+  }
+  RtpsSampleHeader::populate_data_sample_submessages(subm, dsle, inline_qos);
+}
+
 TransportQueueElement*
 RtpsUdpDataLink::customize_queue_element(TransportQueueElement* element)
 {
@@ -684,7 +802,7 @@ RtpsUdpDataLink::customize_queue_element(TransportQueueElement* element)
 
   const RepoId pub_id = element->publication_id();
 
-  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, 0);
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, writers_lock_, 0);
 
   RTPS::SubmessageSeq subm;
 
@@ -728,6 +846,7 @@ RtpsUdpDataLink::customize_queue_element(TransportQueueElement* element)
     dynamic_cast<TransportSendControlElement*>(element);
 
   Message_Block_Ptr data;
+  Message_Block_Ptr hdr;
   bool durable = false;
 
   // Based on the type of 'element', find and duplicate the data payload
@@ -756,8 +875,7 @@ RtpsUdpDataLink::customize_queue_element(TransportQueueElement* element)
     data.reset(msg->cont()->duplicate());
     const DataSampleElement* dsle = tse->sample();
     // Create RTPS Submessage(s) in place of the OpenDDS DataSampleHeader
-    RtpsSampleHeader::populate_data_sample_submessages(
-              subm, *dsle, requires_inline_qos(pub_id));
+    marshal_data_sample(hdr, subm, *msg, *dsle, pub_id);
     durable = dsle->get_header().historic_sample_;
 
   } else if (tce) {  // Customized data message
@@ -765,15 +883,16 @@ RtpsUdpDataLink::customize_queue_element(TransportQueueElement* element)
     data.reset(msg->cont()->cont()->duplicate());
     const DataSampleElement* dsle = tce->original_send_element()->sample();
     // Create RTPS Submessage(s) in place of the OpenDDS DataSampleHeader
-    RtpsSampleHeader::populate_data_sample_submessages(
-              subm, *dsle, requires_inline_qos(pub_id));
+    marshal_data_sample(hdr, subm, *msg, *dsle, pub_id);
     durable = dsle->get_header().historic_sample_;
 
   } else {
     return element;
   }
 
-  Message_Block_Ptr hdr(submsgs_to_msgblock(subm));
+  if (!hdr) {
+    hdr.reset(submsgs_to_msgblock(subm));
+  }
   hdr->cont(data.release());
   RtpsCustomizedElement* rtps =
     new RtpsCustomizedElement(element, move(hdr));
@@ -786,6 +905,7 @@ RtpsUdpDataLink::customize_queue_element(TransportQueueElement* element)
       if (ri != rw->second.remote_readers_.end()) {
         ri->second.durable_data_[rtps->sequence()] = rtps;
         ri->second.durable_timestamp_ = ACE_OS::gettimeofday();
+        rw->second.readers_pending_ = true;
         if (Transport_debug_level > 3) {
           const GuidConverter conv(pub_id), sub_conv(sub);
           ACE_DEBUG((LM_DEBUG,
@@ -862,6 +982,7 @@ RtpsUdpDataLink::requires_inline_qos(const PublicationId& pub_id)
       return false;
     }
     typedef OPENDDS_MAP_CMP(RepoId, RemoteInfo, GUID_tKeyLessThan)::iterator iter_t;
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, locators_lock_, false);
     for (CORBA::ULong i = 0; i < peers->length(); ++i) {
       const iter_t iter = locators_.find(peers[i]);
       if (iter != locators_.end() && iter->second.requires_inline_qos_) {
@@ -1007,7 +1128,7 @@ RtpsUdpDataLink::process_data_i(const RTPS::DataSubmessage& data,
       }
       const ReceivedDataSample* sample =
         receive_strategy()->withhold_data_from(readerId);
-      info.held_.insert(std::make_pair(seq, *sample));
+      info.held_.hold(seq, *sample, config().held_data_depth_);
     } else {
       if (Transport_debug_level > 5) {
         GuidConverter writer(src);
@@ -1112,7 +1233,7 @@ RtpsUdpDataLink::received(const RTPS::HeartBeatSubmessage& heartbeat,
   OPENDDS_VECTOR(InterestingRemote) callbacks;
 
   {
-    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    ACE_GUARD(ACE_Thread_Mutex, g, readers_lock_);
 
     // We received a heartbeat from a writer.
     // We should ACKNACK if the writer is interesting and there is no association.
@@ -1393,7 +1514,8 @@ RtpsUdpDataLink::send_ack_nacks(RtpsReaderMap::iterator rr, bool finalFlag)
         ser << nack_frags[i]; // always 4-byte aligned
       }
 
-      if (!locators_.count(wi->first)) {
+      ACE_INET_Addr addr;
+      if (!find_locator(wi->first, addr)) {
         if (Transport_debug_level) {
           const GuidConverter conv(wi->first);
           ACE_ERROR((LM_ERROR,
@@ -1401,8 +1523,7 @@ RtpsUdpDataLink::send_ack_nacks(RtpsReaderMap::iterator rr, bool finalFlag)
                      "no locator for remote %C\n", OPENDDS_STRING(conv).c_str()));
         }
       } else {
-        send_strategy()->send_rtps_control(mb_acknack,
-                                          locators_[wi->first].addr_);
+        send_strategy()->send_rtps_control(mb_acknack, addr);
       }
     }
   }
@@ -1412,7 +1533,7 @@ void
 RtpsUdpDataLink::send_heartbeat_replies() // from DR to DW
 {
   using namespace OpenDDS::RTPS;
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  ACE_GUARD(ACE_Thread_Mutex, g, readers_lock_);
 
   for (InterestingAckNackSetType::const_iterator pos = interesting_ack_nacks_.begin(),
          limit = interesting_ack_nacks_.end();
@@ -1632,7 +1753,7 @@ RtpsUdpDataLink::received(const RTPS::AckNackSubmessage& acknack,
   OPENDDS_VECTOR(DiscoveryListener*) callbacks;
 
   {
-    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    ACE_GUARD(ACE_Thread_Mutex, g, writers_lock_);
     for (InterestingRemoteMapType::iterator pos = interesting_readers_.lower_bound(remote),
            limit = interesting_readers_.upper_bound(remote);
          pos != limit;
@@ -1652,7 +1773,7 @@ RtpsUdpDataLink::received(const RTPS::AckNackSubmessage& acknack,
     callbacks[i]->reader_exists(remote, local);
   }
 
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  ACE_GUARD(ACE_Thread_Mutex, g, writers_lock_);
   const RtpsWriterMap::iterator rw = writers_.find(local);
   if (rw == writers_.end()) {
     if (Transport_debug_level > 5) {
@@ -1800,12 +1921,27 @@ RtpsUdpDataLink::received(const RTPS::AckNackSubmessage& acknack,
                acknack.readerSNState.bitmapBase.low);
   if (ack != SequenceNumber::SEQUENCENUMBER_UNKNOWN()
       && ack != SequenceNumber::ZERO()) {
-    ri->second.cur_cumulative_ack_ = ack;
+    rw->second.reader_acks_.update(ri->first, ack);
   }
   // If this ACKNACK was final, the DR doesn't expect a reply, and therefore
   // we don't need to do anything further.
   if (!final || bitmapNonEmpty(acknack.readerSNState)) {
-    ri->second.requested_changes_.push_back(acknack.readerSNState);
+    const RTPS::SequenceNumberSet& sn_state = acknack.readerSNState;
+    SequenceNumber base;
+    base.setValue(sn_state.bitmapBase.high, sn_state.bitmapBase.low);
+    if (sn_state.numBits == 1 && !(sn_state.bitmap[0] & 1)
+        && base == rw->second.heartbeat_high(ri->second)) {
+      // The DR sent a non-final AckNack whose base value is the high end of
+      // the heartbeat range, treat it as a request for that seq#.
+      if (!rw->second.send_buff_.is_nil()
+          && rw->second.send_buff_->contains(base)) {
+        ri->second.requested_changes_.insert(base);
+      }
+    } else {
+      ri->second.requested_changes_.insert(base, sn_state.numBits,
+                                           sn_state.bitmap.get_buffer());
+    }
+    ri->second.nack_pending_ = true;
   }
   process_acked_by_all_i(g, local);
   g.release();
@@ -1828,7 +1964,7 @@ RtpsUdpDataLink::received(const RTPS::NackFragSubmessage& nackfrag,
   std::memcpy(local.guidPrefix, local_prefix_, sizeof(GuidPrefix_t));
   local.entityId = nackfrag.writerId; // can't be ENTITYID_UNKNOWN
 
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  ACE_GUARD(ACE_Thread_Mutex, g, writers_lock_);
   const RtpsWriterMap::iterator rw = writers_.find(local);
   if (rw == writers_.end()) {
     if (Transport_debug_level > 5) {
@@ -1875,7 +2011,7 @@ RtpsUdpDataLink::received(const RTPS::NackFragSubmessage& nackfrag,
 void
 RtpsUdpDataLink::send_nack_replies()
 {
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  ACE_GUARD(ACE_Thread_Mutex, g, writers_lock_);
   // Reply from local DW to remote DR: GAP or DATA
   using namespace OpenDDS::RTPS;
   typedef RtpsWriterMap::iterator rw_iter;
@@ -1886,37 +2022,19 @@ RtpsUdpDataLink::send_nack_replies()
     DisjointSequence requests;
     RtpsWriter& writer = rw->second;
 
-    //track if any messages have been fully acked by all readers
-    SequenceNumber all_readers_ack = SequenceNumber::MAX_VALUE;
-
     typedef ReaderInfoMap::iterator ri_iter;
     const ri_iter end = writer.remote_readers_.end();
     for (ri_iter ri = writer.remote_readers_.begin(); ri != end; ++ri) {
 
-      if (ri->second.cur_cumulative_ack_ < all_readers_ack) {
-        all_readers_ack = ri->second.cur_cumulative_ack_;
-      }
-
-      for (size_t i = 0; i < ri->second.requested_changes_.size(); ++i) {
-        const SequenceNumberSet& sn_state = ri->second.requested_changes_[i];
-        SequenceNumber base;
-        base.setValue(sn_state.bitmapBase.high, sn_state.bitmapBase.low);
-        if (sn_state.numBits == 1 && !(sn_state.bitmap[0] & 1)
-            && base == writer.heartbeat_high(ri->second)) {
-          // Since there is an entry in requested_changes_, the DR must have
-          // sent a non-final AckNack.  If the base value is the high end of
-          // the heartbeat range, treat it as a request for that seq#.
-          if (!writer.send_buff_.is_nil() && writer.send_buff_->contains(base)) {
-            requests.insert(base);
-          }
-        } else {
-          requests.insert(base, sn_state.numBits, sn_state.bitmap.get_buffer());
+      if (ri->second.nack_pending_) {
+        const OPENDDS_VECTOR(SequenceRange) ranges =
+          ri->second.requested_changes_.present_sequence_ranges();
+        for (size_t i = 0; i < ranges.size(); ++i) {
+          requests.insert(ranges[i]);
         }
-      }
-
-      if (ri->second.requested_changes_.size()) {
-        if (locators_.count(ri->first)) {
-          recipients.insert(locators_[ri->first].addr_);
+        ACE_INET_Addr addr;
+        if (find_locator(ri->first, addr)) {
+          recipients.insert(addr);
           if (Transport_debug_level > 5) {
             const GuidConverter local_conv(rw->first), remote_conv(ri->first);
             ACE_DEBUG((LM_DEBUG, "RtpsUdpDataLink::send_nack_replies "
@@ -1925,7 +2043,8 @@ RtpsUdpDataLink::send_nack_replies()
                        OPENDDS_STRING(remote_conv).c_str()));
           }
         }
-        ri->second.requested_changes_.clear();
+        ri->second.requested_changes_.reset();
+        ri->second.nack_pending_ = false;
       }
     }
 
@@ -1965,9 +2084,6 @@ RtpsUdpDataLink::send_nack_replies()
         mb_gap->release();
       }
     }
-    if (all_readers_ack == SequenceNumber::MAX_VALUE) {
-      continue;
-    }
   }
 }
 
@@ -1983,12 +2099,12 @@ RtpsUdpDataLink::send_nackfrag_replies(RtpsWriter& writer,
   const ri_iter end = writer.remote_readers_.end();
   for (ri_iter ri = writer.remote_readers_.begin(); ri != end; ++ri) {
 
-    if (ri->second.requested_frags_.empty() || !locators_.count(ri->first)) {
+    ACE_INET_Addr remote_addr;
+    if (ri->second.requested_frags_.empty()
+        || !find_locator(ri->first, remote_addr)) {
       continue;
     }
 
-    const ACE_INET_Addr& remote_addr = locators_[ri->first].addr_;
-
     typedef OPENDDS_MAP(SequenceNumber, RTPS::FragmentNumberSet)::iterator rf_iter;
     const rf_iter rf_end = ri->second.requested_frags_.end();
     for (rf_iter rf = ri->second.requested_frags_.begin(); rf != rf_end; ++rf) {
@@ -2037,17 +2153,7 @@ RtpsUdpDataLink::process_acked_by_all_i(ACE_Guard<ACE_Thread_Mutex>& g, const Re
   RtpsWriter& writer = rw->second;
   if (!writer.elems_not_acked_.empty()) {
 
-    //start with the max sequence number writer knows about and decrease
-    //by what the min over all readers is
-    SequenceNumber all_readers_ack = SequenceNumber::MAX_VALUE;
-
-    typedef ReaderInfoMap::iterator ri_iter;
-    const ri_iter end = writer.remote_readers_.end();
-    for (ri_iter ri = writer.remote_readers_.begin(); ri != end; ++ri) {
-      if (ri->second.cur_cumulative_ack_ < all_readers_ack) {
-        all_readers_ack = ri->second.cur_cumulative_ack_;
-      }
-    }
+    const SequenceNumber all_readers_ack = writer.reader_acks_.acked_by_all();
     if (all_readers_ack == SequenceNumber::MAX_VALUE) {
       return;
     }
@@ -2222,6 +2328,27 @@ RtpsUdpDataLink::send_durability_gaps(const RepoId& writer,
   mb.cont()->release();
 }
 
+const OPENDDS_VECTOR(ACE_INET_Addr)&
+RtpsUdpDataLink::reader_addrs(RtpsWriter& writer)
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, locators_lock_, writer.reader_addrs_);
+  if (writer.reader_addrs_version_ != locators_version_) {
+    OPENDDS_SET(ACE_INET_Addr) addrs;
+    typedef OPENDDS_MAP_CMP(RepoId, RemoteInfo, GUID_tKeyLessThan)::const_iterator
+      loc_iter;
+    for (ReaderInfoMap::const_iterator ri = writer.remote_readers_.begin();
+         ri != writer.remote_readers_.end(); ++ri) {
+      const loc_iter loc = locators_.find(ri->first);
+      if (loc != locators_.end()) {
+        addrs.insert(loc->second.addr_);
+      }
+    }
+    writer.reader_addrs_.assign(addrs.begin(), addrs.end());
+    writer.reader_addrs_version_ = locators_version_;
+  }
+  return writer.reader_addrs_;
+}
+
 void
 RtpsUdpDataLink::send_heartbeats()
 {
@@ -2229,7 +2356,7 @@ RtpsUdpDataLink::send_heartbeats()
   OPENDDS_VECTOR(TransportQueueElement*) pendingCallbacks;
 
   {
-    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    ACE_GUARD(ACE_Thread_Mutex, g, writers_lock_);
 
     if (writers_.empty() && interesting_readers_.empty()) {
       heartbeat_->disable();
@@ -2237,10 +2364,15 @@ RtpsUdpDataLink::send_heartbeats()
 
     using namespace OpenDDS::RTPS;
     OPENDDS_VECTOR(HeartBeatSubmessage) subm;
-    OPENDDS_SET(ACE_INET_Addr) recipients;
+    // Indexes into subm of the heartbeats each destination needs.
+    typedef OPENDDS_VECTOR(size_t) HeartBeatIndexes;
+    typedef OPENDDS_MAP(ACE_INET_Addr, HeartBeatIndexes) DestinationMap;
+    DestinationMap destinations;
     const ACE_Time_Value now = ACE_OS::gettimeofday();
 
-    RepoIdSet writers_to_advertise;
+    typedef OPENDDS_MAP_CMP(RepoId, OPENDDS_SET(ACE_INET_Addr), GUID_tKeyLessThan)
+      AdvertiseMap;
+    AdvertiseMap writers_to_advertise;
 
     RtpsUdpInst& config = this->config();
 
@@ -2252,8 +2384,7 @@ RtpsUdpDataLink::send_heartbeats()
          ++pos) {
       if (pos->second.status == InterestingRemote::DOES_NOT_EXIST ||
           (pos->second.status == InterestingRemote::EXISTS && pos->second.last_activity < tv3)) {
-        recipients.insert(pos->second.address);
-        writers_to_advertise.insert(pos->second.localid);
+        writers_to_advertise[pos->second.localid].insert(pos->second.address);
       }
       if (pos->second.status == InterestingRemote::EXISTS && pos->second.last_activity < tv) {
         CallbackType callback(pos->first, pos->second);
@@ -2262,69 +2393,91 @@ RtpsUdpDataLink::send_heartbeats()
       }
     }
 
+    OPENDDS_SET(ACE_INET_Addr) recipients;
     typedef RtpsWriterMap::iterator rw_iter;
     for (rw_iter rw = writers_.begin(); rw != writers_.end(); ++rw) {
-      const bool has_data = !rw->second.send_buff_.is_nil()
-                            && !rw->second.send_buff_->empty();
+      RtpsWriter& writer = rw->second;
+      const bool has_data = !writer.send_buff_.is_nil()
+                            && !writer.send_buff_->empty();
       bool final = true, has_durable_data = false;
       SequenceNumber durable_max;
+      recipients.clear();
 
-      typedef ReaderInfoMap::iterator ri_iter;
-      const ri_iter end = rw->second.remote_readers_.end();
-      for (ri_iter ri = rw->second.remote_readers_.begin(); ri != end; ++ri) {
-        if ((has_data || !ri->second.handshake_done_)
-            && locators_.count(ri->first)) {
-          recipients.insert(locators_[ri->first].addr_);
-          if (final && !ri->second.handshake_done_) {
-            final = false;
-          }
-        }
-        if (!ri->second.durable_data_.empty()) {
-          const ACE_Time_Value expiration =
-            ri->second.durable_timestamp_ + config.durable_data_timeout_;
-          if (now > expiration) {
-            typedef OPENDDS_MAP(SequenceNumber, TransportQueueElement*)::iterator
-              dd_iter;
-            for (dd_iter it = ri->second.durable_data_.begin();
-                 it != ri->second.durable_data_.end(); ++it) {
-              pendingCallbacks.push_back(it->second);
-            }
-            ri->second.durable_data_.clear();
-            if (Transport_debug_level > 3) {
-              const GuidConverter gw(rw->first), gr(ri->first);
-              VDBG_LVL((LM_INFO, "(%P|%t) RtpsUdpDataLink::send_heartbeats - "
-                "removed expired durable data for %C -> %C\n",
-                OPENDDS_STRING(gw).c_str(), OPENDDS_STRING(gr).c_str()), 3);
-            }
-          } else {
-            has_durable_data = true;
-            if (ri->second.durable_data_.rbegin()->first > durable_max) {
-              durable_max = ri->second.durable_data_.rbegin()->first;
-            }
-            if (locators_.count(ri->first)) {
-              recipients.insert(locators_[ri->first].addr_);
-            }
-          }
-        }
+      const AdvertiseMap::iterator advertise = writers_to_advertise.find(rw->first);
+      if (advertise != writers_to_advertise.end()) {
+        final = false;
+        recipients.swap(advertise->second);
+        writers_to_advertise.erase(advertise);
       }
 
-      if (!rw->second.elems_not_acked_.empty()) {
+      if (!writer.elems_not_acked_.empty()) {
         final = false;
       }
 
-      if (writers_to_advertise.count(rw->first)) {
-        final = false;
-        writers_to_advertise.erase(rw->first);
+      // A writer with nothing new to announce and no reader needing
+      // attention is passed over without looking at its readers.
+      if (final && !has_data && !writer.readers_pending_) {
+        continue;
+      }
+
+      if (writer.readers_pending_) {
+        bool still_pending = false;
+        typedef ReaderInfoMap::iterator ri_iter;
+        const ri_iter end = writer.remote_readers_.end();
+        for (ri_iter ri = writer.remote_readers_.begin(); ri != end; ++ri) {
+          ACE_INET_Addr addr;
+          if (!ri->second.handshake_done_) {
+            still_pending = true;
+            if (find_locator(ri->first, addr)) {
+              recipients.insert(addr);
+              final = false;
+            }
+          }
+          if (!ri->second.durable_data_.empty()) {
+            const ACE_Time_Value expiration =
+              ri->second.durable_timestamp_ + config.durable_data_timeout_;
+            if (now > expiration) {
+              typedef OPENDDS_MAP(SequenceNumber, TransportQueueElement*)::iterator
+                dd_iter;
+              for (dd_iter it = ri->second.durable_data_.begin();
+                   it != ri->second.durable_data_.end(); ++it) {
+                pendingCallbacks.push_back(it->second);
+              }
+              ri->second.durable_data_.clear();
+              if (Transport_debug_level > 3) {
+                const GuidConverter gw(rw->first), gr(ri->first);
+                VDBG_LVL((LM_INFO, "(%P|%t) RtpsUdpDataLink::send_heartbeats - "
+                  "removed expired durable data for %C -> %C\n",
+                  OPENDDS_STRING(gw).c_str(), OPENDDS_STRING(gr).c_str()), 3);
+              }
+            } else {
+              still_pending = true;
+              has_durable_data = true;
+              if (ri->second.durable_data_.rbegin()->first > durable_max) {
+                durable_max = ri->second.durable_data_.rbegin()->first;
+              }
+              if (find_locator(ri->first, addr)) {
+                recipients.insert(addr);
+              }
+            }
+          }
+        }
+        writer.readers_pending_ = still_pending;
       }
 
       if (final && !has_data && !has_durable_data) {
         continue;
       }
 
-      const SequenceNumber firstSN = (rw->second.durable_ || !has_data)
-                                     ? 1 : rw->second.send_buff_->low(),
+      if (has_data || !writer.elems_not_acked_.empty()) {
+        const OPENDDS_VECTOR(ACE_INET_Addr)& addrs = reader_addrs(writer);
+        recipients.insert(addrs.begin(), addrs.end());
+      }
+
+      const SequenceNumber firstSN = (writer.durable_ || !has_data)
+                                     ? 1 : writer.send_buff_->low(),
           lastSN = std::max(durable_max,
-                            has_data ? rw->second.send_buff_->high() : 1);
+                            has_data ? writer.send_buff_->high() : 1);
 
       const HeartBeatSubmessage hb = {
         {HEARTBEAT,
@@ -2336,10 +2489,14 @@ RtpsUdpDataLink::send_heartbeats()
         {lastSN.getHigh(), lastSN.getLow()},
         {++heartbeat_counts_[rw->first]}
       };
+      for (OPENDDS_SET(ACE_INET_Addr)::const_iterator addr = recipients.begin();
+           addr != recipients.end(); ++addr) {
+        destinations[*addr].push_back(subm.size());
+      }
       subm.push_back(hb);
     }
 
-    for (RepoIdSet::const_iterator pos = writers_to_advertise.begin(),
+    for (AdvertiseMap::const_iterator pos = writers_to_advertise.begin(),
            limit = writers_to_advertise.end();
          pos != limit;
          ++pos) {
@@ -2349,29 +2506,58 @@ RtpsUdpDataLink::send_heartbeats()
          CORBA::Octet(1 /*FLAG_E*/),
          HEARTBEAT_SZ},
         ENTITYID_UNKNOWN, // any matched reader may be interested in this
-        pos->entityId,
+        pos->first.entityId,
         {SN.getHigh(), SN.getLow()},
         {SN.getHigh(), SN.getLow()},
-        {++heartbeat_counts_[*pos]}
+        {++heartbeat_counts_[pos->first]}
       };
+      for (OPENDDS_SET(ACE_INET_Addr)::const_iterator addr = pos->second.begin();
+           addr != pos->second.end(); ++addr) {
+        destinations[*addr].push_back(subm.size());
+      }
       subm.push_back(hb);
     }
 
-    if (!subm.empty()) {
-      ACE_Message_Block mb((HEARTBEAT_SZ + SMHDR_SZ) * subm.size()); //FUTURE: allocators?
+    if (!destinations.empty()) {
+      static const size_t HB_TOTAL = HEARTBEAT_SZ + SMHDR_SZ;
+      ACE_Message_Block mb(HB_TOTAL * subm.size()); //FUTURE: allocators?
       // byte swapping is handled in the operator<<() implementation
       Serializer ser(&mb, false, Serializer::ALIGN_CDR);
-      bool send_ok = true;
       for (size_t i = 0; i < subm.size(); ++i) {
         if (!(ser << subm[i])) {
           ACE_ERROR((LM_ERROR, "(%P|%t) RtpsUdpDataLink::send_heartbeats() - "
             "failed to serialize HEARTBEAT submessage %B\n", i));
-          send_ok = false;
+          destinations.clear();
           break;
         }
       }
-      if (send_ok) {
-        send_strategy()->send_rtps_control(mb, recipients);
+
+      // Destinations that need the same heartbeats share the datagrams.
+      typedef OPENDDS_MAP(HeartBeatIndexes, OPENDDS_SET(ACE_INET_Addr)) GroupMap;
+      GroupMap groups;
+      for (DestinationMap::iterator dest = destinations.begin();
+           dest != destinations.end(); ++dest) {
+        groups[dest->second].insert(dest->first);
+      }
+
+      const size_t max_hbs =
+        (RtpsUdpSendStrategy::max_datagram_size() - RTPSHDR_SZ) / HB_TOTAL;
+      for (GroupMap::const_iterator group = groups.begin();
+           group != groups.end(); ++group) {
+        const HeartBeatIndexes& indexes = group->first;
+        for (size_t first = 0; first < indexes.size(); first += max_hbs) {
+          const size_t count =
+            std::min(indexes.size() - first, max_hbs);
+          if (count == subm.size()) {
+            send_strategy()->send_rtps_control(mb, group->second);
+            continue;
+          }
+          ACE_Message_Block dgram(HB_TOTAL * count);
+          for (size_t i = first; i < first + count; ++i) {
+            dgram.copy(mb.base() + HB_TOTAL * indexes[i], HB_TOTAL);
+          }
+          send_strategy()->send_rtps_control(dgram, group->second);
+        }
       }
     }
   }
@@ -2395,7 +2581,7 @@ RtpsUdpDataLink::check_heartbeats()
   // Have any interesting writers timed out?
   const ACE_Time_Value tv = ACE_OS::gettimeofday() - 10 * this->config().heartbeat_period_;
   {
-      ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+      ACE_GUARD(ACE_Thread_Mutex, g, readers_lock_);
 
       for (InterestingRemoteMapType::iterator pos = interesting_writers_.begin(), limit = interesting_writers_.end();
            pos != limit;
@@ -2532,31 +2718,131 @@ RtpsUdpDataLink::RtpsWriter::add_elem_awaiting_ack(TransportQueueElement* elemen
   elems_not_acked_.insert(SnToTqeMap::value_type(element->sequence(), element));
 }
 
+RtpsUdpDataLink::ReaderInfo&
+RtpsUdpDataLink::RtpsWriter::add_reader(const RepoId& id)
+{
+  const std::pair<ReaderInfoMap::iterator, bool> result =
+    remote_readers_.insert(ReaderInfoMap::value_type(id, ReaderInfo()));
+  if (result.second) {
+    reader_acks_.add(id);
+  }
+  return result.first->second;
+}
+
+void
+RtpsUdpDataLink::RtpsWriter::remove_reader(const RepoId& id)
+{
+  remote_readers_.erase(id);
+  reader_acks_.remove(id);
+}
+
 
 // Implementing TimedDelay and HeartBeat nested classes (for ACE timers)
 
 void
 RtpsUdpDataLink::TimedDelay::schedule()
 {
-  if (!scheduled_) {
-    const long timer = outer_->get_reactor()->schedule_timer(this, 0, timeout_);
-
-    if (timer == -1) {
-      ACE_ERROR((LM_ERROR, "(%P|%t) RtpsUdpDataLink::TimedDelay::schedule "
-        "failed to schedule timer %p\n", ACE_TEXT("")));
-    } else {
-      scheduled_ = true;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    if (scheduled_) {
+      return;
     }
+    scheduled_ = true;
+  }
+
+  const long timer = outer_->get_reactor()->schedule_timer(this, 0, timeout_);
+
+  if (timer == -1) {
+    ACE_ERROR((LM_ERROR, "(%P|%t) RtpsUdpDataLink::TimedDelay::schedule "
+      "failed to schedule timer %p\n", ACE_TEXT("")));
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    scheduled_ = false;
   }
 }
 
 void
 RtpsUdpDataLink::TimedDelay::cancel()
 {
-  if (scheduled_) {
-    outer_->get_reactor()->cancel_timer(this);
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    if (!scheduled_) {
+      return;
+    }
     scheduled_ = false;
   }
+  outer_->get_reactor()->cancel_timer(this);
+}
+
+void
+RtpsUdpDataLink::schedule_bundles()
+{
+  bundle_timer_->schedule();
+}
+
+void
+RtpsUdpDataLink::BundleTimer::schedule()
+{
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    if (pending_) {
+      return;
+    }
+    pending_ = true;
+  }
+  ScheduleCommand c(this);
+  execute_or_enqueue(c);
+}
+
+void
+RtpsUdpDataLink::BundleTimer::schedule_i()
+{
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    if (!pending_) {
+      // Canceled before the reactor thread got to it.
+      return;
+    }
+  }
+
+  const long timer = outer_->get_reactor()->schedule_timer(
+    this, 0, outer_->config().bundle_delay_);
+
+  if (timer == -1) {
+    ACE_ERROR((LM_ERROR, "(%P|%t) RtpsUdpDataLink::BundleTimer::schedule_i"
+      " failed to schedule timer %p\n", ACE_TEXT("")));
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    pending_ = false;
+  }
+}
+
+void
+RtpsUdpDataLink::BundleTimer::cancel()
+{
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    if (!pending_) {
+      return;
+    }
+    pending_ = false;
+  }
+  outer_->get_reactor()->cancel_timer(this);
+}
+
+int
+RtpsUdpDataLink::BundleTimer::handle_timeout(const ACE_Time_Value&, const void*)
+{
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, 0);
+    pending_ = false;
+  }
+  outer_->send_bundles();
+  return 0;
+}
+
+void
+RtpsUdpDataLink::send_bundles()
+{
+  send_strategy()->send_bundles();
 }
 
 void
@@ -2588,7 +2874,7 @@ RtpsUdpDataLink::HeartBeat::disable()
 void
 RtpsUdpDataLink::send_final_acks (const RepoId& readerid)
 {
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+  ACE_GUARD(ACE_Thread_Mutex, g, readers_lock_);
   RtpsReaderMap::iterator rr = readers_.find (readerid);
   if (rr != readers_.end ()) {
     send_ack_nacks (rr, true);
@@ -2614,20 +2900,19 @@ void RtpsUdpDataLink::HeldDataDeliveryHandler::notify_delivery(const RepoId& rea
   ACE_ASSERT(link_->reactor_task_->get_reactor_owner() == ACE_Thread::self());
 
   const SequenceNumber ca = info.recvd_.cumulative_ack();
-  typedef OPENDDS_MAP(SequenceNumber, ReceivedDataSample)::iterator iter;
-  const iter end = info.held_.upper_bound(ca);
+  ReceivedDataSample sample(0);
 
-  for (iter it = info.held_.begin(); it != end; /*increment in loop body*/) {
+  while (info.held_.pop(ca, sample)) {
     if (Transport_debug_level > 5) {
       GuidConverter reader(readerId);
       ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) RtpsUdpDataLink::HeldDataDeliveryHandler::notify_delivery -")
                            ACE_TEXT(" deliver sequence: %q to %C\n"),
-                           it->second.header_.sequence_.getValue(),
+                           sample.header_.sequence_.getValue(),
                            OPENDDS_STRING(reader).c_str()));
     }
     // The head_data_ is not protected by a mutex because it is always accessed from the reactor task thread.
-    held_data_.push_back(HeldDataEntry(it->second, readerId));
-    info.held_.erase(it++);
+    held_data_.push_back(HeldDataEntry(ReceivedDataSample(0), readerId));
+    swap(held_data_.back().first, sample);
   }
   link_->reactor_task_->get_reactor()->notify(this);
 }
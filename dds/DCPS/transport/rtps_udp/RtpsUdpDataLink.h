@@ -14,6 +14,9 @@
 #include "RtpsUdpSendStrategy_rch.h"
 #include "RtpsUdpReceiveStrategy.h"
 #include "RtpsUdpReceiveStrategy_rch.h"
+#include "RtpsUdpShmem.h"
+#include "HeldSamples.h"
+#include "ReaderAcks.h"
 #include "RtpsCustomizedElement.h"
 
 #include "ace/Basic_Types.h"
@@ -69,7 +72,11 @@ public:
   ACE_SOCK_Dgram& unicast_socket();
   ACE_SOCK_Dgram_Mcast& multicast_socket();
 
-  bool open(const ACE_SOCK_Dgram& unicast_socket);
+  /// 'shmem_inbox', which may be null, is owned by the transport.
+  bool open(const ACE_SOCK_Dgram& unicast_socket,
+            RtpsShmemInbox* shmem_inbox);
+
+  RtpsShmemInbox* shmem_inbox() const { return shmem_inbox_; }
 
   void received(const RTPS::DataSubmessage& data,
                 const GuidPrefix_t& src_prefix);
@@ -101,6 +108,10 @@ public:
 
   ACE_INET_Addr get_locator(const RepoId& remote_id) const;
 
+  /// Send to 'address' through the shared-memory inbox advertised by
+  /// 'locator' of a peer on this host.
+  void add_shmem_peer(const ACE_INET_Addr& address, const Locator_t& locator);
+
   void associated(const RepoId& local, const RepoId& remote,
                   bool local_reliable, bool remote_reliable,
                   bool local_durable, bool remote_durable);
@@ -127,6 +138,11 @@ public:
 
   virtual void send_final_acks (const RepoId& readerid);
 
+  /// Called by the send strategy when it starts a bundle, after releasing
+  /// its bundle lock.  Sends the bundles once RtpsUdpInst::bundle_delay_
+  /// has passed.
+  void schedule_bundles();
+
 private:
   virtual void stop_i();
   virtual void send_i(TransportQueueElement* element, bool relink = true);
@@ -135,6 +151,13 @@ private:
   virtual TransportQueueElement* customize_queue_element(
     TransportQueueElement* element);
 
+  /// Produce the RTPS header for a data sample in either @a hdr or @a subm.
+  void marshal_data_sample(Message_Block_Ptr& hdr,
+                           RTPS::SubmessageSeq& subm,
+                           const ACE_Message_Block& msg,
+                           const DataSampleElement& dsle,
+                           const RepoId& pub_id);
+
   virtual void release_remote_i(const RepoId& remote_id);
   virtual void release_reservations_i(const RepoId& remote_id,
                                       const RepoId& local_id);
@@ -164,9 +187,13 @@ private:
     bool requires_inline_qos_;
   };
   OPENDDS_MAP_CMP(RepoId, RemoteInfo, GUID_tKeyLessThan) locators_;
+  /// Changed whenever locators_ gains or changes an address, so that
+  /// cached per-writer recipient lists can tell they are out of date.
+  size_t locators_version_;
 
   ACE_SOCK_Dgram unicast_socket_;
   ACE_SOCK_Dgram_Mcast multicast_socket_;
+  RtpsShmemInbox* shmem_inbox_;
 
   struct MultiSendBuffer : TransportSendBuffer {
 
@@ -189,9 +216,12 @@ private:
 
   struct ReaderInfo {
     CORBA::Long acknack_recvd_count_, nackfrag_recvd_count_;
-    OPENDDS_VECTOR(RTPS::SequenceNumberSet) requested_changes_;
+    /// Changes NACKed since the last send_nack_replies(), merged as the
+    /// ACKNACKs arrive.  nack_pending_ is set by any non-final ACKNACK,
+    /// even one that requests nothing.
+    DisjointSequence requested_changes_;
+    bool nack_pending_;
     OPENDDS_MAP(SequenceNumber, RTPS::FragmentNumberSet) requested_frags_;
-    SequenceNumber cur_cumulative_ack_;
     bool handshake_done_, durable_;
     OPENDDS_MAP(SequenceNumber, TransportQueueElement*) durable_data_;
     ACE_Time_Value durable_timestamp_;
@@ -199,6 +229,7 @@ private:
     ReaderInfo()
       : acknack_recvd_count_(0)
       , nackfrag_recvd_count_(0)
+      , nack_pending_(false)
       , handshake_done_(false)
       , durable_(false)
     {}
@@ -218,11 +249,27 @@ private:
     //Only accessed with RtpsUdpDataLink lock held
     SnToTqeMap to_deliver_;
     bool durable_;
-
-    RtpsWriter() : durable_(false) {}
+    /// Addresses of remote_readers_, used as heartbeat recipients.  Valid
+    /// while reader_addrs_version_ matches the link's locators_version_.
+    OPENDDS_VECTOR(ACE_INET_Addr) reader_addrs_;
+    size_t reader_addrs_version_;
+    /// Set while a remote reader may still have an incomplete handshake
+    /// or held durable data, which send_heartbeats() checks per reader.
+    bool readers_pending_;
+    /// Cumulative ack of each of remote_readers_, which add_reader() and
+    /// remove_reader() keep it in step with.
+    ReaderAcks reader_acks_;
+
+    RtpsWriter()
+      : durable_(false)
+      , reader_addrs_version_(0)
+      , readers_pending_(false)
+    {}
     ~RtpsWriter();
     SequenceNumber heartbeat_high(const ReaderInfo&) const;
     void add_elem_awaiting_ack(TransportQueueElement* element);
+    ReaderInfo& add_reader(const RepoId& id);
+    void remove_reader(const RepoId& id);
   };
 
   typedef OPENDDS_MAP_CMP(RepoId, RtpsWriter, GUID_tKeyLessThan) RtpsWriterMap;
@@ -237,7 +284,7 @@ private:
 
   struct WriterInfo {
     DisjointSequence recvd_;
-    OPENDDS_MAP(SequenceNumber, ReceivedDataSample) held_;
+    HeldSamples held_;
     SequenceRange hb_range_;
     OPENDDS_MAP(SequenceNumber, RTPS::FragmentNumber_t) frags_;
     bool ack_pending_, initial_hb_;
@@ -268,10 +315,33 @@ private:
 
   void deliver_held_data(const RepoId& readerId, WriterInfo& info, bool durable);
 
-  /// lock_ protects data structures accessed by both the transport's thread
-  /// (TransportReactorTask) and an external thread which is responsible
-  /// for adding/removing associations from the DataLink.
-  mutable ACE_Thread_Mutex lock_;
+  /// The following locks protect data structures accessed by both the
+  /// transport's thread (TransportReactorTask) and external threads which
+  /// send data or add/remove associations from the DataLink.  Either of
+  /// writers_lock_ and readers_lock_ may be held while acquiring
+  /// locators_lock_; the first two are never held together.
+  ///
+  /// writers_lock_ protects the local DataWriters' reliability state
+  /// (writers_, heartbeat_counts_, interesting_readers_) and is taken
+  /// before the RtpsUdpSendStrategy's locks when sending.
+  mutable ACE_Thread_Mutex writers_lock_;
+  /// readers_lock_ protects the local DataReaders' reliability state
+  /// (readers_, reader_index_, interesting_writers_, interesting_ack_nacks_).
+  mutable ACE_Thread_Mutex readers_lock_;
+  /// locators_lock_ protects locators_ and locators_version_.
+  mutable ACE_Thread_Mutex locators_lock_;
+
+  /// Selects writers_lock_ or readers_lock_ for a local entity.
+  ACE_Thread_Mutex& reliability_lock(EntityKind kind) const;
+
+  /// Looks up the address of remote_id without logging when it is missing.
+  bool find_locator(const RepoId& remote_id, ACE_INET_Addr& addr) const;
+  /// get_locator() with locators_lock_ already held.
+  ACE_INET_Addr get_locator_i(const RepoId& remote_id) const;
+
+  /// Stop using the shared-memory inbox at the address of 'remote_id' once
+  /// no remaining association has that address.
+  void release_shmem_peer(const RepoId& remote_id);
 
   size_t generate_nack_frags(OPENDDS_VECTOR(RTPS::NackFragSubmessage)& nack_frags,
                              WriterInfo& wi, const RepoId& pub_id);
@@ -321,7 +391,7 @@ private:
     src.entityId = submessage.writerId;
 
     bool schedule_timer = false;
-    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    ACE_GUARD(ACE_Thread_Mutex, g, readers_lock_);
     if (local.entityId == ENTITYID_UNKNOWN) {
       for (pair<RtpsReaderIndex::iterator, RtpsReaderIndex::iterator> iters =
              reader_index_.equal_range(src);
@@ -347,9 +417,11 @@ private:
   void send_nack_replies();
   void process_acked_by_all_i(ACE_Guard<ACE_Thread_Mutex>& g, const RepoId& pub_id);
   void send_heartbeats();
+  const OPENDDS_VECTOR(ACE_INET_Addr)& reader_addrs(RtpsWriter& writer);
   void check_heartbeats();
   void send_heartbeats_manual(const TransportSendControlElement* tsce);
   void send_heartbeat_replies();
+  void send_bundles();
 
   CORBA::Long best_effort_heartbeat_count_;
 
@@ -367,7 +439,10 @@ private:
 
     int handle_timeout(const ACE_Time_Value&, const void*)
     {
-      scheduled_ = false;
+      {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, 0);
+        scheduled_ = false;
+      }
       (outer_->*function_)();
       return 0;
     }
@@ -376,6 +451,8 @@ private:
     PMF function_;
     ACE_Time_Value timeout_;
     bool scheduled_;
+    /// Protects scheduled_, never held while calling into the reactor.
+    ACE_Thread_Mutex lock_;
 
   } nack_reply_, heartbeat_reply_;
 
@@ -428,6 +505,52 @@ private:
 
   RcHandle<HeartBeat> heartbeat_, heartbeatchecker_;
 
+  /// Sends the send strategy's bundles once bundle_delay_ has passed.  A
+  /// bundle is started by threads that may hold writers_lock_, which the
+  /// reactor thread takes while holding the reactor's token, so the timer
+  /// is only scheduled from the reactor thread.
+  struct BundleTimer : ReactorInterceptor {
+
+    BundleTimer(ACE_Reactor* reactor, ACE_thread_t owner, RtpsUdpDataLink* outer)
+      : ReactorInterceptor(reactor, owner)
+      , outer_(outer)
+      , pending_(false) {}
+
+    void schedule();
+    void cancel();
+
+    int handle_timeout(const ACE_Time_Value&, const void*);
+
+    bool reactor_is_shut_down() const
+    {
+      return outer_->reactor_is_shut_down();
+    }
+
+    void schedule_i();
+
+    RtpsUdpDataLink* outer_;
+    /// Set by schedule() until the timer fires or is canceled.
+    bool pending_;
+    /// Protects pending_, never held while calling into the reactor.
+    ACE_Thread_Mutex lock_;
+
+    struct ScheduleCommand : public Command {
+      ScheduleCommand(BundleTimer* timer)
+        : timer_(timer)
+      { }
+
+      virtual void execute()
+      {
+        timer_->schedule_i();
+      }
+
+      BundleTimer* timer_;
+    };
+
+  };
+
+  RcHandle<BundleTimer> bundle_timer_;
+
   /// Data structure representing an "interesting" remote entity for static discovery.
   struct InterestingRemote {
     /// id of local entity that is interested in this remote.
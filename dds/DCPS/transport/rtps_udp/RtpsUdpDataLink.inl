@@ -41,8 +41,10 @@ RtpsUdpDataLink::multicast_socket()
 ACE_INLINE void
 RtpsUdpDataLink::release_remote_i(const RepoId& remote_id)
 {
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
-  locators_.erase(remote_id);
+  ACE_GUARD(ACE_Thread_Mutex, g, locators_lock_);
+  if (locators_.erase(remote_id)) {
+    ++locators_version_;
+  }
 }
 
 } // namespace DCPS
@@ -11,6 +11,7 @@
 
 #include "dds/DCPS/transport/framework/TransportDefs.h"
 #include "ace/Configuration.h"
+#include "dds/DCPS/RTPS/BaseMessageTypes.h"
 #include "dds/DCPS/RTPS/BaseMessageUtils.h"
 #include "dds/DCPS/transport/framework/NetworkAddress.h"
 #include "dds/DCPS/Service_Participant.h"
@@ -35,12 +36,18 @@ RtpsUdpInst::RtpsUdpInst(const OPENDDS_STRING& name)
   , ttl_(1)
   , multicast_group_address_(7401, "239.255.0.2")
   , nak_depth_(32) // default nak_depth in OpenDDS_Multicast
+  , held_data_depth_(256)
   , nak_response_delay_(0, 200*1000 /*microseconds*/) // default from RTPS
   , heartbeat_period_(1) // no default in RTPS spec
   , heartbeat_response_delay_(0, 500*1000 /*microseconds*/) // default from RTPS
   , handshake_timeout_(30) // default syn_timeout in OpenDDS_Multicast
   , durable_data_timeout_(60)
+  , bundle_delay_(0)
+  , max_bundle_size_(1472) // UDP payload of a 1500 byte Ethernet frame
+  , use_shmem_(false)
+  , shmem_pool_size_(16 * 1024 * 1024)
   , opendds_discovery_guid_(GUID_UNKNOWN)
+  , shmem_locator_(RTPS::LOCATOR_INVALID)
 {
 }
 
@@ -86,6 +93,8 @@ RtpsUdpInst::load(ACE_Configuration_Heap& cf,
 
   GET_CONFIG_VALUE(cf, sect, ACE_TEXT("nak_depth"), nak_depth_, size_t);
 
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("held_data_depth"), held_data_depth_, size_t);
+
   GET_CONFIG_VALUE(cf, sect, ACE_TEXT("ttl"), ttl_, unsigned char);
 
   GET_CONFIG_TIME_VALUE(cf, sect, ACE_TEXT("nak_response_delay"),
@@ -96,6 +105,11 @@ RtpsUdpInst::load(ACE_Configuration_Heap& cf,
                         heartbeat_response_delay_);
   GET_CONFIG_TIME_VALUE(cf, sect, ACE_TEXT("handshake_timeout"),
                         handshake_timeout_);
+  GET_CONFIG_TIME_VALUE(cf, sect, ACE_TEXT("bundle_delay"),
+                        bundle_delay_);
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("max_bundle_size"), max_bundle_size_, size_t);
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("use_shmem"), use_shmem_, bool);
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("shmem_pool_size"), shmem_pool_size_, size_t);
   return 0;
 }
 
@@ -129,10 +143,15 @@ RtpsUdpInst::dump_to_str() const
       + ':' + to_dds_string(multicast_group_address_.get_port_number()) + '\n';
   ret += formatNameForDump("multicast_interface") + multicast_interface_ + '\n';
   ret += formatNameForDump("nak_depth") + to_dds_string(unsigned(nak_depth_)) + '\n';
+  ret += formatNameForDump("held_data_depth") + to_dds_string(unsigned(held_data_depth_)) + '\n';
   ret += formatNameForDump("nak_response_delay") + to_dds_string(nak_response_delay_.msec()) + '\n';
   ret += formatNameForDump("heartbeat_period") + to_dds_string(heartbeat_period_.msec()) + '\n';
   ret += formatNameForDump("heartbeat_response_delay") + to_dds_string(heartbeat_response_delay_.msec()) + '\n';
   ret += formatNameForDump("handshake_timeout") + to_dds_string(handshake_timeout_.msec()) + '\n';
+  ret += formatNameForDump("bundle_delay") + to_dds_string(bundle_delay_.msec()) + '\n';
+  ret += formatNameForDump("max_bundle_size") + to_dds_string(unsigned(max_bundle_size_)) + '\n';
+  ret += formatNameForDump("use_shmem") + (use_shmem_ ? "true" : "false") + '\n';
+  ret += formatNameForDump("shmem_pool_size") + to_dds_string(unsigned(shmem_pool_size_)) + '\n';
   return ret;
 }
 
@@ -181,6 +200,13 @@ RtpsUdpInst::populate_locator(OpenDDS::DCPS::TransportLocator& info) const
                            this->local_address());
   }
 
+  // last, so that peers on other hosts never prefer it
+  if (shmem_locator_.kind == LOCATOR_KIND_SHMEM) {
+    idx = locators.length();
+    locators.length(idx + 1);
+    locators[idx] = shmem_locator_;
+  }
+
   info.transport_type = "rtps_udp";
   RTPS::locators_to_blob(locators, info.data);
 
@@ -12,6 +12,7 @@
 
 #include "dds/DCPS/transport/framework/TransportInst.h"
 #include "dds/DCPS/SafetyProfileStreams.h"
+#include "dds/DdsDcpsInfoUtilsC.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -36,9 +37,25 @@ public:
   OPENDDS_STRING multicast_interface_;
 
   size_t nak_depth_;
+  /// Most out-of-order samples per remote writer kept in a ring indexed
+  /// by sequence number, further samples are held in a map.  The ring
+  /// only grows as far as a gap requires and is released once it drains.
+  size_t held_data_depth_;
   ACE_Time_Value nak_response_delay_, heartbeat_period_,
     heartbeat_response_delay_, handshake_timeout_, durable_data_timeout_;
 
+  /// RTPS messages of at most max_bundle_size_ bytes are held for up to
+  /// bundle_delay_ and sent together with other messages to the same
+  /// address.  A zero bundle_delay_ (the default) sends them at once.
+  ACE_Time_Value bundle_delay_;
+  size_t max_bundle_size_;
+
+  /// RTPS messages for rtps_udp peers in other processes on this host
+  /// are passed through a shared-memory pool of shmem_pool_size_ bytes
+  /// instead of the loopback network.  Off by default.
+  bool use_shmem_;
+  size_t shmem_pool_size_;
+
   virtual int load(ACE_Configuration_Heap& cf,
                    ACE_Configuration_Section_Key& sect);
 
@@ -84,6 +101,9 @@ private:
 
   ACE_INET_Addr local_address_;
   OPENDDS_STRING local_address_config_str_;
+
+  /// Set by RtpsUdpTransport once its shared-memory inbox is open.
+  Locator_t shmem_locator_;
 };
 
 } // namespace DCPS
@@ -8,6 +8,7 @@
 #include "RtpsUdpReceiveStrategy.h"
 #include "RtpsUdpDataLink.h"
 #include "RtpsUdpInst.h"
+#include "RtpsUdpShmem.h"
 #include "RtpsUdpTransport.h"
 
 #include "dds/DCPS/RTPS/BaseMessageTypes.h"
@@ -22,7 +23,8 @@ namespace OpenDDS {
 namespace DCPS {
 
 RtpsUdpReceiveStrategy::RtpsUdpReceiveStrategy(RtpsUdpDataLink* link, const GuidPrefix_t& local_prefix)
-  : link_(link)
+  : TransportReceiveStrategy<RtpsTransportHeader, RtpsSampleHeader>(link->impl().config())
+  , link_(link)
   , last_received_()
   , recvd_sample_(0)
   , receiver_(local_prefix)
@@ -32,6 +34,15 @@ RtpsUdpReceiveStrategy::RtpsUdpReceiveStrategy(RtpsUdpDataLink* link, const Guid
 int
 RtpsUdpReceiveStrategy::handle_input(ACE_HANDLE fd)
 {
+  if (fd == ACE_INVALID_HANDLE) {
+    // Notified by the shared-memory inbox.  A -1 from a notification
+    // would close this handler, so errors are only logged.
+    RtpsShmemInbox* const inbox = link_->shmem_inbox();
+    while (inbox && inbox->readable()) {
+      handle_dds_input(fd);
+    }
+    return 0;
+  }
   return handle_dds_input(fd);
 }
 
@@ -41,6 +52,12 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
                                       ACE_INET_Addr& remote_address,
                                       ACE_HANDLE fd)
 {
+  if (fd == ACE_INVALID_HANDLE) {
+    const ssize_t ret = link_->shmem_inbox()->read(iov, n, remote_address);
+    remote_address_ = remote_address;
+    return ret;
+  }
+
   const ACE_SOCK_Dgram& socket =
     (fd == link_->unicast_socket().get_handle())
     ? link_->unicast_socket() : link_->multicast_socket();
@@ -236,6 +253,15 @@ RtpsUdpReceiveStrategy::start_i()
     }
   }
 
+  RtpsShmemInbox* const inbox = link_->shmem_inbox();
+  if (inbox && !inbox->start(reactor, this)) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: ")
+                      ACE_TEXT("RtpsUdpReceiveStrategy::start_i: ")
+                      ACE_TEXT("failed to start the shared-memory inbox\n")),
+                     -1);
+  }
+
   return 0;
 }
 
@@ -258,6 +284,11 @@ RtpsUdpReceiveStrategy::stop_i()
     reactor->remove_handler(link_->multicast_socket().get_handle(),
                             ACE_Event_Handler::READ_MASK);
   }
+
+  RtpsShmemInbox* const inbox = link_->shmem_inbox();
+  if (inbox) {
+    inbox->stop();
+  }
 }
 
 bool
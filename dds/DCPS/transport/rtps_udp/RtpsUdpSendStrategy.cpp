@@ -18,6 +18,7 @@
 
 #include "dds/DCPS/Serializer.h"
 
+#include <algorithm>
 #include <cstring>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -25,6 +26,17 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+namespace {
+  size_t max_bundle_size(const RtpsUdpInst& config)
+  {
+    if (config.bundle_delay_ == ACE_Time_Value::zero) {
+      return 0;
+    }
+    return (std::min)(config.max_bundle_size_,
+                      RtpsUdpSendStrategy::max_datagram_size());
+  }
+}
+
 RtpsUdpSendStrategy::RtpsUdpSendStrategy(RtpsUdpDataLink* link,
                                          const GuidPrefix_t& local_prefix)
   : TransportSendStrategy(0, link->impl(),
@@ -36,7 +48,13 @@ RtpsUdpSendStrategy::RtpsUdpSendStrategy(RtpsUdpDataLink* link,
     override_single_dest_(0),
     rtps_header_db_(RTPS::RTPSHDR_SZ, ACE_Message_Block::MB_DATA,
                     rtps_header_data_, 0, 0, ACE_Message_Block::DONT_DELETE, 0),
-    rtps_header_mb_(&rtps_header_db_, ACE_Message_Block::DONT_DELETE)
+    rtps_header_mb_(&rtps_header_db_, ACE_Message_Block::DONT_DELETE),
+    bundler_(*this, rtps_header_data_, max_bundle_size(link->config())),
+    use_shmem_(link->config().use_shmem_),
+    local_port_(link->config().local_address().get_port_number())
+#ifdef OPENDDS_RTPS_UDP_SENDMMSG
+    , mmsg_unsupported_(false)
+#endif
 {
   rtps_header_.prefix[0] = 'R';
   rtps_header_.prefix[1] = 'T';
@@ -123,44 +141,63 @@ void
 RtpsUdpSendStrategy::send_rtps_control(ACE_Message_Block& submessages,
                                        const ACE_INET_Addr& addr)
 {
-  rtps_header_mb_.cont(&submessages);
-
-  iovec iov[MAX_SEND_BLOCKS];
-  const int num_blocks = mb_to_iov(rtps_header_mb_, iov);
+  iovec iov[MAX_SEND_BLOCKS + 1];
+  const int num_blocks = control_to_iov(submessages, iov);
   const ssize_t result = send_single_i(iov, num_blocks, addr);
   if (result < 0) {
     ACE_ERROR((LM_ERROR, "(%P|%t) RtpsUdpSendStrategy::send_rtps_control() - "
       "failed to send RTPS control message\n"));
   }
-
-  rtps_header_mb_.cont(0);
 }
 
 void
 RtpsUdpSendStrategy::send_rtps_control(ACE_Message_Block& submessages,
                                        const OPENDDS_SET(ACE_INET_Addr)& addrs)
 {
-  rtps_header_mb_.cont(&submessages);
-
-  iovec iov[MAX_SEND_BLOCKS];
-  const int num_blocks = mb_to_iov(rtps_header_mb_, iov);
+  iovec iov[MAX_SEND_BLOCKS + 1];
+  const int num_blocks = control_to_iov(submessages, iov);
   const ssize_t result = send_multi_i(iov, num_blocks, addrs);
   if (result < 0) {
     ACE_ERROR((LM_ERROR, "(%P|%t) RtpsUdpSendStrategy::send_rtps_control() - "
       "failed to send RTPS control message\n"));
   }
+}
 
-  rtps_header_mb_.cont(0);
+int
+RtpsUdpSendStrategy::control_to_iov(const ACE_Message_Block& submessages,
+                                    iovec iov[])
+{
+  // The RTPS header doesn't change after construction, so it is shared
+  // by control messages sent concurrently from the writer and reader
+  // sides of the link.
+  iov[0].iov_base = rtps_header_data_;
+  iov[0].iov_len = RTPS::RTPSHDR_SZ;
+  return 1 + mb_to_iov(submessages, iov + 1);
 }
 
 ssize_t
 RtpsUdpSendStrategy::send_multi_i(const iovec iov[], int n,
                                   const OPENDDS_SET(ACE_INET_Addr)& addrs)
 {
+  if (bundler_.max_size() && add_to_bundles(iov, n, addrs)) {
+    return static_cast<ssize_t>(iov_size(iov, n));
+  }
+  return send_datagrams_i(iov, n, addrs);
+}
+
+ssize_t
+RtpsUdpSendStrategy::send_datagrams_i(const iovec iov[], int n,
+                                      const OPENDDS_SET(ACE_INET_Addr)& addrs)
+{
+#ifdef OPENDDS_RTPS_UDP_SENDMMSG
+  if (addrs.size() > 1 && !mmsg_unsupported_.value()) {
+    return send_mmsg_i(iov, n, addrs);
+  }
+#endif
   ssize_t result = -1;
   typedef OPENDDS_SET(ACE_INET_Addr)::const_iterator iter_t;
   for (iter_t iter = addrs.begin(); iter != addrs.end(); ++iter) {
-    const ssize_t result_per_dest = send_single_i(iov, n, *iter);
+    const ssize_t result_per_dest = send_datagram_i(iov, n, *iter);
     if (result_per_dest >= 0) {
       result = result_per_dest;
     }
@@ -168,23 +205,99 @@ RtpsUdpSendStrategy::send_multi_i(const iovec iov[], int n,
   return result;
 }
 
+#ifdef OPENDDS_RTPS_UDP_SENDMMSG
+ssize_t
+RtpsUdpSendStrategy::send_mmsg_i(const iovec iov[], int n,
+                                 const OPENDDS_SET(ACE_INET_Addr)& addrs)
+{
+  static const unsigned int BATCH = 64;
+  mmsghdr msgs[BATCH];
+  const ACE_INET_Addr* dests[BATCH];
+  const ACE_HANDLE handle = link_->unicast_socket().get_handle();
+  ssize_t result = -1;
+
+  typedef OPENDDS_SET(ACE_INET_Addr)::const_iterator iter_t;
+  iter_t iter = addrs.begin();
+  while (iter != addrs.end()) {
+    unsigned int count = 0;
+    for (; iter != addrs.end() && count < BATCH; ++iter) {
+      if (send_shmem_i(iov, n, *iter)) {
+        result = static_cast<ssize_t>(iov_size(iov, n));
+        continue;
+      }
+      std::memset(&msgs[count], 0, sizeof msgs[count]);
+      msghdr& hdr = msgs[count].msg_hdr;
+      hdr.msg_name = iter->get_addr();
+      hdr.msg_namelen = iter->get_size();
+      hdr.msg_iov = const_cast<iovec*>(iov);
+      hdr.msg_iovlen = n;
+      dests[count++] = &*iter;
+    }
+
+    unsigned int sent = 0;
+    while (sent < count) {
+      int result_mmsg = -1;
+      if (!mmsg_unsupported_.value()) {
+        result_mmsg = ::sendmmsg(handle, msgs + sent, count - sent, 0);
+        if (result_mmsg < 0 && errno == ENOSYS) {
+          mmsg_unsupported_ = true;
+        }
+      }
+      if (result_mmsg > 0) {
+        sent += result_mmsg;
+        result = msgs[sent - 1].msg_len;
+      } else {
+        // The first remaining destination failed, or the kernel lacks
+        // sendmmsg(): send to it on its own, which reports any error,
+        // and carry on with the rest.
+        const ssize_t result_per_dest = send_datagram_i(iov, n, *dests[sent++]);
+        if (result_per_dest >= 0) {
+          result = result_per_dest;
+        }
+      }
+    }
+  }
+  return result;
+}
+#endif
+
 ssize_t
 RtpsUdpSendStrategy::send_single_i(const iovec iov[], int n,
                                    const ACE_INET_Addr& addr)
 {
+  if (bundler_.max_size() && add_to_bundle(iov, n, addr)) {
+    return static_cast<ssize_t>(iov_size(iov, n));
+  }
+  return send_datagram_i(iov, n, addr);
+}
+
+ssize_t
+RtpsUdpSendStrategy::send_datagram_i(const iovec iov[], int n,
+                                     const ACE_INET_Addr& addr)
+{
+  if (send_shmem_i(iov, n, addr)) {
+    return static_cast<ssize_t>(iov_size(iov, n));
+  }
+
 #ifdef ACE_LACKS_SENDMSG
-  char buffer[UDP_MAX_MESSAGE_SIZE];
-  char *iter = buffer;
-  for (int i = 0; i < n; ++i) {
-    if (size_t(iter - buffer + iov[i].iov_len) > UDP_MAX_MESSAGE_SIZE) {
-      ACE_ERROR((LM_ERROR, "(%P|%t) RtpsUdpSendStrategy::send_single_i() - "
-                 "message too large at index %d size %d\n", i, iov[i].iov_len));
-      return -1;
+  ssize_t result;
+  if (n == 1) {
+    // Nothing to gather, so there is no need to stage a copy.
+    result = link_->unicast_socket().send(iov[0].iov_base, iov[0].iov_len, addr);
+  } else {
+    char buffer[UDP_MAX_MESSAGE_SIZE];
+    char *iter = buffer;
+    for (int i = 0; i < n; ++i) {
+      if (size_t(iter - buffer + iov[i].iov_len) > UDP_MAX_MESSAGE_SIZE) {
+        ACE_ERROR((LM_ERROR, "(%P|%t) RtpsUdpSendStrategy::send_datagram_i() - "
+                   "message too large at index %d size %d\n", i, iov[i].iov_len));
+        return -1;
+      }
+      std::memcpy(iter, iov[i].iov_base, iov[i].iov_len);
+      iter += iov[i].iov_len;
     }
-    std::memcpy(iter, iov[i].iov_base, iov[i].iov_len);
-    iter += iov[i].iov_len;
+    result = link_->unicast_socket().send(buffer, iter - buffer, addr);
   }
-  const ssize_t result = link_->unicast_socket().send(buffer, iter - buffer, addr);
 #else
   const ssize_t result = link_->unicast_socket().send(iov, n, addr);
 #endif
@@ -193,12 +306,76 @@ RtpsUdpSendStrategy::send_single_i(const iovec iov[], int n,
     int err = errno;
     addr.addr_to_string(addr_buff, 256, 0);
     errno = err;
-    ACE_ERROR((LM_ERROR, "(%P|%t) RtpsUdpSendStrategy::send_single_i() - "
+    ACE_ERROR((LM_ERROR, "(%P|%t) RtpsUdpSendStrategy::send_datagram_i() - "
       "destination %s failed %p\n", addr_buff, ACE_TEXT("send")));
   }
   return result;
 }
 
+bool
+RtpsUdpSendStrategy::send_shmem_i(const iovec iov[], int n,
+                                  const ACE_INET_Addr& addr)
+{
+  if (!use_shmem_) {
+    return false;
+  }
+  RtpsShmemOutbox_rch outbox;
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, shmem_lock_, false);
+    const ShmemPeerMap::const_iterator iter = shmem_peers_.find(addr);
+    if (iter == shmem_peers_.end()) {
+      return false;
+    }
+    outbox = iter->second;
+  }
+  // A full or closed inbox leaves the datagram to UDP.
+  return outbox->send(iov, n, local_port_);
+}
+
+void
+RtpsUdpSendStrategy::add_shmem_peer(const ACE_INET_Addr& addr,
+                                    const Locator_t& locator)
+{
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, shmem_lock_);
+    const ShmemPeerMap::const_iterator iter = shmem_peers_.find(addr);
+    if (iter != shmem_peers_.end()) {
+      const Locator_t& current = iter->second->locator();
+      if (current.port == locator.port &&
+          std::memcmp(current.address, locator.address,
+                      sizeof locator.address) == 0) {
+        return;
+      }
+    }
+  }
+
+  // Attaching to the peer's pool may take a while, so it's done unlocked.
+  const RtpsShmemOutbox_rch outbox = make_rch<RtpsShmemOutbox>(locator);
+  ACE_GUARD(ACE_Thread_Mutex, g, shmem_lock_);
+  if (outbox->is_open()) {
+    shmem_peers_[addr] = outbox;
+  } else {
+    shmem_peers_.erase(addr);
+  }
+}
+
+void
+RtpsUdpSendStrategy::remove_shmem_peer(const ACE_INET_Addr& addr)
+{
+  RtpsShmemOutbox_rch outbox;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, shmem_lock_);
+    const ShmemPeerMap::iterator iter = shmem_peers_.find(addr);
+    if (iter == shmem_peers_.end()) {
+      return;
+    }
+    outbox = iter->second;
+    shmem_peers_.erase(iter);
+  }
+  // A send in progress may still hold the outbox, the last reference
+  // detaches from the pool outside of shmem_lock_.
+}
+
 void
 RtpsUdpSendStrategy::add_delayed_notification(TransportQueueElement* element)
 {
@@ -218,6 +395,77 @@ RtpsUdpSendStrategy::do_remove_sample(const RepoId& pub_id,
   return TransportSendStrategy::do_remove_sample(pub_id, criteria, 0);
 }
 
+size_t
+RtpsUdpSendStrategy::iov_size(const iovec iov[], int n)
+{
+  size_t size = 0;
+  for (int i = 0; i < n; ++i) {
+    size += iov[i].iov_len;
+  }
+  return size;
+}
+
+bool
+RtpsUdpSendStrategy::add_to_bundles(const iovec iov[], int n,
+                                    const OPENDDS_SET(ACE_INET_Addr)& addrs)
+{
+  typedef OPENDDS_SET(ACE_INET_Addr)::const_iterator iter_t;
+  const size_t size = iov_size(iov, n);
+  const bool fits = size <= bundler_.max_size();
+  bool started = false;
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, bundle_lock_, false);
+    for (iter_t iter = addrs.begin(); iter != addrs.end(); ++iter) {
+      if (fits) {
+        started = bundler_.add(iov, n, size, *iter) || started;
+      } else {
+        bundler_.send(*iter);
+      }
+    }
+  }
+  // The timer's send_bundles() takes bundle_lock_, so the timer is only
+  // scheduled after it was released.
+  if (started) {
+    link_->schedule_bundles();
+  }
+  return fits;
+}
+
+bool
+RtpsUdpSendStrategy::add_to_bundle(const iovec iov[], int n,
+                                   const ACE_INET_Addr& addr)
+{
+  const size_t size = iov_size(iov, n);
+  const bool fits = size <= bundler_.max_size();
+  bool started = false;
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, bundle_lock_, false);
+    if (fits) {
+      started = bundler_.add(iov, n, size, addr);
+    } else {
+      bundler_.send(addr);
+    }
+  }
+  if (started) {
+    link_->schedule_bundles();
+  }
+  return fits;
+}
+
+void
+RtpsUdpSendStrategy::send_bundle(const iovec iov[], int n,
+                                 const ACE_INET_Addr& addr)
+{
+  send_datagram_i(iov, n, addr);
+}
+
+void
+RtpsUdpSendStrategy::send_bundles()
+{
+  ACE_GUARD(ACE_Thread_Mutex, g, bundle_lock_);
+  bundler_.send_all();
+}
+
 void
 RtpsUdpSendStrategy::stop_i()
 {
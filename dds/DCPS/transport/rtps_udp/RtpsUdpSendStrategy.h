@@ -9,12 +9,27 @@
 #define DCPS_RTPSUDPSENDSTRATEGY_H
 
 #include "Rtps_Udp_Export.h"
+#include "RtpsUdpShmem.h"
+#include "RtpsBundler.h"
 
 #include "dds/DCPS/transport/framework/TransportSendStrategy.h"
 
 #include "dds/DCPS/RTPS/MessageTypes.h"
 
+#include "dds/DCPS/PoolAllocator.h"
+
 #include "ace/INET_Addr.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_sys_socket.h"
+
+#if defined ACE_LINUX && defined __GLIBC__ \
+  && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)) \
+  && !defined OPENDDS_RTPS_UDP_NO_SENDMMSG
+// sendmmsg() hands one datagram to several destinations per system call,
+// glibc has it since 2.14 (older versions already define MSG_WAITFORONE).
+// Define OPENDDS_RTPS_UDP_NO_SENDMMSG to send them one at a time.
+#define OPENDDS_RTPS_UDP_SENDMMSG
+#endif
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -26,7 +41,8 @@ class RtpsUdpInst;
 typedef RcHandle<RtpsUdpDataLink> RtpsUdpDataLink_rch;
 
 class OpenDDS_Rtps_Udp_Export RtpsUdpSendStrategy
-  : public TransportSendStrategy {
+  : public TransportSendStrategy
+  , private RtpsBundler::Sender {
 public:
   RtpsUdpSendStrategy(RtpsUdpDataLink* link,
                       const GuidPrefix_t& local_prefix);
@@ -49,6 +65,19 @@ public:
   void send_rtps_control(ACE_Message_Block& submessages,
                          const OPENDDS_SET(ACE_INET_Addr)& destinations);
 
+  /// Largest RTPS message, header included, sent in a single datagram.
+  static size_t max_datagram_size() { return UDP_MAX_MESSAGE_SIZE; }
+
+  /// Send the messages held back for bundling (see
+  /// RtpsUdpInst::bundle_delay_).
+  void send_bundles();
+
+  /// Send datagrams for 'addr' to the shared-memory inbox at 'locator'.
+  void add_shmem_peer(const ACE_INET_Addr& addr, const Locator_t& locator);
+
+  /// Send datagrams for 'addr' over UDP again, detaching from its inbox.
+  void remove_shmem_peer(const ACE_INET_Addr& addr);
+
 protected:
   virtual ssize_t send_bytes_i(const iovec iov[], int n);
 
@@ -63,11 +92,35 @@ protected:
 
 private:
   bool marshal_transport_header(ACE_Message_Block* mb);
+  /// Fills iov, which has room for MAX_SEND_BLOCKS + 1 entries, with
+  /// the RTPS header followed by submessages.
+  int control_to_iov(const ACE_Message_Block& submessages, iovec iov[]);
+  /// Send one RTPS message, or add it to the bundles for its
+  /// destinations when it is small enough.
   ssize_t send_multi_i(const iovec iov[], int n,
                        const OPENDDS_SET(ACE_INET_Addr)& addrs);
   ssize_t send_single_i(const iovec iov[], int n,
                         const ACE_INET_Addr& addr);
 
+  ssize_t send_datagrams_i(const iovec iov[], int n,
+                           const OPENDDS_SET(ACE_INET_Addr)& addrs);
+  ssize_t send_datagram_i(const iovec iov[], int n,
+                          const ACE_INET_Addr& addr);
+  /// Returns false if 'addr' is not reached through shared memory.
+  bool send_shmem_i(const iovec iov[], int n, const ACE_INET_Addr& addr);
+#ifdef OPENDDS_RTPS_UDP_SENDMMSG
+  ssize_t send_mmsg_i(const iovec iov[], int n,
+                      const OPENDDS_SET(ACE_INET_Addr)& addrs);
+#endif
+
+  static size_t iov_size(const iovec iov[], int n);
+  /// Returns false if the message is too large to bundle, after sending
+  /// the bundles for its destinations to keep the order per destination.
+  bool add_to_bundles(const iovec iov[], int n,
+                      const OPENDDS_SET(ACE_INET_Addr)& addrs);
+  bool add_to_bundle(const iovec iov[], int n, const ACE_INET_Addr& addr);
+  void send_bundle(const iovec iov[], int n, const ACE_INET_Addr& addr);
+
   RtpsUdpDataLink* link_;
   const OPENDDS_SET(ACE_INET_Addr)* override_dest_;
   const ACE_INET_Addr* override_single_dest_;
@@ -76,6 +129,27 @@ private:
   char rtps_header_data_[RTPS::RTPSHDR_SZ];
   ACE_Data_Block rtps_header_db_;
   ACE_Message_Block rtps_header_mb_;
+
+  /// Collects small messages until the link's bundle timer sends them,
+  /// its max_size() is zero if bundling is disabled.
+  RtpsBundler bundler_;
+  /// Protects bundler_.  Taken after the RtpsUdpDataLink's locks, and
+  /// never held while calling into the reactor.
+  ACE_Thread_Mutex bundle_lock_;
+
+  /// RtpsUdpInst::use_shmem_
+  const bool use_shmem_;
+  /// Our unicast port, reported to the receivers of shared-memory datagrams.
+  const u_short local_port_;
+  typedef OPENDDS_MAP(ACE_INET_Addr, RtpsShmemOutbox_rch) ShmemPeerMap;
+  ShmemPeerMap shmem_peers_;
+  /// Protects shmem_peers_, never held while sending.
+  ACE_Thread_Mutex shmem_lock_;
+
+#ifdef OPENDDS_RTPS_UDP_SENDMMSG
+  /// Set once sendmmsg() failed with ENOSYS, the kernel doesn't have it.
+  ACE_Atomic_Op<ACE_Thread_Mutex, bool> mmsg_unsupported_;
+#endif
 };
 
 } // namespace DCPS
@@ -0,0 +1,502 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "RtpsUdpShmem.h"
+
+#include "dds/DCPS/RTPS/RtpsCoreC.h"
+#include "dds/DCPS/SafetyProfileStreams.h"
+#include "dds/DCPS/transport/framework/TransportDebug.h"
+
+#include "ace/ACE.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_sys_shm.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Reactor.h"
+#include "ace/os_include/os_netdb.h"
+
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+#include "ace/Based_Pointer_T.h"
+#include <semaphore.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+/// One RTPS message in an inbox, the message follows the struct.
+struct RtpsShmemDatagram {
+  ACE_Based_Pointer_Basic<RtpsShmemDatagram> next_;
+  size_t size_;
+  u_short source_port_;
+
+  char* data() { return reinterpret_cast<char*>(this + 1); }
+};
+
+/// Bound as "Inbox" in the pool.  head_, tail_ and closed_ are protected
+/// by the allocator's process mutex, which is also held while posting to
+/// or destroying the semaphore so no one posts once it is closed.
+struct RtpsShmemControl {
+  sem_t semaphore_;
+  ACE_Based_Pointer_Basic<RtpsShmemDatagram> head_, tail_;
+  bool closed_;
+};
+#endif
+
+namespace {
+  // Locator address of an inbox: the host's hash and the process id
+  // in network order, the port is the transport's unicast port.
+  const size_t HOST_OFFSET = 0, PID_OFFSET = 4;
+
+  void put_ulong(CORBA::Octet* dest, ACE_UINT32 value)
+  {
+    dest[0] = static_cast<CORBA::Octet>(value >> 24);
+    dest[1] = static_cast<CORBA::Octet>(value >> 16);
+    dest[2] = static_cast<CORBA::Octet>(value >> 8);
+    dest[3] = static_cast<CORBA::Octet>(value);
+  }
+
+  ACE_UINT32 get_ulong(const CORBA::Octet* src)
+  {
+    return (ACE_UINT32(src[0]) << 24) | (ACE_UINT32(src[1]) << 16)
+      | (ACE_UINT32(src[2]) << 8) | ACE_UINT32(src[3]);
+  }
+
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  /// Name of the pool's lock, also used in log messages.
+  OPENDDS_STRING inbox_name(const Locator_t& locator)
+  {
+    return "OpenDDS-RtpsUdp-"
+      + to_dds_string(static_cast<unsigned int>(get_ulong(locator.address + PID_OFFSET)))
+      + '-' + to_dds_string(static_cast<unsigned int>(locator.port));
+  }
+
+  key_t pool_key(const Locator_t& locator)
+  {
+    const key_t key =
+      static_cast<key_t>(ACE::crc32(inbox_name(locator).c_str()));
+    return key == IPC_PRIVATE ? 1 : key;
+  }
+
+  /// ACE_Shared_Memory_Pool uses a name that is a number as the key of
+  /// its segment, so the segment can be looked up without attaching.
+  OPENDDS_STRING pool_name(const Locator_t& locator)
+  {
+    return to_dds_string(static_cast<int>(pool_key(locator)));
+  }
+
+  RtpsShmemAllocator* create_pool(const Locator_t& locator, size_t pool_size)
+  {
+    RtpsShmemAllocator::MEMORY_POOL_OPTIONS alloc_opts;
+    alloc_opts.base_addr_ = 0;
+    alloc_opts.segment_size_ = pool_size;
+    alloc_opts.minimum_bytes_ = alloc_opts.segment_size_;
+    alloc_opts.max_segments_ = 1;
+    return new RtpsShmemAllocator(
+      ACE_TEXT_CHAR_TO_TCHAR(pool_name(locator).c_str()),
+      ACE_TEXT_CHAR_TO_TCHAR(inbox_name(locator).c_str()), &alloc_opts);
+  }
+#endif
+}
+
+bool
+shmem_same_host(const Locator_t& local, const Locator_t& remote)
+{
+  return local.kind == RTPS::LOCATOR_KIND_SHMEM
+    && remote.kind == RTPS::LOCATOR_KIND_SHMEM
+    && std::memcmp(local.address + HOST_OFFSET, remote.address + HOST_OFFSET,
+                   PID_OFFSET - HOST_OFFSET) == 0
+    && get_ulong(local.address + PID_OFFSET)
+       != get_ulong(remote.address + PID_OFFSET);
+}
+
+bool
+shmem_inbox_exists(const Locator_t& locator)
+{
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  return locator.kind == RTPS::LOCATOR_KIND_SHMEM
+    && ACE_OS::shmget(pool_key(locator), 0, 0) != -1;
+#else
+  ACE_UNUSED_ARG(locator);
+  return false;
+#endif
+}
+
+RtpsShmemInbox::RtpsShmemInbox()
+  : reactor_(0)
+  , handler_(0)
+  , stopped_(false)
+  , notified_(false)
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  , allocator_(0)
+  , control_(0)
+#endif
+{
+  std::memset(&locator_, 0, sizeof locator_);
+  locator_.kind = RTPS::LOCATOR_KIND_INVALID;
+}
+
+RtpsShmemInbox::~RtpsShmemInbox()
+{
+  close();
+}
+
+bool
+RtpsShmemInbox::open(u_short port, size_t pool_size)
+{
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  char host[MAXHOSTNAMELEN + 1] = "";
+  ACE_OS::hostname(host, sizeof host);
+
+  Locator_t locator;
+  std::memset(&locator, 0, sizeof locator);
+  locator.kind = RTPS::LOCATOR_KIND_SHMEM;
+  locator.port = port;
+  put_ulong(locator.address + HOST_OFFSET, ACE::crc32(host));
+  put_ulong(locator.address + PID_OFFSET,
+            static_cast<ACE_UINT32>(ACE_OS::getpid()));
+
+  const OPENDDS_STRING name = inbox_name(locator);
+  allocator_ = create_pool(locator, pool_size);
+
+  // A pool left behind by an earlier process with our pid and port still
+  // holds the messages queued for it, start over with an empty one.
+  void* mem = 0;
+  if (allocator_->find("Inbox", mem) == 0) {
+    VDBG_LVL((LM_INFO, "(%P|%t) RtpsShmemInbox %@ removing stale %C\n",
+              this, name.c_str()), 1);
+    allocator_->remove();
+    delete allocator_;
+    allocator_ = create_pool(locator, pool_size);
+  }
+
+  mem = allocator_->malloc(sizeof(RtpsShmemControl));
+  if (mem == 0 || allocator_->bind("Inbox", mem) == -1) {
+    ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: RtpsShmemInbox::open: ")
+               ACE_TEXT("failed to allocate the inbox in %C\n"),
+               name.c_str()));
+    allocator_->release(1 /*close*/);
+    delete allocator_;
+    allocator_ = 0;
+    return false;
+  }
+
+  control_ = new (mem) RtpsShmemControl;
+  control_->head_ = static_cast<RtpsShmemDatagram*>(0);
+  control_->tail_ = static_cast<RtpsShmemDatagram*>(0);
+  control_->closed_ = false;
+  if (::sem_init(&control_->semaphore_, 1 /*process shared*/, 0) != 0) {
+    ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: RtpsShmemInbox::open: ")
+               ACE_TEXT("could not create semaphore: %m\n")));
+    allocator_->release(1 /*close*/);
+    delete allocator_;
+    allocator_ = 0;
+    control_ = 0;
+    return false;
+  }
+
+  locator_ = locator;
+  VDBG_LVL((LM_INFO, "(%P|%t) RtpsShmemInbox %@ opened %C\n",
+            this, name.c_str()), 1);
+  return true;
+#else
+  ACE_UNUSED_ARG(port);
+  ACE_UNUSED_ARG(pool_size);
+  ACE_ERROR_RETURN((LM_WARNING,
+                    ACE_TEXT("(%P|%t) WARNING: RtpsShmemInbox::open: ")
+                    ACE_TEXT("no platform support for shared memory, ")
+                    ACE_TEXT("use_shmem is ignored\n")),
+                   false);
+#endif
+}
+
+bool
+RtpsShmemInbox::is_open() const
+{
+  return locator_.kind == RTPS::LOCATOR_KIND_SHMEM;
+}
+
+void
+RtpsShmemInbox::close()
+{
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  if (!allocator_) {
+    return;
+  }
+
+  stop();
+
+  {
+    ACE_GUARD(ACE_Process_Mutex, g, allocator_->mutex());
+    control_->closed_ = true;
+    ::sem_destroy(&control_->semaphore_);
+  }
+
+  allocator_->release(1 /*close*/);
+  delete allocator_;
+  allocator_ = 0;
+  control_ = 0;
+  queue_.clear();
+  locator_.kind = RTPS::LOCATOR_KIND_INVALID;
+#endif
+}
+
+bool
+RtpsShmemInbox::start(ACE_Reactor* reactor, ACE_Event_Handler* handler)
+{
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  if (!allocator_) {
+    return false;
+  }
+  reactor_ = reactor;
+  handler_ = handler;
+  stopped_ = false;
+  return activate() == 0;
+#else
+  ACE_UNUSED_ARG(reactor);
+  ACE_UNUSED_ARG(handler);
+  return false;
+#endif
+}
+
+void
+RtpsShmemInbox::stop()
+{
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  if (!reactor_) {
+    return;
+  }
+  stopped_ = true;
+  ::sem_post(&control_->semaphore_);
+  wait();
+  reactor_->purge_pending_notifications(handler_,
+                                        ACE_Event_Handler::READ_MASK);
+  reactor_ = 0;
+  handler_ = 0;
+
+  ACE_GUARD(ACE_Thread_Mutex, g, queue_lock_);
+  notified_ = false;
+#endif
+}
+
+int
+RtpsShmemInbox::svc()
+{
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  while (true) {
+    if (::sem_wait(&control_->semaphore_) == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      ACE_ERROR_RETURN((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: ")
+                        ACE_TEXT("RtpsShmemInbox::svc: sem_wait %m\n")),
+                       -1);
+    }
+    if (stopped_) {
+      return 0;
+    }
+
+    // Each message posts the semaphore once, but all of those queued
+    // so far are taken together.
+    RtpsShmemDatagram* datagram;
+    {
+      ACE_GUARD_RETURN(ACE_Process_Mutex, g, allocator_->mutex(), -1);
+      datagram = control_->head_;
+      control_->head_ = static_cast<RtpsShmemDatagram*>(0);
+      control_->tail_ = static_cast<RtpsShmemDatagram*>(0);
+    }
+    if (!datagram) {
+      continue;
+    }
+
+    bool notify = false;
+    {
+      ACE_GUARD_RETURN(ACE_Thread_Mutex, g, queue_lock_, -1);
+      for (; datagram; datagram = datagram->next_) {
+        queue_.push_back(datagram);
+      }
+      if (!notified_) {
+        notified_ = notify = true;
+      }
+    }
+    if (notify) {
+      reactor_->notify(handler_, ACE_Event_Handler::READ_MASK);
+    }
+  }
+#endif
+  return 0;
+}
+
+bool
+RtpsShmemInbox::readable()
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, queue_lock_, false);
+  if (queue_.empty()) {
+    notified_ = false;
+    return false;
+  }
+  return true;
+}
+
+ssize_t
+RtpsShmemInbox::read(iovec iov[], int n, ACE_INET_Addr& remote_address)
+{
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  RtpsShmemDatagram* datagram;
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, queue_lock_, 0);
+    if (queue_.empty()) {
+      return 0;
+    }
+    datagram = queue_.front();
+    queue_.pop_front();
+  }
+
+  // Like a datagram, whatever doesn't fit is dropped.
+  const char* src = datagram->data();
+  size_t remaining = datagram->size_;
+  for (int i = 0; i < n && remaining; ++i) {
+    const size_t chunk = (std::min)(static_cast<size_t>(iov[i].iov_len),
+                                    remaining);
+    std::memcpy(iov[i].iov_base, src, chunk);
+    src += chunk;
+    remaining -= chunk;
+  }
+  remote_address.set(datagram->source_port_,
+                     static_cast<ACE_UINT32>(INADDR_LOOPBACK));
+
+  const ssize_t result = src - datagram->data();
+  allocator_->free(datagram);
+  return result;
+#else
+  ACE_UNUSED_ARG(iov);
+  ACE_UNUSED_ARG(n);
+  ACE_UNUSED_ARG(remote_address);
+  return 0;
+#endif
+}
+
+RtpsShmemOutbox::RtpsShmemOutbox(const Locator_t& locator)
+  : locator_(locator)
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  , allocator_(0)
+  , control_(0)
+#endif
+{
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  const OPENDDS_STRING name = inbox_name(locator);
+
+  // Attaching would create the pool if it doesn't exist: the peer is on
+  // another host with the same host name hash, or has already gone.
+  if (!shmem_inbox_exists(locator)) {
+    VDBG_LVL((LM_INFO, "(%P|%t) RtpsShmemOutbox %@ inbox %C not found\n",
+              this, name.c_str()), 1);
+    return;
+  }
+  allocator_ = new RtpsShmemAllocator(
+    ACE_TEXT_CHAR_TO_TCHAR(pool_name(locator).c_str()),
+    ACE_TEXT_CHAR_TO_TCHAR(name.c_str()));
+
+  void* mem = 0;
+  if (allocator_->find("Inbox", mem) == -1) {
+    // The peer is still opening its inbox, or it went away since the
+    // check above.  The pool is only removed if no one else uses it.
+    VDBG_LVL((LM_INFO, "(%P|%t) RtpsShmemOutbox %@ inbox %C not found\n",
+              this, name.c_str()), 1);
+    allocator_->release(0 /*don't close*/);
+    delete allocator_;
+    allocator_ = 0;
+    return;
+  }
+  control_ = static_cast<RtpsShmemControl*>(mem);
+  VDBG_LVL((LM_INFO, "(%P|%t) RtpsShmemOutbox %@ attached to %C\n",
+            this, name.c_str()), 1);
+#endif
+}
+
+RtpsShmemOutbox::~RtpsShmemOutbox()
+{
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  if (allocator_) {
+    allocator_->release(0 /*don't close*/);
+    delete allocator_;
+  }
+#endif
+}
+
+bool
+RtpsShmemOutbox::is_open() const
+{
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  return control_ != 0;
+#else
+  return false;
+#endif
+}
+
+bool
+RtpsShmemOutbox::send(const iovec iov[], int n, u_short source_port)
+{
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  if (!control_ || control_->closed_) {
+    return false;
+  }
+
+  size_t size = 0;
+  for (int i = 0; i < n; ++i) {
+    size += iov[i].iov_len;
+  }
+
+  void* const mem = allocator_->malloc(sizeof(RtpsShmemDatagram) + size);
+  if (mem == 0) {
+    VDBG((LM_DEBUG, "(%P|%t) RtpsShmemOutbox %@ inbox is full\n", this));
+    return false;
+  }
+
+  RtpsShmemDatagram* const datagram = new (mem) RtpsShmemDatagram;
+  datagram->next_ = static_cast<RtpsShmemDatagram*>(0);
+  datagram->size_ = size;
+  datagram->source_port_ = source_port;
+  char* dest = datagram->data();
+  for (int i = 0; i < n; ++i) {
+    std::memcpy(dest, iov[i].iov_base, iov[i].iov_len);
+    dest += iov[i].iov_len;
+  }
+
+  ACE_GUARD_RETURN(ACE_Process_Mutex, g, allocator_->mutex(), false);
+  if (control_->closed_) {
+    g.release();
+    allocator_->free(mem);
+    return false;
+  }
+  RtpsShmemDatagram* const tail = control_->tail_;
+  if (tail) {
+    tail->next_ = datagram;
+  } else {
+    control_->head_ = datagram;
+  }
+  control_->tail_ = datagram;
+  // Posted under the mutex, close() destroys the semaphore holding it.
+  ::sem_post(&control_->semaphore_);
+  return true;
+#else
+  ACE_UNUSED_ARG(iov);
+  ACE_UNUSED_ARG(n);
+  ACE_UNUSED_ARG(source_port);
+  return false;
+#endif
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,160 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef DCPS_RTPSUDPSHMEM_H
+#define DCPS_RTPSUDPSHMEM_H
+
+#include "Rtps_Udp_Export.h"
+
+#include "dds/DCPS/RcObject.h"
+#include "dds/DCPS/PoolAllocator.h"
+#include "dds/DdsDcpsInfoUtilsC.h"
+
+#include "ace/INET_Addr.h"
+#include "ace/Task.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/os_include/sys/os_uio.h"
+
+#if !defined ACE_WIN32 && !defined ACE_LACKS_SYSV_SHMEM \
+  && defined ACE_HAS_POSIX_SEM && !defined ACE_LACKS_UNNAMED_SEMAPHORE
+// Peers on the same host share a SysV memory pool signaled through a
+// process-shared POSIX semaphore.
+#define OPENDDS_RTPS_UDP_SHMEM
+#endif
+
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+#include "ace/Malloc_T.h"
+#include "ace/PI_Malloc.h"
+#include "ace/Process_Mutex.h"
+#include "ace/Shared_Memory_Pool.h"
+#endif
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ACE_Event_Handler;
+class ACE_Reactor;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+typedef ACE_Malloc_T<ACE_Shared_Memory_Pool, ACE_Process_Mutex,
+                     ACE_PI_Control_Block> RtpsShmemAllocator;
+#endif
+
+struct RtpsShmemControl;
+struct RtpsShmemDatagram;
+
+/// True if 'remote' is the LOCATOR_KIND_SHMEM locator of an inbox in
+/// another process on the same host as the inbox advertised by 'local'.
+/// Transports in the same process keep using the loopback network.
+bool shmem_same_host(const Locator_t& local, const Locator_t& remote);
+
+/// True if the pool of the inbox advertised by 'locator' exists, this
+/// doesn't attach to it.
+OpenDDS_Rtps_Udp_Export bool shmem_inbox_exists(const Locator_t& locator);
+
+/**
+ * @class RtpsShmemInbox
+ *
+ * @brief Shared-memory pool in which rtps_udp transports in other
+ *        processes on this host leave the RTPS messages they would
+ *        otherwise send to our unicast socket.
+ *
+ * The inbox is advertised with a LOCATOR_KIND_SHMEM locator next to the
+ * UDP locators.  A thread waits for messages and notifies the reactor,
+ * whose call to handle_input(ACE_INVALID_HANDLE) reads them with read(),
+ * so they are parsed on the reactor thread like datagrams.
+ */
+class OpenDDS_Rtps_Udp_Export RtpsShmemInbox : public ACE_Task_Base {
+public:
+  RtpsShmemInbox();
+  ~RtpsShmemInbox();
+
+  /// Create the pool for the transport bound to 'port'.  Returns false
+  /// if shared memory is not available.
+  bool open(u_short port, size_t pool_size);
+
+  /// Remove the pool, stopping delivery first.
+  void close();
+
+  /// Deliver the messages to 'handler' through 'reactor'.
+  bool start(ACE_Reactor* reactor, ACE_Event_Handler* handler);
+  void stop();
+
+  bool is_open() const;
+
+  /// LOCATOR_KIND_INVALID until the inbox is open.
+  const Locator_t& locator() const { return locator_; }
+
+  /// Returns true if read() has a message to return.  Once it returns
+  /// false, the next message that arrives notifies the reactor again.
+  bool readable();
+
+  /// Copy the next message into 'iov', returning its size, which is 0
+  /// if there is none.  'remote_address' is set to the loopback address
+  /// at the sender's unicast port.
+  ssize_t read(iovec iov[], int n, ACE_INET_Addr& remote_address);
+
+private:
+  int svc();
+
+  Locator_t locator_;
+  ACE_Reactor* reactor_;
+  ACE_Event_Handler* handler_;
+  bool stopped_;
+
+  /// Messages taken from the pool and not yet read.
+  OPENDDS_DEQUE(RtpsShmemDatagram*) queue_;
+  /// True while the reactor has a notification for 'handler_' pending.
+  bool notified_;
+  ACE_Thread_Mutex queue_lock_;
+
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  RtpsShmemAllocator* allocator_;
+  RtpsShmemControl* control_;
+#endif
+};
+
+/**
+ * @class RtpsShmemOutbox
+ *
+ * @brief Sends RTPS messages to the RtpsShmemInbox of one peer.
+ */
+class OpenDDS_Rtps_Udp_Export RtpsShmemOutbox : public RcObject {
+public:
+  /// Attach to the inbox advertised by 'locator'.  The outbox is
+  /// unusable if it could not be found, see is_open(), in which case no
+  /// pool is created.
+  explicit RtpsShmemOutbox(const Locator_t& locator);
+  ~RtpsShmemOutbox();
+
+  bool is_open() const;
+  const Locator_t& locator() const { return locator_; }
+
+  /// Queue one RTPS message.  Returns false if the peer's inbox is full
+  /// or closed, in which case the message should go over UDP.
+  bool send(const iovec iov[], int n, u_short source_port);
+
+private:
+  Locator_t locator_;
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  RtpsShmemAllocator* allocator_;
+  RtpsShmemControl* control_;
+#endif
+};
+
+typedef RcHandle<RtpsShmemOutbox> RtpsShmemOutbox_rch;
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* DCPS_RTPSUDPSHMEM_H */
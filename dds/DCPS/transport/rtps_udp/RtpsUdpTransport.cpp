@@ -16,6 +16,7 @@
 #include "dds/DCPS/transport/framework/TransportClient.h"
 #include "dds/DCPS/transport/framework/TransportExceptions.h"
 
+#include "dds/DCPS/RTPS/BaseMessageTypes.h"
 #include "dds/DCPS/RTPS/BaseMessageUtils.h"
 #include "dds/DCPS/RTPS/RtpsCoreTypeSupportImpl.h"
 
@@ -48,7 +49,8 @@ RtpsUdpTransport::make_datalink(const GuidPrefix_t& local_prefix)
 
   RtpsUdpDataLink_rch link = make_rch<RtpsUdpDataLink>(ref(*this), local_prefix, config(), reactor_task());
 
-  if (!link->open(unicast_socket_)) {
+  if (!link->open(unicast_socket_,
+                  shmem_inbox_.is_open() ? &shmem_inbox_ : 0)) {
     ACE_ERROR((LM_ERROR,
                       ACE_TEXT("(%P|%t) ERROR: ")
                       ACE_TEXT("RtpsUdpTransport::make_datalink: ")
@@ -148,7 +150,7 @@ RtpsUdpTransport::use_datalink(const RepoId& local_id,
                                bool local_durable, bool remote_durable)
 {
   bool requires_inline_qos;
-  ACE_INET_Addr addr = get_connection_addr(remote_data, requires_inline_qos);
+  ACE_INET_Addr addr = get_link_addr(remote_data, requires_inline_qos);
   link_->add_locator(remote_id, addr, requires_inline_qos);
   link_->associated(local_id, remote_id, local_reliable, remote_reliable,
                     local_durable, remote_durable);
@@ -156,7 +158,8 @@ RtpsUdpTransport::use_datalink(const RepoId& local_id,
 
 ACE_INET_Addr
 RtpsUdpTransport::get_connection_addr(const TransportBLOB& remote,
-                                      bool& requires_inline_qos) const
+                                      bool& requires_inline_qos,
+                                      Locator_t* shmem_locator) const
 {
   using namespace OpenDDS::RTPS;
   LocatorSeq locators;
@@ -166,12 +169,25 @@ RtpsUdpTransport::get_connection_addr(const TransportBLOB& remote,
     return ACE_INET_Addr();
   }
 
+  // A peer with a shared-memory inbox on this host is addressed by its
+  // unicast locator, which the send strategy maps to the inbox.
+  bool same_host = false;
+  if (shmem_locator && shmem_inbox_.is_open()) {
+    for (CORBA::ULong i = 0; i < locators.length(); ++i) {
+      if (shmem_same_host(shmem_inbox_.locator(), locators[i])) {
+        *shmem_locator = locators[i];
+        same_host = true;
+        break;
+      }
+    }
+  }
+
   for (CORBA::ULong i = 0; i < locators.length(); ++i) {
     ACE_INET_Addr addr;
     // If conversion was successful
     if (locator_to_address(addr, locators[i], map_ipv4_to_ipv6()) == 0) {
       // if this is a unicast address, or if we are allowing multicast
-      if (!addr.is_multicast() || config().use_multicast_) {
+      if (!addr.is_multicast() || (config().use_multicast_ && !same_host)) {
         return addr;
       }
     }
@@ -181,6 +197,20 @@ RtpsUdpTransport::get_connection_addr(const TransportBLOB& remote,
   return ACE_INET_Addr();
 }
 
+ACE_INET_Addr
+RtpsUdpTransport::get_link_addr(const TransportBLOB& remote,
+                                bool& requires_inline_qos)
+{
+  Locator_t shmem_locator = RTPS::LOCATOR_INVALID;
+  const ACE_INET_Addr addr =
+    get_connection_addr(remote, requires_inline_qos, &shmem_locator);
+  if (shmem_locator.kind == RTPS::LOCATOR_KIND_SHMEM
+      && addr != ACE_INET_Addr()) {
+    link_->add_shmem_peer(addr, shmem_locator);
+  }
+  return addr;
+}
+
 bool
 RtpsUdpTransport::connection_info_i(TransportLocator& info) const
 {
@@ -202,7 +232,7 @@ RtpsUdpTransport::register_for_reader(const RepoId& participant,
     link_ = make_datalink(participant.guidPrefix);
   }
   bool requires_inline_qos;
-  link_->register_for_reader(writerid, readerid, get_connection_addr(*blob, requires_inline_qos), listener);
+  link_->register_for_reader(writerid, readerid, get_link_addr(*blob, requires_inline_qos), listener);
 }
 
 void
@@ -229,7 +259,7 @@ RtpsUdpTransport::register_for_writer(const RepoId& participant,
     link_ = make_datalink(participant.guidPrefix);
   }
   bool requires_inline_qos;
-  link_->register_for_writer(readerid, writerid, get_connection_addr(*blob, requires_inline_qos), listener);
+  link_->register_for_writer(readerid, writerid, get_link_addr(*blob, requires_inline_qos), listener);
 }
 
 void
@@ -276,6 +306,12 @@ RtpsUdpTransport::configure_i(RtpsUdpInst& config)
     config.local_address_set_port(address.get_port_number());
   }
 
+  if (config.use_shmem_ &&
+      shmem_inbox_.open(config.local_address().get_port_number(),
+                        config.shmem_pool_size_)) {
+    config.shmem_locator_ = shmem_inbox_.locator();
+  }
+
   create_reactor_task();
 
   if (config.opendds_discovery_default_listener_) {
@@ -293,6 +329,9 @@ RtpsUdpTransport::shutdown_i()
     link_->transport_shutdown();
   }
   link_.reset();
+
+  config().shmem_locator_ = RTPS::LOCATOR_INVALID;
+  shmem_inbox_.close();
 }
 
 void
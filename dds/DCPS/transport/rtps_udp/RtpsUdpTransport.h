@@ -12,6 +12,7 @@
 
 #include "RtpsUdpDataLink.h"
 #include "RtpsUdpDataLink_rch.h"
+#include "RtpsUdpShmem.h"
 
 #include "dds/DCPS/transport/framework/TransportImpl.h"
 #include "dds/DCPS/transport/framework/TransportClient.h"
@@ -68,8 +69,16 @@ private:
                                      const RepoId& /*writerid*/);
 
   virtual bool connection_info_i(TransportLocator& info) const;
+  /// When 'shmem_locator' is given and the remote is in another process
+  /// on this host, it is set to the remote's shared-memory inbox and the
+  /// returned address is unicast.
   ACE_INET_Addr get_connection_addr(const TransportBLOB& data,
-                                    bool& requires_inline_qos) const;
+                                    bool& requires_inline_qos,
+                                    Locator_t* shmem_locator = 0) const;
+  /// get_connection_addr() for use with link_, which is told about the
+  /// remote's shared-memory inbox.
+  ACE_INET_Addr get_link_addr(const TransportBLOB& data,
+                              bool& requires_inline_qos);
 
   virtual void release_datalink(DataLink* link);
 
@@ -103,6 +112,8 @@ private:
   bool map_ipv4_to_ipv6() const;
 
   ACE_SOCK_Dgram unicast_socket_;
+  /// Open if RtpsUdpInst::use_shmem_ is set, outlives link_.
+  RtpsShmemInbox shmem_inbox_;
 
   TransportClient_wrch default_listener_;
 };
@@ -23,7 +23,8 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 OpenDDS::DCPS::TcpReceiveStrategy::TcpReceiveStrategy(
   TcpDataLink& link,
   const TransportReactorTask_rch& task)
-  : link_(link)
+  : TransportReceiveStrategy<>(link.impl().config())
+  , link_(link)
   , reactor_task_(task)
 {
   DBG_ENTRY_LVL("TcpReceiveStrategy","TcpReceiveStrategy",6);
@@ -7,6 +7,7 @@
 
 #include "UdpReceiveStrategy.h"
 #include "UdpDataLink.h"
+#include "UdpTransport.h"
 
 #include "ace/Reactor.h"
 
@@ -16,7 +17,8 @@ namespace OpenDDS {
 namespace DCPS {
 
 UdpReceiveStrategy::UdpReceiveStrategy(UdpDataLink* link)
-  : link_(link)
+  : TransportReceiveStrategy<>(link->impl().config())
+  , link_(link)
   , expected_(SequenceNumber::SEQUENCENUMBER_UNKNOWN())
 {
 }
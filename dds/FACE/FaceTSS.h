@@ -42,12 +42,35 @@ public:
         total_msgs_recvd(0)
     {}
 
-    virtual ~FaceReceiver() {}
+    virtual ~FaceReceiver()
+    {
+      if (read_condition) {
+        wait_set->detach_condition(read_condition);
+        dr->delete_readcondition(read_condition);
+      }
+    }
     virtual FACE::RETURN_CODE_TYPE messages_waiting(FACE::WAITING_RANGE_TYPE& /*num_waiting*/)
     {
       return FACE::NOT_AVAILABLE;
     };
+
+    /// Condition for the samples a receive can return, created on first use
+    /// and kept (attached to wait_set) for the life of the connection.
+    DDS::ReadCondition_ptr receive_condition()
+    {
+      if (!read_condition) {
+        read_condition = dr->create_readcondition(DDS::ANY_SAMPLE_STATE,
+                                                  DDS::ANY_VIEW_STATE,
+                                                  DDS::ALIVE_INSTANCE_STATE);
+        wait_set = new DDS::WaitSet;
+        wait_set->attach_condition(read_condition);
+      }
+      return read_condition.in();
+    }
+
     DDS::DataReader_var dr;
+    DDS::ReadCondition_var read_condition;
+    DDS::WaitSet_var wait_set;
     FACE::TS::MessageHeader last_msg_header;
     FACE::TRANSACTION_ID_TYPE last_msg_tid;
     FACE::SYSTEM_TIME_TYPE sum_recvd_msgs_latency;
@@ -101,6 +124,9 @@ Entities::DDSTypedAdapter<Msg>::DDSTypedAdapter(FaceReceiver& rcvr)
   last_msg_tid = rcvr.last_msg_tid;
   sum_recvd_msgs_latency = rcvr.sum_recvd_msgs_latency;
   total_msgs_recvd = rcvr.total_msgs_recvd;
+  // rcvr is about to be deleted, take over its condition
+  read_condition = rcvr.read_condition._retn();
+  wait_set = rcvr.wait_set._retn();
 }
 
 template <typename Msg>
@@ -116,10 +142,7 @@ FACE::RETURN_CODE_TYPE Entities::DDSTypedAdapter<Msg>::messages_waiting(FACE::WA
   if (!typedReader) {
     return FACE::INVALID_PARAM;
   }
-  const DDS::ReadCondition_var rc =
-      typedReader->create_readcondition(DDS::ANY_SAMPLE_STATE,
-                                DDS::ANY_VIEW_STATE,
-                                DDS::ALIVE_INSTANCE_STATE);
+  DDS::ReadCondition_ptr rc = receive_condition();
 
   DDS::ReturnCode_t ret;
   typename DCPS::DDSTraits<Msg>::MessageSequenceType seq;
@@ -141,66 +164,90 @@ FACE::RETURN_CODE_TYPE Entities::DDSTypedAdapter<Msg>::messages_waiting(FACE::WA
   return FACE::NOT_AVAILABLE;
 }
 
+/// Validates the connection and takes up to max_samples samples into seq,
+/// blocking for up to timeout only if none are available right away.
+/// Returns false (with return_code set) if there is nothing to return.
 template <typename Msg>
-void receive_message(/*in*/    FACE::CONNECTION_ID_TYPE connection_id,
-                     /*in*/    FACE::TIMEOUT_TYPE timeout,
-                     /*inout*/ FACE::TRANSACTION_ID_TYPE& transaction_id,
-                     /*inout*/ Msg& message,
-                     /*in*/    FACE::MESSAGE_SIZE_TYPE message_size,
-                     /*out*/   FACE::RETURN_CODE_TYPE& return_code)
+bool receive_samples(FACE::CONNECTION_ID_TYPE connection_id,
+                     FACE::TIMEOUT_TYPE timeout,
+                     FACE::MESSAGE_SIZE_TYPE message_size,
+                     CORBA::Long max_samples,
+                     typename DCPS::DDSTraits<Msg>::MessageSequenceType& seq,
+                     DDS::SampleInfoSeq& sinfo,
+                     FACE::RETURN_CODE_TYPE& return_code)
 {
-  try {
-    Entities::ConnIdToReceiverMap& readers = Entities::instance()->receivers_;
-    if (!readers.count(connection_id)) {
-      return_code = FACE::INVALID_PARAM;
-      return;
-    }
-    if (!Entities::instance()->connections_.count(connection_id)) {
-      return_code = FACE::INVALID_PARAM;
-      return;
-    }
-    FACE::TRANSPORT_CONNECTION_STATUS_TYPE status =
-      Entities::instance()->connections_[connection_id].connection_status;
-    if (message_size < status.MAX_MESSAGE_SIZE) {
-      return_code = FACE::INVALID_PARAM;
-      return;
-    }
-    typedef typename DCPS::DDSTraits<Msg>::DataReaderType DataReader;
-    const typename DataReader::_var_type typedReader =
-      DataReader::_narrow(readers[connection_id]->dr);
-    if (!typedReader) {
-      return_code = update_status(connection_id, DDS::RETCODE_BAD_PARAMETER);
-      return;
-    }
-    if (readers[connection_id]->status_valid != FACE::VALID) {
-      Entities::FaceReceiver* tmp = readers[connection_id];
-      readers[connection_id] = new Entities::DDSTypedAdapter<Msg>(*readers[connection_id]);
-      delete tmp;
-    }
-    readers[connection_id]->status_valid = FACE::VALID;
+  Entities::ConnIdToReceiverMap& readers = Entities::instance()->receivers_;
+  if (!readers.count(connection_id)) {
+    return_code = FACE::INVALID_PARAM;
+    return false;
+  }
+  if (!Entities::instance()->connections_.count(connection_id)) {
+    return_code = FACE::INVALID_PARAM;
+    return false;
+  }
+  FACE::TRANSPORT_CONNECTION_STATUS_TYPE status =
+    Entities::instance()->connections_[connection_id].connection_status;
+  if (message_size < status.MAX_MESSAGE_SIZE) {
+    return_code = FACE::INVALID_PARAM;
+    return false;
+  }
+  typedef typename DCPS::DDSTraits<Msg>::DataReaderType DataReader;
+  const typename DataReader::_var_type typedReader =
+    DataReader::_narrow(readers[connection_id]->dr);
+  if (!typedReader) {
+    return_code = update_status(connection_id, DDS::RETCODE_BAD_PARAMETER);
+    return false;
+  }
+  if (readers[connection_id]->status_valid != FACE::VALID) {
+    Entities::FaceReceiver* tmp = readers[connection_id];
+    readers[connection_id] = new Entities::DDSTypedAdapter<Msg>(*readers[connection_id]);
+    delete tmp;
+  }
+  Entities::FaceReceiver& receiver = *readers[connection_id];
+  receiver.status_valid = FACE::VALID;
 
-    const DDS::ReadCondition_var rc =
-      typedReader->create_readcondition(DDS::ANY_SAMPLE_STATE,
-        DDS::ANY_VIEW_STATE,
-        DDS::ALIVE_INSTANCE_STATE);
-    const DDS::WaitSet_var ws = new DDS::WaitSet;
-    ws->attach_condition(rc);
+  DDS::ReadCondition_ptr rc = receiver.receive_condition();
+  DDS::ReturnCode_t ret = typedReader->take_w_condition(seq, sinfo, max_samples, rc);
 
+  if (ret == DDS::RETCODE_NO_DATA) {
     DDS::ConditionSeq active;
     const DDS::Duration_t ddsTimeout = convertTimeout(timeout);
-    DDS::ReturnCode_t ret = ws->wait(active, ddsTimeout);
-    ws->detach_condition(rc);
+    ret = receiver.wait_set->wait(active, ddsTimeout);
 
     if (ret == DDS::RETCODE_TIMEOUT) {
       return_code = update_status(connection_id, ret);
-      return;
+      return false;
     }
 
+    ret = typedReader->take_w_condition(seq, sinfo, max_samples, rc);
+  }
+
+  if (ret != DDS::RETCODE_OK) {
+    return_code = update_status(connection_id, DDS::RETCODE_NO_DATA);
+    return false;
+  }
+  return true;
+}
+
+template <typename Msg>
+void receive_message(/*in*/    FACE::CONNECTION_ID_TYPE connection_id,
+                     /*in*/    FACE::TIMEOUT_TYPE timeout,
+                     /*inout*/ FACE::TRANSACTION_ID_TYPE& transaction_id,
+                     /*inout*/ Msg& message,
+                     /*in*/    FACE::MESSAGE_SIZE_TYPE message_size,
+                     /*out*/   FACE::RETURN_CODE_TYPE& return_code)
+{
+  try {
     typename DCPS::DDSTraits<Msg>::MessageSequenceType seq;
     DDS::SampleInfoSeq sinfo;
-    ret = typedReader->take_w_condition(seq, sinfo, 1 /*max*/, rc);
-    if (ret == DDS::RETCODE_OK && sinfo[0].valid_data) {
-      DDS::Subscriber_var subscriber = typedReader->get_subscriber();
+    if (!receive_samples<Msg>(connection_id, timeout, message_size, 1 /*max*/,
+                              seq, sinfo, return_code)) {
+      return;
+    }
+
+    if (sinfo[0].valid_data) {
+      Entities::FaceReceiver& receiver = *Entities::instance()->receivers_[connection_id];
+      DDS::Subscriber_var subscriber = receiver.dr->get_subscriber();
       DDS::DomainParticipant_var participant = subscriber->get_participant();
       FACE::RETURN_CODE_TYPE ret_code;
       populate_header_received(connection_id, participant, sinfo[0], ret_code);
@@ -209,10 +256,10 @@ void receive_message(/*in*/    FACE::CONNECTION_ID_TYPE connection_id,
         return;
       }
 
-      transaction_id = ++readers[connection_id]->last_msg_tid;
+      transaction_id = ++receiver.last_msg_tid;
 
       message = seq[0];
-      return_code = update_status(connection_id, ret);
+      return_code = update_status(connection_id, DDS::RETCODE_OK);
       return;
     }
     return_code = update_status(connection_id, DDS::RETCODE_NO_DATA);
@@ -224,6 +271,59 @@ void receive_message(/*in*/    FACE::CONNECTION_ID_TYPE connection_id,
   }
 }
 
+/// Batched form of receive_message: returns up to max_messages messages in
+/// one call.  transaction_id and the last message header refer to the last
+/// message returned.
+template <typename Msg>
+void receive_messages(/*in*/    FACE::CONNECTION_ID_TYPE connection_id,
+                      /*in*/    FACE::TIMEOUT_TYPE timeout,
+                      /*inout*/ FACE::TRANSACTION_ID_TYPE& transaction_id,
+                      /*out*/   typename DCPS::DDSTraits<Msg>::MessageSequenceType& messages,
+                      /*in*/    CORBA::Long max_messages,
+                      /*in*/    FACE::MESSAGE_SIZE_TYPE message_size,
+                      /*out*/   FACE::RETURN_CODE_TYPE& return_code)
+{
+  try {
+    messages.length(0);
+    typename DCPS::DDSTraits<Msg>::MessageSequenceType seq;
+    DDS::SampleInfoSeq sinfo;
+    if (!receive_samples<Msg>(connection_id, timeout, message_size, max_messages,
+                              seq, sinfo, return_code)) {
+      return;
+    }
+
+    Entities::FaceReceiver& receiver = *Entities::instance()->receivers_[connection_id];
+    DDS::Subscriber_var subscriber = receiver.dr->get_subscriber();
+    DDS::DomainParticipant_var participant = subscriber->get_participant();
+
+    CORBA::ULong count = 0;
+    messages.length(seq.length());
+    for (CORBA::ULong i = 0; i < seq.length(); ++i) {
+      if (!sinfo[i].valid_data) {
+        continue;
+      }
+      FACE::RETURN_CODE_TYPE ret_code;
+      populate_header_received(connection_id, participant, sinfo[i], ret_code);
+      if (ret_code != FACE::RC_NO_ERROR) {
+        messages.length(count);
+        return_code = update_status(connection_id, ret_code);
+        return;
+      }
+      transaction_id = ++receiver.last_msg_tid;
+      messages[count++] = seq[i];
+    }
+    messages.length(count);
+
+    return_code = update_status(connection_id,
+      count ? DDS::RETCODE_OK : DDS::RETCODE_NO_DATA);
+  } catch (const CORBA::BAD_PARAM&) {
+    if (OpenDDS::DCPS::DCPS_debug_level) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: receive_messages - INVALID_PARAM\n"));
+    }
+    return_code = FACE::INVALID_PARAM;
+  }
+}
+
 template <typename Msg>
 void send_message(FACE::CONNECTION_ID_TYPE connection_id,
                   FACE::TIMEOUT_TYPE timeout,
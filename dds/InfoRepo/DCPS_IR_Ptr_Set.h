@@ -0,0 +1,73 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef DCPS_IR_PTR_SET_H
+#define DCPS_IR_PTR_SET_H
+
+#include "dds/Versioned_Namespace.h"
+#include <set>
+#include <cstddef>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class DCPS_IR_Ptr_Set
+ *
+ * @brief Ordered set of repository entity pointers.
+ *
+ * Provides the subset of the ACE_Unbounded_Set interface (including its
+ * return codes) used by the repository, but with logarithmic insert,
+ * remove and find instead of a linear scan.  Used for the publication and
+ * subscription collections that grow with the number of endpoints.
+ */
+template <typename T>
+class DCPS_IR_Ptr_Set {
+  typedef std::set<T*> SetType;
+
+public:
+  typedef typename SetType::iterator iterator;
+  typedef typename SetType::const_iterator const_iterator;
+  typedef iterator ITERATOR;
+
+  /// Returns 0 if inserted, 1 if already present
+  int insert(T* item)
+  {
+    return set_.insert(item).second ? 0 : 1;
+  }
+
+  /// Returns 0 if removed, -1 if not present
+  int remove(T* item)
+  {
+    return set_.erase(item) ? 0 : -1;
+  }
+
+  /// Returns 0 if present, -1 if not
+  int find(T* item) const
+  {
+    return set_.count(item) ? 0 : -1;
+  }
+
+  void reset() { set_.clear(); }
+  size_t size() const { return set_.size(); }
+  bool is_empty() const { return set_.empty(); }
+
+  iterator begin() { return set_.begin(); }
+  iterator end() { return set_.end(); }
+  const_iterator begin() const { return set_.begin(); }
+  const_iterator end() const { return set_.end(); }
+
+private:
+  SetType set_;
+};
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* DCPS_IR_PTR_SET_H */
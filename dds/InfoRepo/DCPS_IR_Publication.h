@@ -14,7 +14,7 @@
 #include /**/ "dds/DdsDcpsPublicationC.h"
 #include /**/ "dds/DCPS/InfoRepoDiscovery/InfoC.h"
 #include /**/ "dds/DCPS/InfoRepoDiscovery/DataWriterRemoteC.h"
-#include /**/ "ace/Unbounded_Set.h"
+#include "DCPS_IR_Ptr_Set.h"
 #include "dds/DCPS/unique_ptr.h"
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
@@ -29,7 +29,7 @@ class DCPS_IR_Topic;
 class DCPS_IR_Topic_Description;
 
 class DCPS_IR_Subscription;
-typedef ACE_Unbounded_Set<DCPS_IR_Subscription*> DCPS_IR_Subscription_Set;
+typedef DCPS_IR_Ptr_Set<DCPS_IR_Subscription> DCPS_IR_Subscription_Set;
 
 /**
  * @class DCPS_IR_Publication
@@ -14,7 +14,7 @@
 #include /**/ "dds/DdsDcpsSubscriptionC.h"
 #include /**/ "dds/DCPS/InfoRepoDiscovery/InfoC.h"
 #include /**/ "dds/DCPS/InfoRepoDiscovery/DataReaderRemoteC.h"
-#include /**/ "ace/Unbounded_Set.h"
+#include "DCPS_IR_Ptr_Set.h"
 #include "dds/DCPS/unique_ptr.h"
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
@@ -25,7 +25,7 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 // forward declarations
 class DCPS_IR_Publication;
-typedef ACE_Unbounded_Set<DCPS_IR_Publication*> DCPS_IR_Publication_Set;
+typedef DCPS_IR_Ptr_Set<DCPS_IR_Publication> DCPS_IR_Publication_Set;
 
 class DCPS_IR_Participant;
 class DCPS_IR_Topic_Description;
@@ -12,7 +12,7 @@
 #include /**/ "dds/DdsDcpsInfrastructureC.h"
 #include /**/ "dds/DdsDcpsTopicC.h"
 #include /**/ "dds/DCPS/InfoRepoDiscovery/InfoC.h"
-#include /**/ "ace/Unbounded_Set.h"
+#include "DCPS_IR_Ptr_Set.h"
 #include "dds/DCPS/unique_ptr.h"
 #include <string>
 
@@ -24,10 +24,10 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 // forward declarations
 class DCPS_IR_Publication;
-typedef ACE_Unbounded_Set<DCPS_IR_Publication*> DCPS_IR_Publication_Set;
+typedef DCPS_IR_Ptr_Set<DCPS_IR_Publication> DCPS_IR_Publication_Set;
 
 class DCPS_IR_Subscription;
-typedef ACE_Unbounded_Set<DCPS_IR_Subscription*> DCPS_IR_Subscription_Set;
+typedef DCPS_IR_Ptr_Set<DCPS_IR_Subscription> DCPS_IR_Subscription_Set;
 
 class DCPS_IR_Domain;
 class DCPS_IR_Participant;
@@ -10,6 +10,7 @@
 
 #include  "inforepo_export.h"
 #include /**/ "ace/Unbounded_Set.h"
+#include "DCPS_IR_Ptr_Set.h"
 #include /**/ "ace/SString.h"
 #include /**/ "tao/corbafwd.h"
 #include "dds/DCPS/unique_ptr.h"
@@ -29,7 +30,7 @@ class DCPS_IR_Publication;
 class DCPS_IR_Domain;
 
 class DCPS_IR_Subscription;
-typedef ACE_Unbounded_Set<DCPS_IR_Subscription*> DCPS_IR_Subscription_Set;
+typedef DCPS_IR_Ptr_Set<DCPS_IR_Subscription> DCPS_IR_Subscription_Set;
 
 class DCPS_IR_Topic;
 typedef ACE_Unbounded_Set<DCPS_IR_Topic*> DCPS_IR_Topic_Set;
@@ -17,6 +17,7 @@
 #include "ace/Malloc_T.h"
 #include "ace/MMAP_Memory_Pool.h"
 #include "ace/OS_NS_strings.h"
+#include "ace/OS_NS_sys_time.h"
 #include "ace/Svc_Handler.h"
 #include "ace/Dynamic_Service.h"
 
@@ -210,9 +211,24 @@ PersistenceUpdater::IdType_ExtId::hash() const
   return OpenDDS::DCPS::RepoIdConverter(id_).checksum();
 };
 
+PersistenceUpdater::PendingEntity::PendingEntity()
+  : type(Update::Topic)
+  , create(false)
+  , destroy(false)
+  , domainId(0)
+  , owner(0)
+  , topicId(OpenDDS::DCPS::GUID_UNKNOWN)
+  , participantId(OpenDDS::DCPS::GUID_UNKNOWN)
+  , actorType(DataWriter)
+  , pubsubKind(NoQos)
+  , drdwKind(NoQos)
+{}
+
 PersistenceUpdater::PersistenceUpdater()
   : persistence_file_(ACE_TEXT("InforepoPersist"))
   , reset_(false)
+  , queue_cond_(queue_lock_)
+  , shutdown_(false)
   , um_(0)
   , topic_index_(0)
   , participant_index_(0)
@@ -355,6 +371,12 @@ PersistenceUpdater::init(int argc, ACE_TCHAR *argv[])
   // lastly register the callback
   um_->add(this);
 
+  if (flush_interval_ != ACE_Time_Value::zero && activate() == -1) {
+    ACE_ERROR((LM_ERROR, ACE_TEXT("PersistenceUpdater initialization failed. ")
+               ACE_TEXT("Unable to start the flush thread.\n")));
+    return -1;
+  }
+
   return 0;
 }
 
@@ -368,6 +390,13 @@ PersistenceUpdater::parse(int argc, ACE_TCHAR *argv[])
         count++;
       }
 
+    } else if (ACE_OS::strcasecmp(argv[count], ACE_TEXT("-flushInterval")) == 0) {
+      if ((count + 1) < argc) {
+        // milliseconds that changes may be held before they are written
+        flush_interval_.msec(ACE_OS::atoi(argv[count+1]));
+        count++;
+      }
+
     } else if (ACE_OS::strcasecmp(argv[count], ACE_TEXT("-reset")) == 0) {
       if ((count + 1) < argc) {
         int val = ACE_OS::atoi(argv[count+1]);
@@ -393,15 +422,55 @@ PersistenceUpdater::parse(int argc, ACE_TCHAR *argv[])
 int
 PersistenceUpdater::fini()
 {
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, queue_lock_, -1);
+    shutdown_ = true;
+    queue_cond_.signal();
+  }
+  wait();
+  flush();
   return 0;
 }
 
 int
 PersistenceUpdater::svc()
 {
+  for (bool done = false; !done;) {
+    {
+      ACE_GUARD_RETURN(ACE_Thread_Mutex, g, queue_lock_, -1);
+      const ACE_Time_Value deadline = ACE_OS::gettimeofday() + flush_interval_;
+      while (!shutdown_ && ACE_OS::gettimeofday() < deadline) {
+        queue_cond_.wait(&deadline);
+      }
+      done = shutdown_;
+    }
+    flush();
+  }
   return 0;
 }
 
+void
+PersistenceUpdater::flush()
+{
+  ACE_GUARD(ACE_Thread_Mutex, store_guard, store_lock_);
+  PendingMap batch;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, queue_guard, queue_lock_);
+    batch.swap(pending_);
+  }
+
+  for (PendingMap::const_iterator it = batch.begin(); it != batch.end(); ++it) {
+    store(it->first, it->second);
+  }
+}
+
+size_t
+PersistenceUpdater::pending()
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, queue_lock_, 0);
+  return pending_.size();
+}
+
 void
 PersistenceUpdater::requestImage()
 {
@@ -409,418 +478,276 @@ PersistenceUpdater::requestImage()
     return;
   }
 
+  // The image has to include changes that are still queued.
+  flush();
+
   DImage image;
 
   // Allocate space to hold the QOS sequences.
   std::vector<ArrDelAdapter<char> > qos_sequences;
 
-  for (ParticipantIndex::ITERATOR iter = participant_index_->begin();
-       iter != participant_index_->end(); iter++) {
-    const PersistenceUpdater::Participant* participant
-    = (*iter).int_id_;
-
-    size_t qos_len = participant->participantQos.second.first;
-    char *buf;
-    ACE_NEW_NORETURN(buf, char[qos_len]);
-    qos_sequences.push_back(ArrDelAdapter<char>(buf));
-
-    if (buf == 0) {
-      ACE_ERROR((LM_ERROR,
-                 ACE_TEXT("PersistenceUpdater::requestImage(): allocation failed.\n")));
-      return;
-    }
+  {
+    // pushImage() feeds the image back through create() and update(),
+    // which write to the store, so only hold the lock while reading it.
+    ACE_GUARD(ACE_Thread_Mutex, store_guard, store_lock_);
 
-    ACE_OS::memcpy(buf, participant->participantQos.second.second, qos_len);
+    for (ParticipantIndex::ITERATOR iter = participant_index_->begin();
+         iter != participant_index_->end(); iter++) {
+      const PersistenceUpdater::Participant* participant
+      = (*iter).int_id_;
 
-    BinSeq in_seq(qos_len, buf);
-    QosSeq qos(ParticipantQos, in_seq);
-    DParticipant dparticipant(participant->domainId
-                              , participant->owner
-                              , participant->participantId
-                              , qos);
-    image.participants.push_back(dparticipant);
-  }
+      size_t qos_len = participant->participantQos.second.first;
+      char *buf;
+      ACE_NEW_NORETURN(buf, char[qos_len]);
+      qos_sequences.push_back(ArrDelAdapter<char>(buf));
 
-  for (TopicIndex::ITERATOR iter = topic_index_->begin();
-       iter != topic_index_->end(); iter++) {
-    const PersistenceUpdater::Topic* topic = (*iter).int_id_;
+      if (buf == 0) {
+        ACE_ERROR((LM_ERROR,
+                   ACE_TEXT("PersistenceUpdater::requestImage(): allocation failed.\n")));
+        return;
+      }
 
-    size_t qos_len = topic->topicQos.second.first;
-    char *buf;
-    ACE_NEW_NORETURN(buf, char[qos_len]);
-    qos_sequences.push_back(ArrDelAdapter<char>(buf));
+      ACE_OS::memcpy(buf, participant->participantQos.second.second, qos_len);
 
-    if (buf == 0) {
-      ACE_ERROR((LM_ERROR,
-                 ACE_TEXT("PersistenceUpdater::requestImage(): allocation failed.\n")));
-      return;
+      BinSeq in_seq(qos_len, buf);
+      QosSeq qos(ParticipantQos, in_seq);
+      DParticipant dparticipant(participant->domainId
+                                , participant->owner
+                                , participant->participantId
+                                , qos);
+      image.participants.push_back(dparticipant);
     }
 
-    ACE_OS::memcpy(buf, topic->topicQos.second.second, qos_len);
+    for (TopicIndex::ITERATOR iter = topic_index_->begin();
+         iter != topic_index_->end(); iter++) {
+      const PersistenceUpdater::Topic* topic = (*iter).int_id_;
 
-    BinSeq in_seq(qos_len, buf);
-    QosSeq qos(TopicQos, in_seq);
-    DTopic dTopic(topic->domainId, topic->topicId
-                  , topic->participantId, topic->name.c_str()
-                  , topic->dataType.c_str(), qos);
-    image.topics.push_back(dTopic);
-  }
+      size_t qos_len = topic->topicQos.second.first;
+      char *buf;
+      ACE_NEW_NORETURN(buf, char[qos_len]);
+      qos_sequences.push_back(ArrDelAdapter<char>(buf));
 
-  for (ActorIndex::ITERATOR iter = actor_index_->begin();
-       iter != actor_index_->end(); iter++) {
-    const PersistenceUpdater::RWActor* actor = (*iter).int_id_;
+      if (buf == 0) {
+        ACE_ERROR((LM_ERROR,
+                   ACE_TEXT("PersistenceUpdater::requestImage(): allocation failed.\n")));
+        return;
+      }
 
-    size_t qos_len = actor->pubsubQos.second.first;
-    char *buf;
-    ACE_NEW_NORETURN(buf, char[qos_len]);
-    qos_sequences.push_back(ArrDelAdapter<char>(buf));
+      ACE_OS::memcpy(buf, topic->topicQos.second.second, qos_len);
 
-    if (buf == 0) {
-      ACE_ERROR((LM_ERROR,
-                 ACE_TEXT("PersistenceUpdater::requestImage(): allocation failed.\n")));
-      return;
+      BinSeq in_seq(qos_len, buf);
+      QosSeq qos(TopicQos, in_seq);
+      DTopic dTopic(topic->domainId, topic->topicId
+                    , topic->participantId, topic->name.c_str()
+                    , topic->dataType.c_str(), qos);
+      image.topics.push_back(dTopic);
     }
 
-    ACE_OS::memcpy(buf, actor->pubsubQos.second.second, qos_len);
+    for (ActorIndex::ITERATOR iter = actor_index_->begin();
+         iter != actor_index_->end(); iter++) {
+      const PersistenceUpdater::RWActor* actor = (*iter).int_id_;
 
-    BinSeq in_pubsub_seq(qos_len, buf);
-    QosSeq pubsub_qos(actor->pubsubQos.first, in_pubsub_seq);
+      size_t qos_len = actor->pubsubQos.second.first;
+      char *buf;
+      ACE_NEW_NORETURN(buf, char[qos_len]);
+      qos_sequences.push_back(ArrDelAdapter<char>(buf));
 
-    qos_len = actor->drdwQos.second.first;
-    ACE_NEW_NORETURN(buf, char[qos_len]);
-    qos_sequences.push_back(ArrDelAdapter<char>(buf));
+      if (buf == 0) {
+        ACE_ERROR((LM_ERROR,
+                   ACE_TEXT("PersistenceUpdater::requestImage(): allocation failed.\n")));
+        return;
+      }
 
-    if (buf == 0) {
-      ACE_ERROR((LM_ERROR,
-                 ACE_TEXT("PersistenceUpdater::requestImage(): allocation failed.\n")));
-      return;
-    }
+      ACE_OS::memcpy(buf, actor->pubsubQos.second.second, qos_len);
 
-    ACE_OS::memcpy(buf, actor->drdwQos.second.second, qos_len);
+      BinSeq in_pubsub_seq(qos_len, buf);
+      QosSeq pubsub_qos(actor->pubsubQos.first, in_pubsub_seq);
 
-    BinSeq in_drdw_seq(qos_len, buf);
-    QosSeq drdw_qos(actor->drdwQos.first, in_drdw_seq);
+      qos_len = actor->drdwQos.second.first;
+      ACE_NEW_NORETURN(buf, char[qos_len]);
+      qos_sequences.push_back(ArrDelAdapter<char>(buf));
 
-    qos_len = actor->transportInterfaceInfo.first;
-    ACE_NEW_NORETURN(buf, char[qos_len]);
-    qos_sequences.push_back(ArrDelAdapter<char>(buf));
+      if (buf == 0) {
+        ACE_ERROR((LM_ERROR,
+                   ACE_TEXT("PersistenceUpdater::requestImage(): allocation failed.\n")));
+        return;
+      }
 
-    if (buf == 0) {
-      ACE_ERROR((LM_ERROR,
-                 ACE_TEXT("PersistenceUpdater::requestImage(): allocation failed.\n")));
-      return;
-    }
+      ACE_OS::memcpy(buf, actor->drdwQos.second.second, qos_len);
 
-    ACE_OS::memcpy(buf, actor->transportInterfaceInfo.second, qos_len);
+      BinSeq in_drdw_seq(qos_len, buf);
+      QosSeq drdw_qos(actor->drdwQos.first, in_drdw_seq);
 
-    BinSeq in_transport_seq(qos_len, buf);
+      qos_len = actor->transportInterfaceInfo.first;
+      ACE_NEW_NORETURN(buf, char[qos_len]);
+      qos_sequences.push_back(ArrDelAdapter<char>(buf));
 
-    ContentSubscriptionBin in_csp_bin;
-    if (actor->type == DataReader) {
-      in_csp_bin.filterClassName = actor->contentSubscriptionProfile.filterClassName;
-      in_csp_bin.filterExpr = actor->contentSubscriptionProfile.filterExpr;
-      BinSeq& params = in_csp_bin.exprParams;
-      ACE_NEW_NORETURN(params.second, char[params.first]);
-      if (params.second == 0) {
+      if (buf == 0) {
         ACE_ERROR((LM_ERROR,
-                   ACE_TEXT("PersistenceUpdater::requestImage(): allocation ")
-                   ACE_TEXT("failed.\n")));
+                   ACE_TEXT("PersistenceUpdater::requestImage(): allocation failed.\n")));
         return;
       }
-      qos_sequences.push_back(ArrDelAdapter<char>(params.second));
-      ACE_OS::memcpy(params.second,
-        actor->contentSubscriptionProfile.exprParams.second, params.first);
-    }
 
-    DActor dActor(actor->domainId, actor->actorId, actor->topicId
-                  , actor->participantId
-                  , actor->type, actor->callback.c_str()
-                  , pubsub_qos, drdw_qos, in_transport_seq, in_csp_bin);
-    image.actors.push_back(dActor);
+      ACE_OS::memcpy(buf, actor->transportInterfaceInfo.second, qos_len);
+
+      BinSeq in_transport_seq(qos_len, buf);
+
+      ContentSubscriptionBin in_csp_bin;
+      if (actor->type == DataReader) {
+        in_csp_bin.filterClassName = actor->contentSubscriptionProfile.filterClassName;
+        in_csp_bin.filterExpr = actor->contentSubscriptionProfile.filterExpr;
+        BinSeq& params = in_csp_bin.exprParams;
+        ACE_NEW_NORETURN(params.second, char[params.first]);
+        if (params.second == 0) {
+          ACE_ERROR((LM_ERROR,
+                     ACE_TEXT("PersistenceUpdater::requestImage(): allocation ")
+                     ACE_TEXT("failed.\n")));
+          return;
+        }
+        qos_sequences.push_back(ArrDelAdapter<char>(params.second));
+        ACE_OS::memcpy(params.second,
+          actor->contentSubscriptionProfile.exprParams.second, params.first);
+      }
+
+      DActor dActor(actor->domainId, actor->actorId, actor->topicId
+                    , actor->participantId
+                    , actor->type, actor->callback.c_str()
+                    , pubsub_qos, drdw_qos, in_transport_seq, in_csp_bin);
+      image.actors.push_back(dActor);
+    }
   }
 
   um_->pushImage(image);
 }
 
-void
-PersistenceUpdater::create(const UTopic& topic)
-{
-  // serialize the Topic QOS
-  TAO_OutputCDR outCdr;
-  outCdr << topic.topicQos;
-  ACE_Message_Block dst;
-  ACE_CDR::consolidate(&dst, outCdr.begin());
-
-  size_t len = dst.length();
-  char *buf;
-  ACE_NEW_NORETURN(buf, char[len]);
-  ArrDelAdapter<char> guard(buf);
-
-  if (buf == 0) {
-    ACE_ERROR((LM_ERROR,
-               ACE_TEXT("PersistenceUpdater::create( UTopic): allocation failed.\n")));
-    return;
+namespace {
+  template <typename T>
+  std::string serialize(const T& value)
+  {
+    TAO_OutputCDR outCdr;
+    outCdr << value;
+    ACE_Message_Block dst;
+    ACE_CDR::consolidate(&dst, outCdr.begin());
+    return std::string(dst.base(), dst.length());
   }
 
-  ACE_OS::memcpy(buf, dst.base(), len);
-
-  BinSeq qos_bin(len, buf);
-
-  QosSeq p(TopicQos, qos_bin);
-  DTopic topic_data(topic.domainId, topic.topicId, topic.participantId
-                    , topic.name.c_str(), topic.dataType.c_str(), p);
-
-  // allocate memory for TopicData
-  void* buffer;
-  ACE_ALLOCATOR(buffer, allocator_->malloc
-                (sizeof(PersistenceUpdater::Topic)));
-
-  // Initialize TopicData
-  PersistenceUpdater::Topic* persistent_data
-  = new(buffer) PersistenceUpdater::Topic(topic_data, allocator_.get());
-
-  IdType_ExtId ext(topic_data.topicId);
-
-  // bind TopicData with the topicId
-  if (topic_index_->bind(ext, persistent_data, allocator_.get()) != 0) {
-    allocator_->free((void *) buffer);
-    return;
+  Update::BinSeq to_bin(const std::string& data)
+  {
+    return Update::BinSeq(data.size(), const_cast<char*>(data.data()));
   }
 }
 
-void
-PersistenceUpdater::create(const UParticipant& participant)
+PersistenceUpdater::PendingEntity&
+PersistenceUpdater::pending_entity(const IdType& id, ItemType type)
 {
-  // serialize the Topic QOS
-  TAO_OutputCDR outCdr;
-  outCdr << participant.participantQos;
-  ACE_Message_Block dst;
-  ACE_CDR::consolidate(&dst, outCdr.begin());
-
-  size_t len = dst.length();
-  char *buf;
-  ACE_NEW_NORETURN(buf, char[len]);
-  ArrDelAdapter<char> guard(buf);
-
-  if (buf == 0) {
-    ACE_ERROR((LM_ERROR,
-               ACE_TEXT("PersistenceUpdater::create( UParticipant): allocation failed.\n")));
-    return;
-  }
-
-  ACE_OS::memcpy(buf, dst.base(), len);
-
-  BinSeq qos_bin(len, buf);
-
-  QosSeq p(ParticipantQos, qos_bin);
-  DParticipant participant_data
-  (participant.domainId, participant.owner, participant.participantId, p);
-
-  // allocate memory for ParticipantData
-  void* buffer;
-  ACE_ALLOCATOR(buffer, allocator_->malloc
-                (sizeof(PersistenceUpdater::Participant)));
-
-  // Initialize ParticipantData
-  PersistenceUpdater::Participant* persistent_data
-  = new(buffer) PersistenceUpdater::Participant(participant_data
-                                                , allocator_.get());
-
-  IdType_ExtId ext(participant_data.participantId);
-
-  // bind ParticipantData with the participantId
-  if (participant_index_->bind(ext, persistent_data, allocator_.get()) != 0) {
-    allocator_->free((void *) buffer);
-    return;
-  }
+  PendingEntity& entity = pending_[id];
+  entity.type = type;
+  return entity;
 }
 
 void
-PersistenceUpdater::create(const URActor& actor)
+PersistenceUpdater::submitted()
 {
-  TAO_OutputCDR outCdr;
-  outCdr << actor.pubsubQos;
-  ACE_Message_Block dst;
-  ACE_CDR::consolidate(&dst, outCdr.begin());
-
-  size_t len = dst.length();
-  char *buf = new (std::nothrow) char[len];
-
-  if (buf == 0) {
-    ACE_ERROR((LM_ERROR, "PersistenceUpdater::create( subscription): allocation failed.\n"));
-    return;
+  if (flush_interval_ == ACE_Time_Value::zero) {
+    flush();
   }
+}
 
-  ArrDelAdapter<char> guard(buf);
-
-  ACE_OS::memcpy(buf, dst.base(), len);
-
-  BinSeq pubsub_qos_bin(len, buf);
-  QosSeq pubsub_qos(SubscriberQos, pubsub_qos_bin);
-
-  outCdr.reset();
-  outCdr << actor.drdwQos;
-  ACE_Message_Block dst2;
-  ACE_CDR::consolidate(&dst2, outCdr.begin());
-
-  len = dst2.length();
-  char *buf2 = new (std::nothrow) char[len];
-
-  if (buf2 == 0) {
-    ACE_ERROR((LM_ERROR, "PersistenceUpdater::create( subscription): allocation failed.\n"));
-    return;
+void
+PersistenceUpdater::enqueue(const IdType& id, ItemType type,
+                            PendingSlot slot, const std::string& data)
+{
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, queue_lock_);
+    pending_entity(id, type).slots[slot] = data;
   }
+  submitted();
+}
 
-  ArrDelAdapter<char> guard2(buf2);
-
-  ACE_OS::memcpy(buf2, dst2.base(), len);
-
-  BinSeq dwdr_qos_bin(len, buf2);
-  QosSeq dwdr_qos(DataReaderQos, dwdr_qos_bin);
-
-  outCdr.reset();
-  outCdr << actor.transportInterfaceInfo;
-  ACE_Message_Block dst3;
-  ACE_CDR::consolidate(&dst3, outCdr.begin());
-
-  len = dst3.length();
-  char *buf3 = new (std::nothrow) char[len];
-
-  if (buf3 == 0) {
-    ACE_ERROR((LM_ERROR, "PersistenceUpdater::create( subscription) allocation failed.\n"));
-    return;
+void
+PersistenceUpdater::create(const UTopic& topic)
+{
+  const std::string qos = serialize(topic.topicQos);
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, queue_lock_);
+    PendingEntity& entity = pending_entity(topic.topicId, Update::Topic);
+    entity.create = true;
+    entity.domainId = topic.domainId;
+    entity.participantId = topic.participantId;
+    entity.name = topic.name;
+    entity.dataType = topic.dataType;
+    entity.slots[TOPIC_QOS] = qos;
   }
+  submitted();
+}
 
-  ArrDelAdapter<char> guard3(buf3);
-
-  ACE_OS::memcpy(buf3, dst3.base(), len);
-  BinSeq tr_bin(len, buf3);
-
-  outCdr.reset();
-  outCdr << actor.contentSubscriptionProfile.exprParams;
-  ACE_Message_Block dst4;
-  ACE_CDR::consolidate(&dst4, outCdr.begin());
-  len = dst4.length();
-  char* buf4 = new (std::nothrow) char[len];
-  if (buf4 == 0) {
-    ACE_ERROR((LM_ERROR, "PersistenceUpdater::create( subscription) allocation failed.\n"));
-    return;
+void
+PersistenceUpdater::create(const UParticipant& participant)
+{
+  const std::string qos = serialize(participant.participantQos);
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, queue_lock_);
+    PendingEntity& entity =
+      pending_entity(participant.participantId, Update::Participant);
+    entity.create = true;
+    entity.domainId = participant.domainId;
+    entity.owner = participant.owner;
+    entity.slots[PARTICIPANT_QOS] = qos;
   }
-  ArrDelAdapter<char> guard4(buf4);
-
-  ACE_OS::memcpy(buf4, dst4.base(), len);
-  ContentSubscriptionBin csp_bin;
-  csp_bin.filterClassName = actor.contentSubscriptionProfile.filterClassName;
-  csp_bin.filterExpr = actor.contentSubscriptionProfile.filterExpr;
-  csp_bin.exprParams = std::make_pair(len, buf4);
-
-  DActor actor_data(actor.domainId, actor.actorId, actor.topicId
-                    , actor.participantId
-                    , DataReader, actor.callback.c_str(), pubsub_qos
-                    , dwdr_qos, tr_bin, csp_bin);
-
-  // allocate memory for ActorData
-  void* buffer;
-  ACE_ALLOCATOR(buffer, allocator_->malloc
-                (sizeof(PersistenceUpdater::RWActor)));
-
-  // Initialize ActorData
-  PersistenceUpdater::RWActor* persistent_data =
-    new(buffer) PersistenceUpdater::RWActor(actor_data
-                                            , allocator_.get());
-
-  IdType_ExtId ext(actor.actorId);
+  submitted();
+}
 
-  // bind ActorData with the actorId
-  if (actor_index_->bind(ext, persistent_data, allocator_.get()) != 0) {
-    allocator_->free((void *) buffer);
-    return;
+void
+PersistenceUpdater::create(const URActor& actor)
+{
+  const std::string pubsub_qos = serialize(actor.pubsubQos);
+  const std::string drdw_qos = serialize(actor.drdwQos);
+  const std::string transport = serialize(actor.transportInterfaceInfo);
+  const std::string expr_params =
+    serialize(actor.contentSubscriptionProfile.exprParams);
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, queue_lock_);
+    PendingEntity& entity = pending_entity(actor.actorId, Update::Actor);
+    entity.create = true;
+    entity.domainId = actor.domainId;
+    entity.topicId = actor.topicId;
+    entity.participantId = actor.participantId;
+    entity.actorType = DataReader;
+    entity.callback = actor.callback;
+    entity.pubsubKind = SubscriberQos;
+    entity.drdwKind = DataReaderQos;
+    entity.filterClassName = actor.contentSubscriptionProfile.filterClassName.in();
+    entity.filterExpr = actor.contentSubscriptionProfile.filterExpr.in();
+    entity.slots[PUBSUB_QOS] = pubsub_qos;
+    entity.slots[DRDW_QOS] = drdw_qos;
+    entity.slots[TRANSPORT] = transport;
+    entity.slots[EXPR_PARAMS] = expr_params;
   }
+  submitted();
 }
 
 void
 PersistenceUpdater::create(const UWActor& actor)
 {
-  TAO_OutputCDR outCdr;
-  outCdr << actor.pubsubQos;
-  ACE_Message_Block dst;
-  ACE_CDR::consolidate(&dst, outCdr.begin());
-
-  size_t len = dst.length();
-  char *buf = new (std::nothrow) char[len];
-
-  if (buf == 0) {
-    ACE_ERROR((LM_ERROR, "PersistenceUpdater::create( publication): allocation failed.\n"));
-    return;
-  }
-
-  ArrDelAdapter<char> guard(buf);
-
-  ACE_OS::memcpy(buf, dst.base(), len);
-
-  BinSeq pubsub_qos_bin(len, buf);
-  QosSeq pubsub_qos(PublisherQos, pubsub_qos_bin);
-
-  outCdr.reset();
-  outCdr << actor.drdwQos;
-  ACE_Message_Block dst2;
-  ACE_CDR::consolidate(&dst2, outCdr.begin());
-
-  len = dst2.length();
-  char *buf2 = new (std::nothrow) char[len];
-
-  if (buf2 == 0) {
-    ACE_ERROR((LM_ERROR, "PersistenceUpdater::create( publication): allocation failed.\n"));
-    return;
-  }
-
-  ArrDelAdapter<char> guard2(buf2);
-
-  ACE_OS::memcpy(buf2, dst2.base(), len);
-
-  BinSeq dwdr_qos_bin(len, buf2);
-  QosSeq dwdr_qos(DataWriterQos, dwdr_qos_bin);
-
-  outCdr.reset();
-  outCdr << actor.transportInterfaceInfo;
-  ACE_Message_Block dst3;
-  ACE_CDR::consolidate(&dst3, outCdr.begin());
-
-  len = dst3.length();
-  char *buf3 = new (std::nothrow) char[len];
-
-  if (buf3 == 0) {
-    ACE_ERROR((LM_ERROR, "PersistenceUpdater::create( publication): allocation failed.\n"));
-    return;
-  }
-
-  ArrDelAdapter<char> guard3(buf3);
-
-  ACE_OS::memcpy(buf3, dst3.base(), len);
-  BinSeq tr_bin(len, buf3);
-
-  DActor actor_data(actor.domainId, actor.actorId, actor.topicId
-                    , actor.participantId
-                    , DataWriter, actor.callback.c_str(), pubsub_qos
-                    , dwdr_qos, tr_bin, ContentSubscriptionBin());
-
-  // allocate memory for ActorData
-  void* buffer;
-  ACE_ALLOCATOR(buffer, allocator_->malloc
-                (sizeof(PersistenceUpdater::RWActor)));
-
-  // Initialize ActorData
-  PersistenceUpdater::RWActor* persistent_data =
-    new(buffer) PersistenceUpdater::RWActor(actor_data
-                                            , allocator_.get());
-
-  IdType_ExtId ext(actor.actorId);
-
-  // bind ActorData with the actorId
-  if (actor_index_->bind(ext, persistent_data, allocator_.get()) != 0) {
-    allocator_->free((void *) buffer);
-    return;
+  const std::string pubsub_qos = serialize(actor.pubsubQos);
+  const std::string drdw_qos = serialize(actor.drdwQos);
+  const std::string transport = serialize(actor.transportInterfaceInfo);
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, queue_lock_);
+    PendingEntity& entity = pending_entity(actor.actorId, Update::Actor);
+    entity.create = true;
+    entity.domainId = actor.domainId;
+    entity.topicId = actor.topicId;
+    entity.participantId = actor.participantId;
+    entity.actorType = DataWriter;
+    entity.callback = actor.callback;
+    entity.pubsubKind = PublisherQos;
+    entity.drdwKind = DataWriterQos;
+    entity.slots[PUBSUB_QOS] = pubsub_qos;
+    entity.slots[DRDW_QOS] = drdw_qos;
+    entity.slots[TRANSPORT] = transport;
   }
+  submitted();
 }
 
 void
@@ -832,168 +759,219 @@ PersistenceUpdater::create(const OwnershipData& /* data */)
 void
 PersistenceUpdater::update(const IdPath& id, const DDS::DomainParticipantQos& qos)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::Participant* part_data = 0;
-
-  if (this->participant_index_->find(ext, part_data, this->allocator_.get()) ==  0) {
-    TAO_OutputCDR outCdr;
-    outCdr << qos;
-    ACE_Message_Block dst;
-    ACE_CDR::consolidate(&dst, outCdr.begin());
-
-    this->storeUpdate(dst, part_data->participantQos.second);
-
-  } else {
-    OpenDDS::DCPS::RepoIdConverter converter(id.id);
-    ACE_ERROR((LM_ERROR,
-               ACE_TEXT("(%P|%t) PersistenceUpdater::update: ")
-               ACE_TEXT("participant %C not found\n"),
-               std::string(converter).c_str()));
-  }
+  enqueue(id.id, Update::Participant, PARTICIPANT_QOS, serialize(qos));
 }
 
 void
 PersistenceUpdater::update(const IdPath& id, const DDS::TopicQos& qos)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::Topic* topic_data = 0;
-
-  if (this->topic_index_->find(ext, topic_data, this->allocator_.get()) ==  0) {
-    TAO_OutputCDR outCdr;
-    outCdr << qos;
-    ACE_Message_Block dst;
-    ACE_CDR::consolidate(&dst, outCdr.begin());
-
-    this->storeUpdate(dst, topic_data->topicQos.second);
-
-  } else {
-    OpenDDS::DCPS::RepoIdConverter converter(id.id);
-    ACE_ERROR((LM_ERROR,
-               ACE_TEXT("(%P|%t) PersistenceUpdater::update: ")
-               ACE_TEXT("topic %C not found\n"),
-               std::string(converter).c_str()));
-  }
+  enqueue(id.id, Update::Topic, TOPIC_QOS, serialize(qos));
 }
 
 void
 PersistenceUpdater::update(const IdPath& id, const DDS::DataWriterQos& qos)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::RWActor* actor_data = 0;
-
-  if (this->actor_index_->find(ext, actor_data, this->allocator_.get()) ==  0) {
-    TAO_OutputCDR outCdr;
-    outCdr << qos;
-    ACE_Message_Block dst;
-    ACE_CDR::consolidate(&dst, outCdr.begin());
-
-    this->storeUpdate(dst, actor_data->drdwQos.second);
-
-  } else {
-    OpenDDS::DCPS::RepoIdConverter converter(id.id);
-    ACE_ERROR((LM_ERROR,
-               ACE_TEXT("(%P|%t) PersistenceUpdater::update(writerQos): ")
-               ACE_TEXT("publication %C not found\n"),
-               std::string(converter).c_str()));
-  }
+  enqueue(id.id, Update::Actor, DRDW_QOS, serialize(qos));
 }
 
 void
 PersistenceUpdater::update(const IdPath& id, const DDS::PublisherQos& qos)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::RWActor* actor_data = 0;
-
-  if (this->actor_index_->find(ext, actor_data, this->allocator_.get()) ==  0) {
-    TAO_OutputCDR outCdr;
-    outCdr << qos;
-    ACE_Message_Block dst;
-    ACE_CDR::consolidate(&dst, outCdr.begin());
-
-    this->storeUpdate(dst, actor_data->pubsubQos.second);
-
-  } else {
-    OpenDDS::DCPS::RepoIdConverter converter(id.id);
-    ACE_ERROR((LM_ERROR,
-               ACE_TEXT("(%P|%t) PersistenceUpdater::update(publisherQos): ")
-               ACE_TEXT("publication %C not found\n"),
-               std::string(converter).c_str()));
-  }
+  enqueue(id.id, Update::Actor, PUBSUB_QOS, serialize(qos));
 }
 
 void
 PersistenceUpdater::update(const IdPath& id, const DDS::DataReaderQos& qos)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::RWActor* actor_data = 0;
+  enqueue(id.id, Update::Actor, DRDW_QOS, serialize(qos));
+}
 
-  if (this->actor_index_->find(ext, actor_data, this->allocator_.get()) ==  0) {
-    TAO_OutputCDR outCdr;
-    outCdr << qos;
-    ACE_Message_Block dst;
-    ACE_CDR::consolidate(&dst, outCdr.begin());
+void
+PersistenceUpdater::update(const IdPath& id, const DDS::SubscriberQos& qos)
+{
+  enqueue(id.id, Update::Actor, PUBSUB_QOS, serialize(qos));
+}
 
-    this->storeUpdate(dst, actor_data->drdwQos.second);
+void
+PersistenceUpdater::update(const IdPath& id, const DDS::StringSeq& exprParams)
+{
+  enqueue(id.id, Update::Actor, EXPR_PARAMS, serialize(exprParams));
+}
 
-  } else {
-    OpenDDS::DCPS::RepoIdConverter converter(id.id);
-    ACE_ERROR((LM_ERROR,
-               ACE_TEXT("(%P|%t) PersistenceUpdater::update(readerQos): ")
-               ACE_TEXT("subscription %C not found\n"),
-               std::string(converter).c_str()));
+void
+PersistenceUpdater::destroy(const IdPath& id, ItemType type, ActorType)
+{
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, queue_lock_);
+    const PendingMap::iterator it = pending_.find(id.id);
+    if (it != pending_.end() && it->second.create) {
+      // Never written to the store, so only an earlier destroy remains.
+      if (it->second.destroy) {
+        it->second.create = false;
+        it->second.slots.clear();
+      } else {
+        pending_.erase(it);
+      }
+      return;
+    }
+    PendingEntity& entity = pending_entity(id.id, type);
+    entity.destroy = true;
+    entity.slots.clear();
   }
+  submitted();
 }
 
 void
-PersistenceUpdater::update(const IdPath& id, const DDS::SubscriberQos& qos)
+PersistenceUpdater::store(const IdType& id, const PendingEntity& entity)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::RWActor* actor_data = 0;
+  if (entity.destroy) {
+    store_destroy(id, entity.type);
+  }
 
-  if (this->actor_index_->find(ext, actor_data, this->allocator_.get()) ==  0) {
-    TAO_OutputCDR outCdr;
-    outCdr << qos;
-    ACE_Message_Block dst;
-    ACE_CDR::consolidate(&dst, outCdr.begin());
+  if (entity.create) {
+    store_create(id, entity);
+  }
 
-    this->storeUpdate(dst, actor_data->pubsubQos.second);
+  if (entity.destroy || entity.create) {
+    return;
+  }
 
-  } else {
-    OpenDDS::DCPS::RepoIdConverter converter(id.id);
-    ACE_ERROR((LM_ERROR,
-               ACE_TEXT("(%P|%t) PersistenceUpdater::update(subscriberQos): ")
-               ACE_TEXT("subscription %C not found\n"),
-               std::string(converter).c_str()));
+  IdType_ExtId ext(id);
+  for (SlotMap::const_iterator slot = entity.slots.begin();
+       slot != entity.slots.end(); ++slot) {
+    BinSeq* storage = 0;
+
+    if (slot->first == PARTICIPANT_QOS) {
+      PersistenceUpdater::Participant* part_data = 0;
+      if (participant_index_->find(ext, part_data, allocator_.get()) == 0) {
+        storage = &part_data->participantQos.second;
+      }
+
+    } else if (slot->first == TOPIC_QOS) {
+      PersistenceUpdater::Topic* topic_data = 0;
+      if (topic_index_->find(ext, topic_data, allocator_.get()) == 0) {
+        storage = &topic_data->topicQos.second;
+      }
+
+    } else {
+      PersistenceUpdater::RWActor* actor_data = 0;
+      if (actor_index_->find(ext, actor_data, allocator_.get()) == 0) {
+        switch (slot->first) {
+        case PUBSUB_QOS:
+          storage = &actor_data->pubsubQos.second;
+          break;
+        case DRDW_QOS:
+          storage = &actor_data->drdwQos.second;
+          break;
+        case EXPR_PARAMS:
+          storage = &actor_data->contentSubscriptionProfile.exprParams;
+          break;
+        default:
+          break;
+        }
+      }
+    }
+
+    if (storage) {
+      storeUpdate(slot->second, *storage);
+
+    } else {
+      OpenDDS::DCPS::RepoIdConverter converter(id);
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("(%P|%t) PersistenceUpdater::store: ")
+                 ACE_TEXT("entity %C not found for update\n"),
+                 std::string(converter).c_str()));
+    }
   }
 }
 
 void
-PersistenceUpdater::update(const IdPath& id, const DDS::StringSeq& exprParams)
+PersistenceUpdater::store_create(const IdType& id, const PendingEntity& entity)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::RWActor* actor_data = 0;
+  const SlotMap& slots = entity.slots;
+  IdType_ExtId ext(id);
+
+  switch (entity.type) {
+  case Update::Topic: {
+    QosSeq p(TopicQos, to_bin(slots.find(TOPIC_QOS)->second));
+    DTopic topic_data(entity.domainId, id, entity.participantId
+                      , entity.name.c_str(), entity.dataType.c_str(), p);
+
+    // allocate memory for TopicData
+    void* buffer;
+    ACE_ALLOCATOR(buffer, allocator_->malloc
+                  (sizeof(PersistenceUpdater::Topic)));
+
+    // Initialize TopicData
+    PersistenceUpdater::Topic* persistent_data
+    = new(buffer) PersistenceUpdater::Topic(topic_data, allocator_.get());
+
+    // bind TopicData with the topicId
+    if (topic_index_->bind(ext, persistent_data, allocator_.get()) != 0) {
+      allocator_->free((void *) buffer);
+    }
+    break;
+  }
+  case Update::Participant: {
+    QosSeq p(ParticipantQos, to_bin(slots.find(PARTICIPANT_QOS)->second));
+    DParticipant participant_data(entity.domainId, entity.owner, id, p);
+
+    // allocate memory for ParticipantData
+    void* buffer;
+    ACE_ALLOCATOR(buffer, allocator_->malloc
+                  (sizeof(PersistenceUpdater::Participant)));
+
+    // Initialize ParticipantData
+    PersistenceUpdater::Participant* persistent_data
+    = new(buffer) PersistenceUpdater::Participant(participant_data
+                                                  , allocator_.get());
+
+    // bind ParticipantData with the participantId
+    if (participant_index_->bind(ext, persistent_data, allocator_.get()) != 0) {
+      allocator_->free((void *) buffer);
+    }
+    break;
+  }
+  case Update::Actor: {
+    QosSeq pubsub_qos(entity.pubsubKind, to_bin(slots.find(PUBSUB_QOS)->second));
+    QosSeq drdw_qos(entity.drdwKind, to_bin(slots.find(DRDW_QOS)->second));
+    const BinSeq tr_bin = to_bin(slots.find(TRANSPORT)->second);
+
+    ContentSubscriptionBin csp_bin;
+    if (entity.actorType == DataReader) {
+      csp_bin.filterClassName = entity.filterClassName.c_str();
+      csp_bin.filterExpr = entity.filterExpr.c_str();
+      csp_bin.exprParams = to_bin(slots.find(EXPR_PARAMS)->second);
+    }
 
-  if (actor_index_->find(ext, actor_data, allocator_.get()) ==  0) {
-    TAO_OutputCDR outCdr;
-    outCdr << exprParams;
-    ACE_Message_Block dst;
-    ACE_CDR::consolidate(&dst, outCdr.begin());
+    DActor actor_data(entity.domainId, id, entity.topicId
+                      , entity.participantId
+                      , entity.actorType, entity.callback.c_str(), pubsub_qos
+                      , drdw_qos, tr_bin, csp_bin);
 
-    storeUpdate(dst, actor_data->contentSubscriptionProfile.exprParams);
+    // allocate memory for ActorData
+    void* buffer;
+    ACE_ALLOCATOR(buffer, allocator_->malloc
+                  (sizeof(PersistenceUpdater::RWActor)));
 
-  } else {
-    OpenDDS::DCPS::RepoIdConverter converter(id.id);
-    ACE_ERROR((LM_ERROR,
-               ACE_TEXT("(%P|%t) PersistenceUpdater::update(readerQos): ")
-               ACE_TEXT("subscription %C not found\n"),
-               std::string(converter).c_str()));
+    // Initialize ActorData
+    PersistenceUpdater::RWActor* persistent_data =
+      new(buffer) PersistenceUpdater::RWActor(actor_data
+                                              , allocator_.get());
+
+    // bind ActorData with the actorId
+    if (actor_index_->bind(ext, persistent_data, allocator_.get()) != 0) {
+      allocator_->free((void *) buffer);
+    }
+    break;
+  }
   }
 }
 
 void
-PersistenceUpdater::destroy(const IdPath& id, ItemType type, ActorType)
+PersistenceUpdater::store_destroy(const IdType& id, ItemType type)
 {
-  IdType_ExtId ext(id.id);
+  IdType_ExtId ext(id);
   PersistenceUpdater::Topic* topic = 0;
   PersistenceUpdater::Participant* participant = 0;
   PersistenceUpdater::RWActor* actor = 0;
@@ -1024,7 +1002,7 @@ PersistenceUpdater::destroy(const IdPath& id, ItemType type, ActorType)
 
     break;
   default: {
-    OpenDDS::DCPS::RepoIdConverter converter(id.id);
+    OpenDDS::DCPS::RepoIdConverter converter(id);
     ACE_ERROR((LM_ERROR,
                ACE_TEXT("(%P | %t) PersistenceUpdater::destroy: ")
                ACE_TEXT("unknown entity - %C.\n"),
@@ -1034,13 +1012,16 @@ PersistenceUpdater::destroy(const IdPath& id, ItemType type, ActorType)
 }
 
 void
-PersistenceUpdater::storeUpdate(const ACE_Message_Block& data, BinSeq& storage)
+PersistenceUpdater::storeUpdate(const std::string& data, BinSeq& storage)
 {
-  size_t len = data.length();
+  size_t len = data.size();
 
   void* buffer;
   ACE_ALLOCATOR(buffer, this->allocator_->malloc(len));
-  ACE_OS::memcpy(buffer, data.base(), len);
+  ACE_OS::memcpy(buffer, data.data(), len);
+
+  // The previous value was allocated from the same store.
+  this->allocator_->free(storage.second);
 
   storage.first  = len;
   storage.second = static_cast<char*>(buffer);
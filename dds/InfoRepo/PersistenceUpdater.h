@@ -15,6 +15,8 @@
 #include "dds/DCPS/unique_ptr.h"
 
 #include "ace/Task.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Condition_Thread_Mutex.h"
 #include "ace/Hash_Map_With_Allocator_T.h"
 #include "ace/Malloc_T.h"
 #include "ace/MMAP_Memory_Pool.h"
@@ -22,6 +24,7 @@
 #include "ace/Service_Config.h"
 
 #include <string>
+#include <map>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -99,13 +102,80 @@ public:
   /// Remove an entity (but not children) from persistence.
   virtual void destroy(const IdPath& id, ItemType type, ActorType actor);
 
+  /// Write all pending changes to the persistent store.
+  void flush();
+
+  /// Number of entities with changes that have not been written yet.
+  size_t pending();
+
 private:
+  /// Serialized values that can be pending for an entity.
+  enum PendingSlot {
+    PARTICIPANT_QOS, TOPIC_QOS, PUBSUB_QOS, DRDW_QOS, TRANSPORT, EXPR_PARAMS
+  };
+  typedef std::map<PendingSlot, std::string> SlotMap;
+
+  /// Changes to one entity that have not been written to the store yet.
+  /// Everything is held in serialized form so it outlives the request that
+  /// produced it.  Repeated updates of the same value replace each other and
+  /// a destroy cancels a create that was never written.
+  struct PendingEntity {
+    PendingEntity();
+
+    ItemType type;
+    bool create;
+    bool destroy;
+
+    // Only meaningful if create is set
+    DomainIdType domainId;
+    long owner;
+    IdType topicId;
+    IdType participantId;
+    ActorType actorType;
+    std::string name;
+    std::string dataType;
+    std::string callback;
+    std::string filterClassName;
+    std::string filterExpr;
+    SpecificQos pubsubKind;
+    SpecificQos drdwKind;
+
+    SlotMap slots;
+  };
+  typedef std::map<IdType, PendingEntity,
+                   OpenDDS::DCPS::GUID_tKeyLessThan> PendingMap;
+
   int parse(int argc, ACE_TCHAR *argv[]);
-  void storeUpdate(const ACE_Message_Block& data, BinSeq& storage);
+  void storeUpdate(const std::string& data, BinSeq& storage);
+
+  /// Queue a change, writing it out immediately if there is no flush interval.
+  void enqueue(const IdType& id, ItemType type, PendingSlot slot,
+               const std::string& data);
+  PendingEntity& pending_entity(const IdType& id, ItemType type);
+  void submitted();
+
+  /// Apply the changes for one entity to the store, store_lock_ must be held.
+  void store(const IdType& id, const PendingEntity& entity);
+  void store_create(const IdType& id, const PendingEntity& entity);
+  void store_destroy(const IdType& id, ItemType type);
 
   ACE_TString persistence_file_;
   bool reset_;
 
+  /// How long changes may be held before being written, zero writes each
+  /// change as it is made.
+  ACE_Time_Value flush_interval_;
+
+  /// Protects pending_ and shutdown_.
+  ACE_Thread_Mutex queue_lock_;
+  ACE_Condition_Thread_Mutex queue_cond_;
+  PendingMap pending_;
+  bool shutdown_;
+
+  /// Serializes flushes and all access to the store, acquired before
+  /// queue_lock_ when both are needed.
+  ACE_Thread_Mutex store_lock_;
+
   Manager *um_;
 
   OpenDDS::DCPS::unique_ptr<ALLOCATOR> allocator_;
@@ -0,0 +1,28 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+package OpenDDS.DCPS;
+
+/**
+ * Subscribes to a topic without a registered type and passes each sample to
+ * a RawSampleListener in serialized form.  Created by
+ * TheServiceParticipant.create_recorder.
+ */
+public class RawRecorder {
+
+    private long _jni_pointer;
+
+    RawRecorder(long ptr) {
+        _jni_pointer = ptr;
+    }
+
+    private native void _jni_fini();
+
+    protected void finalize() {
+        _jni_fini();
+    }
+}
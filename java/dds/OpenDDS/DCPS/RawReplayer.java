@@ -0,0 +1,45 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+package OpenDDS.DCPS;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Publishes samples that are already serialized, such as the ones a
+ * RawRecorder receives.  Created by TheServiceParticipant.create_replayer.
+ */
+public class RawReplayer {
+
+    private long _jni_pointer;
+
+    RawReplayer(long ptr) {
+        _jni_pointer = ptr;
+    }
+
+    private native void _jni_fini();
+
+    protected void finalize() {
+        _jni_fini();
+    }
+
+    /**
+     * Writes the serialized sample between the position and the limit of
+     * data, which must be a direct buffer.  The bytes are copied, so data can
+     * be reused as soon as this returns.
+     * @return a DDS.RETCODE_* value
+     */
+    public int write(ByteBuffer data, boolean littleEndian,
+                     int sourceSec, int sourceNanosec) {
+        return write_i(data, data.position(), data.remaining(), littleEndian,
+                       sourceSec, sourceNanosec);
+    }
+
+    private native int write_i(ByteBuffer data, int offset, int length,
+                               boolean littleEndian, int sourceSec,
+                               int sourceNanosec);
+}
@@ -0,0 +1,24 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+package OpenDDS.DCPS;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Receives the serialized samples of a RawRecorder.
+ */
+public interface RawSampleListener {
+
+    /**
+     * Called for each sample the recorder receives.  data is a direct
+     * buffer over the received sample and is only valid until this method
+     * returns; copy out of it to keep the sample.
+     */
+    void on_sample(ByteBuffer data, boolean littleEndian,
+                   int sourceSec, int sourceNanosec);
+}
@@ -7,7 +7,12 @@
 
 package OpenDDS.DCPS;
 
+import DDS.DataReaderQos;
+import DDS.DataWriterQos;
 import DDS.DomainParticipant;
+import DDS.PublisherQos;
+import DDS.SubscriberQos;
+import DDS.Topic;
 
 public final class TheServiceParticipant {
 
@@ -22,4 +27,16 @@ public final class TheServiceParticipant {
     public static native void set_repo_ior(String ior, String repo);
 
     public static native String get_unique_id(DomainParticipant participant);
+
+    public static native RawRecorder create_recorder(
+        DomainParticipant participant, Topic topic, SubscriberQos sub_qos,
+        DataReaderQos dr_qos, RawSampleListener listener);
+
+    public static native int delete_recorder(RawRecorder recorder);
+
+    public static native RawReplayer create_replayer(
+        DomainParticipant participant, Topic topic, PublisherQos pub_qos,
+        DataWriterQos dw_qos);
+
+    public static native int delete_replayer(RawReplayer replayer);
 }
@@ -7,6 +7,8 @@
 
 #include "OpenDDS_DCPS_TheParticipantFactory.h"
 #include "OpenDDS_DCPS_TheServiceParticipant.h"
+#include "OpenDDS_DCPS_RawRecorder.h"
+#include "OpenDDS_DCPS_RawReplayer.h"
 #include "OpenDDS_DCPS_transport_TheTransportRegistry.h"
 #include "OpenDDS_DCPS_transport_TransportConfig.h"
 #include "OpenDDS_DCPS_transport_TcpInst.h"
@@ -21,6 +23,9 @@
 #include "OpenDDS_jni_helpers.h"
 
 #include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/Recorder.h"
+#include "dds/DCPS/Replayer.h"
+#include "dds/DCPS/GuidUtils.h"
 
 #include "dds/DCPS/transport/framework/TransportRegistry.h"
 #include "dds/DCPS/transport/framework/TransportImpl.h"
@@ -43,6 +48,8 @@
 #include "dds/DCPS/GuardCondition.h"
 
 #include "DdsDcpsDomainJC.h"
+#include "DdsDcpsInfrastructureJC.h"
+#include "DdsDcpsTopicJC.h"
 #include "DdsDcpsPublicationJC.h"
 #include "DdsDcpsSubscriptionJC.h"
 
@@ -134,6 +141,199 @@ jstring JNICALL Java_OpenDDS_DCPS_TheServiceParticipant_get_1unique_1id
   return retStr;
 }
 
+// Raw (serialized) sample access through the Recorder and Replayer
+
+namespace {
+
+/// Passes each sample a Recorder receives to a Java RawSampleListener as a
+/// direct ByteBuffer over the received data.
+class JavaRawSampleListener : public OpenDDS::DCPS::RecorderListener {
+public:
+  JavaRawSampleListener(JNIEnv *jni, jobject listener)
+    : listener_(jni->NewGlobalRef(listener))
+    , cl_(jni->NewGlobalRef(getContextClassLoader(jni)))
+    , on_sample_(0)
+  {
+    jclass clazz = jni->GetObjectClass(listener);
+    on_sample_ = jni->GetMethodID(clazz, "on_sample",
+                                  "(Ljava/nio/ByteBuffer;ZII)V");
+    jni->DeleteLocalRef(clazz);
+    jni->GetJavaVM(&jvm_);
+  }
+
+  ~JavaRawSampleListener()
+  {
+    JNIThreadAttacher jta(jvm_);
+    jta.getJNI()->DeleteGlobalRef(listener_);
+    jta.getJNI()->DeleteGlobalRef(cl_);
+  }
+
+  void on_sample_data_received(OpenDDS::DCPS::Recorder *,
+                               const OpenDDS::DCPS::RawDataSample &sample)
+  {
+    const ACE_Message_Block *data = sample.sample_.get();
+    OpenDDS::DCPS::Message_Block_Ptr consolidated;
+
+    if (data->cont()) {
+      // A ByteBuffer has to be contiguous
+      consolidated.reset(new ACE_Message_Block(data->total_length()));
+      for (const ACE_Message_Block *b = data; b; b = b->cont()) {
+        consolidated->copy(b->rd_ptr(), b->length());
+      }
+      data = consolidated.get();
+    }
+
+    JNIThreadAttacher jta(jvm_, cl_);
+    JNIEnv *jni = jta.getJNI();
+    jobject buffer = jni->NewDirectByteBuffer(data->rd_ptr(), data->length());
+    jni->CallVoidMethod(listener_, on_sample_, buffer,
+                        sample.sample_byte_order_ ? JNI_TRUE : JNI_FALSE,
+                        sample.source_timestamp_.sec,
+                        static_cast<jint>(sample.source_timestamp_.nanosec));
+    jni->DeleteLocalRef(buffer);
+
+    if (jni->ExceptionCheck()) {
+      jni->ExceptionDescribe();
+      jni->ExceptionClear();
+    }
+  }
+
+  void on_recorder_matched(OpenDDS::DCPS::Recorder *,
+                           const DDS::SubscriptionMatchedStatus &)
+  {
+  }
+
+private:
+  jobject listener_;
+  jobject cl_;
+  jmethodID on_sample_;
+  JavaVM *jvm_;
+};
+
+} // namespace
+
+jobject JNICALL Java_OpenDDS_DCPS_TheServiceParticipant_create_1recorder
+(JNIEnv * jni, jclass, jobject participant, jobject topic, jobject sub_qos,
+ jobject dr_qos, jobject listener)
+{
+  try {
+    DDS::DomainParticipant_var part;
+    copyToCxx(jni, part, participant);
+    DDS::Topic_var cxx_topic;
+    copyToCxx(jni, cxx_topic, topic);
+    DDS::SubscriberQos cxx_sub_qos;
+    copyToCxx(jni, cxx_sub_qos, sub_qos);
+    DDS::DataReaderQos cxx_dr_qos;
+    copyToCxx(jni, cxx_dr_qos, dr_qos);
+
+    const OpenDDS::DCPS::RecorderListener_rch cxx_listener =
+      OpenDDS::DCPS::make_rch<JavaRawSampleListener>(jni, listener);
+    OpenDDS::DCPS::Recorder_var recorder =
+      TheServiceParticipant->create_recorder(part, cxx_topic, cxx_sub_qos,
+                                             cxx_dr_qos, cxx_listener);
+    if (!recorder) {
+      return 0;
+    }
+
+    jclass clazz = findClass(jni, "OpenDDS/DCPS/RawRecorder");
+    jmethodID ctor = jni->GetMethodID(clazz, "<init>", "(J)V");
+    return jni->NewObject(clazz, ctor, reinterpret_cast<jlong>(recorder._retn()));
+
+  } catch (const CORBA::SystemException &se) {
+    throw_java_exception(jni, se);
+    return 0;
+  }
+}
+
+jint JNICALL Java_OpenDDS_DCPS_TheServiceParticipant_delete_1recorder
+(JNIEnv * jni, jclass, jobject recorder)
+{
+  return TheServiceParticipant->delete_recorder(
+    recoverCppObj<OpenDDS::DCPS::Recorder>(jni, recorder));
+}
+
+jobject JNICALL Java_OpenDDS_DCPS_TheServiceParticipant_create_1replayer
+(JNIEnv * jni, jclass, jobject participant, jobject topic, jobject pub_qos,
+ jobject dw_qos)
+{
+  try {
+    DDS::DomainParticipant_var part;
+    copyToCxx(jni, part, participant);
+    DDS::Topic_var cxx_topic;
+    copyToCxx(jni, cxx_topic, topic);
+    DDS::PublisherQos cxx_pub_qos;
+    copyToCxx(jni, cxx_pub_qos, pub_qos);
+    DDS::DataWriterQos cxx_dw_qos;
+    copyToCxx(jni, cxx_dw_qos, dw_qos);
+
+    OpenDDS::DCPS::Replayer_var replayer =
+      TheServiceParticipant->create_replayer(part, cxx_topic, cxx_pub_qos,
+                                             cxx_dw_qos,
+                                             OpenDDS::DCPS::ReplayerListener_rch());
+    if (!replayer) {
+      return 0;
+    }
+
+    jclass clazz = findClass(jni, "OpenDDS/DCPS/RawReplayer");
+    jmethodID ctor = jni->GetMethodID(clazz, "<init>", "(J)V");
+    return jni->NewObject(clazz, ctor, reinterpret_cast<jlong>(replayer._retn()));
+
+  } catch (const CORBA::SystemException &se) {
+    throw_java_exception(jni, se);
+    return 0;
+  }
+}
+
+jint JNICALL Java_OpenDDS_DCPS_TheServiceParticipant_delete_1replayer
+(JNIEnv * jni, jclass, jobject replayer)
+{
+  return TheServiceParticipant->delete_replayer(
+    recoverCppObj<OpenDDS::DCPS::Replayer>(jni, replayer));
+}
+
+// RawRecorder::_jni_fini
+void JNICALL Java_OpenDDS_DCPS_RawRecorder__1jni_1fini
+(JNIEnv * jni, jobject jthis)
+{
+  // takes over the reference returned by create_recorder
+  OpenDDS::DCPS::Recorder_var recorder =
+    recoverCppObj<OpenDDS::DCPS::Recorder>(jni, jthis);
+}
+
+// RawReplayer::_jni_fini
+void JNICALL Java_OpenDDS_DCPS_RawReplayer__1jni_1fini
+(JNIEnv * jni, jobject jthis)
+{
+  // takes over the reference returned by create_replayer
+  OpenDDS::DCPS::Replayer_var replayer =
+    recoverCppObj<OpenDDS::DCPS::Replayer>(jni, jthis);
+}
+
+// RawReplayer::write_i
+jint JNICALL Java_OpenDDS_DCPS_RawReplayer_write_1i
+(JNIEnv * jni, jobject jthis, jobject data, jint offset, jint length,
+ jboolean littleEndian, jint sourceSec, jint sourceNanosec)
+{
+  OpenDDS::DCPS::Replayer* replayer =
+    recoverCppObj<OpenDDS::DCPS::Replayer>(jni, jthis);
+  const char *address =
+    static_cast<const char*>(jni->GetDirectBufferAddress(data));
+  if (!replayer || !address || offset < 0 || length < 0) {
+    return DDS::RETCODE_BAD_PARAMETER;
+  }
+
+  // The transport may hold on to the sample after write() returns (for
+  // durability or retransmission), so it can't refer to the Java buffer.
+  OpenDDS::DCPS::Message_Block_Ptr block(new ACE_Message_Block(length));
+  block->copy(address + offset, length);
+
+  const OpenDDS::DCPS::RawDataSample sample(OpenDDS::DCPS::SAMPLE_DATA,
+                                            sourceSec, sourceNanosec,
+                                            OpenDDS::DCPS::GUID_UNKNOWN,
+                                            littleEndian, block.get());
+  return replayer->write(sample);
+}
+
 // Exception translation
 
 #define TRANSPORT_EXCEPTION(NAME)                                       \
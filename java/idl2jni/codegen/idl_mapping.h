@@ -160,7 +160,8 @@ private:
   bool gen_jarray_copies(UTL_ScopedName *name, const std::string &jvmSig,
                          const std::string &jniFn, const std::string &jniType,
                          const std::string &jniArrayType, const std::string &taoTypeName,
-                         bool sequence, const std::string &length, bool elementIsObjref = false);
+                         bool sequence, const std::string &length, bool elementIsObjref = false,
+                         const std::string &elementCxx = "");
 };
 
 #endif
@@ -355,7 +355,7 @@ namespace {
 struct commonSetup {
   ostream &hfile;
   ostream &cppfile;
-  string sigToCxx, sigToJava, cxx, exporter;
+  string sigToCxx, sigToJava, cxx, exporter, declPrefix;
 
   explicit commonSetup(UTL_ScopedName *name, const char *java = "jobject",
                        bool useVar = false, bool skipDefault = false, bool useCxxRef = true)
@@ -367,6 +367,7 @@ struct commonSetup {
     ACE_CString ace_exporter = be_global->stub_export_macro();
     bool use_exp = ace_exporter != "";
     exporter = use_exp ? (string(" ") + ace_exporter.c_str()) : "";
+    declPrefix = use_exp ? (string(ace_exporter.c_str()) + "\n") : "";
     sigToCxx =
       "void copyToCxx (JNIEnv *jni, " + cxx + (useCxxRef ? " &" : " ")
       + "target, " + java + " source)";
@@ -374,11 +375,24 @@ struct commonSetup {
       "void copyToJava (JNIEnv *jni, " + string(java) + " &target, const "
       + cxx + (useCxxRef ? " &" : " ") + "source, bool createNewObject";
     hfile <<
-    ace_exporter << (use_exp ? "\n" : "") << sigToCxx << ";\n" <<
-    ace_exporter << (use_exp ? "\n" : "") << sigToJava <<
+    declPrefix << sigToCxx << ";\n" <<
+    declPrefix << sigToJava <<
     (skipDefault ? "" : " = false") << ");\n";
     sigToJava += ')';
   }
+
+  /// Declares javaClass(), which finds this type's Java class through the
+  /// JavaClassCache named cache, so arrays of it don't look it up again.
+  void javaClass(const string &cache) {
+    const string sig =
+      "jclass javaClass (JNIEnv *jni, const " + cxx + " *)";
+    hfile << declPrefix << sig << ";\n";
+    cppfile <<
+    sig << "\n"
+    "{\n"
+    "  return " << cache << ".find (jni);\n"
+    "}\n\n";
+  }
 };
 
 bool isPrimitive(AST_Type *element)
@@ -439,21 +453,30 @@ bool idl_mapping_jni::gen_enum(UTL_ScopedName *name,
                                const std::vector<AST_EnumVal *> &, const char *)
 {
   commonSetup c(name);
-  string enumJVMsig = scoped_helper(name, "/");
+  string enumJVMsig = scoped_helper(name, "/"),
+         cache = "_jcc_" + scoped_helper(name, "_");
+  c.cppfile <<
+  "namespace {\n"
+  "  const char *const " << cache << "_fields[] = {\"_value\"};\n"
+  "  const char *const " << cache << "_sigs[] = {\"I\"};\n"
+  "  JavaClassCache " << cache << " (\"" << enumJVMsig << "\", \"from_int\", "
+  "\"(I)L" << enumJVMsig << ";\", true, 1, " << cache << "_fields, "
+  << cache << "_sigs);\n"
+  "}\n\n";
+  c.javaClass(cache);
   c.cppfile <<
   c.sigToCxx << "\n"
   "{\n"
   "  jclass clazz = jni->GetObjectClass (source);\n"
-  "  jfieldID fid = jni->GetFieldID (clazz, \"_value\", \"I\");\n"
+  "  jfieldID fid = " << cache << ".ids (jni, clazz).fields[0];\n"
   "  target = static_cast<" << c.cxx
   << "> (jni->GetIntField (source, fid));\n"
   "}\n\n" <<
   c.sigToJava << "\n"
   "{\n"
   "  ACE_UNUSED_ARG (createNewObject);\n"
-  "  jclass clazz = findClass (jni, \"" << enumJVMsig << "\");\n"
-  "  jmethodID factory = jni->GetStaticMethodID (clazz, \"from_int\", "
-  "\"(I)L" << enumJVMsig << ";\");\n"
+  "  jclass clazz = " << cache << ".find (jni);\n"
+  "  jmethodID factory = " << cache << ".ids (jni, clazz).method;\n"
   "  target = jni->CallStaticObjectMethod (clazz, factory, source);\n"
   "}\n\n";
   return true;
@@ -463,15 +486,19 @@ bool idl_mapping_jni::gen_struct(UTL_ScopedName *name,
                                  const std::vector<AST_Field*> &fields, const char *)
 {
   commonSetup c(name);
-  string fieldsToCxx, fieldsToJava;
+  string fieldsToCxx, fieldsToJava, fieldNames, fieldSigs,
+         cache = "_jcc_" + scoped_helper(name, "_");
 
   for (size_t i = 0; i < fields.size(); ++i) {
+    ostringstream index;
+    index << i;
     string fname = fields[i]->local_name()->get_string(),
                    jvmSig = jvmSignature(fields[i]->field_type()),   // "I"
                             jniFn = jniFnName(fields[i]->field_type()),   // "Int"
                                     fieldID =
-                                      "    jfieldID fid = jni->GetFieldID (clazz, \"" + fname + "\", \""
-                                      + jvmSig + "\");\n";
+                                      "    jfieldID fid = _ids.fields[" + index.str() + "];\n";
+    fieldNames += string(i ? ", " : "") + "\"" + fname + "\"";
+    fieldSigs += string(i ? ", " : "") + "\"" + jvmSig + "\"";
     fieldsToCxx += "  {\n" + fieldID;
     fieldsToJava += "  {\n" + fieldID;
 
@@ -518,10 +545,24 @@ bool idl_mapping_jni::gen_struct(UTL_ScopedName *name,
 
   string structJVMsig = scoped_helper(name, "/");
 
+  if (fields.empty()) {
+    fieldNames = fieldSigs = "0";
+  }
+
+  c.cppfile <<
+  "namespace {\n"
+  "  const char *const " << cache << "_fields[] = {" << fieldNames << "};\n"
+  "  const char *const " << cache << "_sigs[] = {" << fieldSigs << "};\n"
+  "  JavaClassCache " << cache << " (\"" << structJVMsig << "\", \"<init>\", "
+  "\"()V\", false, " << fields.size() << ", " << cache << "_fields, "
+  << cache << "_sigs);\n"
+  "}\n\n";
+  c.javaClass(cache);
   c.cppfile <<
   c.sigToCxx << "\n"
   "{\n"
-  "  jclass clazz = jni->GetObjectClass (source);\n" <<
+  "  jclass clazz = jni->GetObjectClass (source);\n"
+  "  const JavaClassCache::Ids &_ids = " << cache << ".ids (jni, clazz);\n" <<
   fieldsToCxx <<
   "}\n\n" <<
   c.sigToJava << "\n"
@@ -529,13 +570,16 @@ bool idl_mapping_jni::gen_struct(UTL_ScopedName *name,
   "  jclass clazz;\n"
   "  if (createNewObject)\n"
   "    {\n"
-  "      clazz = findClass (jni, \"" << structJVMsig << "\");\n"
-  "      jmethodID ctor = jni->GetMethodID (clazz, \"<init>\", \"()V\");\n"
-  "      target = jni->NewObject (clazz, ctor);\n"
+  "      clazz = " << cache << ".find (jni);\n"
   "    }\n"
   "  else\n"
   "    {\n"
   "      clazz = jni->GetObjectClass (target);\n"
+  "    }\n"
+  "  const JavaClassCache::Ids &_ids = " << cache << ".ids (jni, clazz);\n"
+  "  if (createNewObject)\n"
+  "    {\n"
+  "      target = jni->NewObject (clazz, _ids.method);\n"
   "    }\n" <<
   fieldsToJava <<
   "}\n\n";
@@ -588,24 +632,41 @@ bool idl_mapping_jni::gen_typedef(UTL_ScopedName *name, AST_Type *base,
     length = oss.str();
   }
 
+  // structs and enums cache their Java class, see commonSetup::javaClass
+  AST_Type *resolved = element;
+
+  if (resolved->node_type() == AST_Decl::NT_typedef) {
+    resolved = AST_Typedef::narrow_from_decl(resolved)->primitive_base_type();
+  }
+
+  const bool cached = resolved->node_type() == AST_Decl::NT_struct
+    || resolved->node_type() == AST_Decl::NT_enum;
+
   return gen_jarray_copies(name, jvmSignature(element), jniFnName(element),
                            type(element), type(base), taoType(element),
                            sequence, length,
                            element->node_type() == AST_Decl::NT_interface ||
-                           element->node_type() == AST_Decl::NT_interface_fwd);
+                           element->node_type() == AST_Decl::NT_interface_fwd,
+                           cached ? scoped(resolved->name()) : "");
 }
 
 bool idl_mapping_jni::gen_jarray_copies(UTL_ScopedName *name,
                                         const string &jvmSig, const string &jniFn, const string &jniType,
                                         const string &jniArrayType, const string &taoTypeName, bool sequence,
-                                        const string &length, bool elementIsObjref /* = false */)
+                                        const string &length, bool elementIsObjref /* = false */,
+                                        const string &elementCxx /* = "" */)
 {
   commonSetup c(name, jniArrayType.c_str(), false, false);
   string preLoop, postLoopCxx, postLoopJava, preNewArray, newArrayExtra,
   loopCxx, loopJava, actualJniType = jniType,
                                      resizeCxx = sequence ? "  target.length (len);\n" : "";
+  bool bulk = false, reuseElements = false;
 
-  if (jvmSig.size() == 1) { //primitive type
+  if (jvmSig.size() == 1 && jvmSig != "C" && jvmSig != "Z") {
+    // same size and representation in C++ and Java, copy the whole region
+    bulk = true;
+
+  } else if (jvmSig.size() == 1) { //primitive type
     preLoop =
       "  " + jniType + " *buf = jni->Get" + jniFn
       + "ArrayElements (arr, 0);\n";
@@ -679,9 +740,11 @@ bool idl_mapping_jni::gen_jarray_copies(UTL_ScopedName *name,
 
       loopCxx =
         "      jobject obj = jni->GetObjectArrayElement (arr, i);\n";
+      // elements of the old array are reused even if its length changed
+      reuseElements = true;
       loopJava =
-        "      jobject obj = createNewObject ? 0 : "
-        "jni->GetObjectArrayElement (arr, i);\n";
+        "      jobject obj = i < static_cast<CORBA::ULong> (oldLen) ? "
+        "jni->GetObjectArrayElement (old, i) : 0;\n";
 
       if (useVar) {
         loopJava +=
@@ -696,8 +759,10 @@ bool idl_mapping_jni::gen_jarray_copies(UTL_ScopedName *name,
         loopJava += ";\n";
       }
 
-      preNewArray =
-        "      jclass clazz = findClass (jni, \"" + jvmClass + "\");\n";
+      preNewArray = elementCxx.empty() ?
+        "      jclass clazz = findClass (jni, \"" + jvmClass + "\");\n" :
+        "      jclass clazz = javaClass (jni, static_cast<const "
+        + elementCxx + " *> (0));\n";
     }
 
     newArrayExtra = ", clazz, 0";
@@ -706,7 +771,7 @@ bool idl_mapping_jni::gen_jarray_copies(UTL_ScopedName *name,
       "      jni->DeleteLocalRef (obj);\n";
     loopJava +=
       "      copyToJava (jni, obj, " + string(useVar ? "var" : "source[i]")
-      + ", createNewObject);\n"
+      + (reuseElements ? ", !obj);\n" : ", createNewObject);\n")
       "      jni->SetObjectArrayElement (arr, i, obj);\n"
       "      jni->DeleteLocalRef (obj);\n";
   }
@@ -714,9 +779,21 @@ bool idl_mapping_jni::gen_jarray_copies(UTL_ScopedName *name,
   ostringstream toJavaBody;
   toJavaBody <<
   "  jsize len = " << length << ";\n"
-  "  " << actualJniType << "Array arr;\n"
-  "  if (!createNewObject && jni->GetArrayLength (target) != len) "
-  "createNewObject = true;\n"
+  "  " << actualJniType << "Array arr;\n";
+
+  if (reuseElements) {
+    toJavaBody <<
+    "  " << actualJniType << "Array old = createNewObject ? 0 : target;\n"
+    "  jsize oldLen = createNewObject ? 0 : jni->GetArrayLength (old);\n"
+    "  if (oldLen != len) createNewObject = true;\n";
+
+  } else {
+    toJavaBody <<
+    "  if (!createNewObject && jni->GetArrayLength (target) != len) "
+    "createNewObject = true;\n";
+  }
+
+  toJavaBody <<
   "  if (createNewObject)\n"
   "    {\n"
   << preNewArray <<
@@ -725,26 +802,47 @@ bool idl_mapping_jni::gen_jarray_copies(UTL_ScopedName *name,
   "  else\n"
   "    {\n"
   "      arr = target;\n"
-  "    }\n"
-  << preLoop <<
-  "  for (CORBA::ULong i = 0; i < static_cast<CORBA::ULong> (len); ++i)\n"
-  "    {\n"
-  << loopJava <<
-  "    }\n"
-  << postLoopJava <<
-  "  target = arr;\n";
+  "    }\n";
 
   ostringstream toCxxBody;
   toCxxBody <<
   "  " << actualJniType << "Array arr = source;\n"
   "  jsize len = jni->GetArrayLength (arr);\n"
-  << resizeCxx
-  << preLoop <<
-  "  for (CORBA::ULong i = 0; i < static_cast<CORBA::ULong> (len); ++i)\n"
-  "    {\n"
-  << loopCxx <<
-  "    }\n"
-  << postLoopCxx;
+  << resizeCxx;
+
+  if (bulk) {
+    toJavaBody <<
+    "  if (len > 0)\n"
+    "    {\n"
+    "      jni->Set" << jniFn << "ArrayRegion (arr, 0, len, "
+    "reinterpret_cast<const " << jniType << " *> (&source[0]));\n"
+    "    }\n";
+    toCxxBody <<
+    "  if (len > 0)\n"
+    "    {\n"
+    "      jni->Get" << jniFn << "ArrayRegion (arr, 0, len, "
+    "reinterpret_cast<" << jniType << " *> (&target[0]));\n"
+    "    }\n";
+
+  } else {
+    toJavaBody
+    << preLoop <<
+    "  for (CORBA::ULong i = 0; i < static_cast<CORBA::ULong> (len); ++i)\n"
+    "    {\n"
+    << loopJava <<
+    "    }\n"
+    << postLoopJava;
+    toCxxBody
+    << preLoop <<
+    "  for (CORBA::ULong i = 0; i < static_cast<CORBA::ULong> (len); ++i)\n"
+    "    {\n"
+    << loopCxx <<
+    "    }\n"
+    << postLoopCxx;
+  }
+
+  toJavaBody <<
+  "  target = arr;\n";
 
   c.cppfile <<
   c.sigToCxx << "\n"
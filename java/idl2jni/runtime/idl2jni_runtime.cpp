@@ -35,6 +35,20 @@ jstring binary_name(JNIEnv *jni, const char *desc)
 
   return jni->NewStringUTF(name.c_str());
 }
+
+jclass loadClass(JNIEnv *jni, jobject cl, const char *desc)
+{
+  if (cl == 0) return jni->FindClass(desc);
+
+  jclass cls = jni->GetObjectClass(cl);
+  jmethodID mid = jni->GetMethodID(cls,
+    "loadClass", "(Ljava/lang/String;)Ljava/lang/Class;");
+  jni->DeleteLocalRef(cls);
+  jstring name = binary_name(jni, desc);
+  jclass result = reinterpret_cast<jclass>(jni->CallObjectMethod(cl, mid, name));
+  jni->DeleteLocalRef(name);
+  return result;
+}
 }
 
 JStringMgr::JStringMgr(JNIEnv* jni, jstring input)
@@ -176,14 +190,9 @@ void setContextClassLoader(JNIEnv *jni, jobject cl)
 jclass findClass(JNIEnv *jni, const char *desc)
 {
   jobject cl = getContextClassLoader(jni);
-
-  if (cl == 0) return jni->FindClass(desc);
-
-  jclass cls = jni->GetObjectClass(cl);
-  jmethodID mid = jni->GetMethodID(cls,
-    "loadClass", "(Ljava/lang/String;)Ljava/lang/Class;");
-  return reinterpret_cast<jclass>
-         (jni->CallObjectMethod(cl, mid, binary_name(jni, desc)));
+  jclass result = loadClass(jni, cl, desc);
+  if (cl != 0) jni->DeleteLocalRef(cl);
+  return result;
 }
 
 #define HOLDER_PRIMITIVE(JNI_T, JNIFN, SIG)                                   \
@@ -405,3 +414,151 @@ IDL2JNI_BaseJavaPeer::~IDL2JNI_BaseJavaPeer()
   jta.getJNI()->DeleteGlobalRef(globalCallback_);
   jta.getJNI()->DeleteGlobalRef(cl_);
 }
+
+JavaClassCache::JavaClassCache(const char *desc, const char *method,
+                               const char *methodSig, bool isStatic,
+                               size_t fieldCount, const char *const *fields,
+                               const char *const *fieldSigs)
+  : desc_(desc)
+  , method_(method)
+  , methodSig_(methodSig)
+  , isStatic_(isStatic)
+  , fieldCount_(fieldCount)
+  , fields_(fields)
+  , fieldSigs_(fieldSigs)
+  , ids_(0)
+  , loaded_(0)
+{
+}
+
+JavaClassCache::~JavaClassCache()
+{
+  // The weak global references are left to the JVM, there may not be a
+  // JNIEnv for this thread while static objects are being destroyed.
+  for (Loaded *l = loadedHead(); l != 0;) {
+    Loaded *next = l->next;
+    delete l;
+    l = next;
+  }
+
+  for (Ids *i = idsHead(); i != 0;) {
+    Ids *next = i->next;
+    delete i;
+    i = next;
+  }
+}
+
+JavaClassCache::Ids *JavaClassCache::idsHead()
+{
+#ifdef ACE_HAS_CPP11
+  return ids_.load(std::memory_order_acquire);
+#else
+  ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+  return ids_;
+#endif
+}
+
+JavaClassCache::Loaded *JavaClassCache::loadedHead()
+{
+#ifdef ACE_HAS_CPP11
+  return loaded_.load(std::memory_order_acquire);
+#else
+  ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+  return loaded_;
+#endif
+}
+
+const JavaClassCache::Ids *JavaClassCache::findIds(JNIEnv *jni, jclass clazz)
+{
+  for (const Ids *i = idsHead(); i != 0; i = i->next) {
+    if (jni->IsSameObject(i->clazz, clazz)) return i;
+  }
+
+  return 0;
+}
+
+const JavaClassCache::Ids &JavaClassCache::ids(JNIEnv *jni, jclass clazz)
+{
+  const Ids *found = findIds(jni, clazz);
+
+  if (found != 0) return *found;
+
+  Ids *ids = new Ids;
+  ids->clazz = jni->NewWeakGlobalRef(clazz);
+  ids->method = isStatic_
+    ? jni->GetStaticMethodID(clazz, method_, methodSig_)
+    : jni->GetMethodID(clazz, method_, methodSig_);
+  ids->fields.reserve(fieldCount_);
+
+  for (size_t i = 0; i < fieldCount_; ++i) {
+    ids->fields.push_back(jni->GetFieldID(clazz, fields_[i], fieldSigs_[i]));
+  }
+
+  ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+
+  // Another thread may have added the same class in the meantime.
+#ifdef ACE_HAS_CPP11
+  Ids *head = ids_.load(std::memory_order_relaxed);
+#else
+  Ids *head = ids_;
+#endif
+
+  for (const Ids *i = head; i != 0; i = i->next) {
+    if (jni->IsSameObject(i->clazz, clazz)) {
+      jni->DeleteWeakGlobalRef(ids->clazz);
+      delete ids;
+      return *i;
+    }
+  }
+
+  ids->next = head;
+#ifdef ACE_HAS_CPP11
+  ids_.store(ids, std::memory_order_release);
+#else
+  ids_ = ids;
+#endif
+  return *ids;
+}
+
+jclass JavaClassCache::find(JNIEnv *jni)
+{
+  jobject cl = getContextClassLoader(jni);
+
+  for (const Loaded *l = loadedHead(); l != 0; l = l->next) {
+    // A weak reference to a collected loader compares equal to null, so
+    // the null loader only matches entries made without one.
+    const bool match = cl == 0 ? l->loader == 0
+      : l->loader != 0 && jni->IsSameObject(l->loader, cl);
+
+    if (match) {
+      jobject local = jni->NewLocalRef(l->ids->clazz);
+
+      if (local != 0) {
+        if (cl != 0) jni->DeleteLocalRef(cl);
+        return static_cast<jclass>(local);
+      }
+
+      break; // unloaded, newer entries come first so look it up again
+    }
+  }
+
+  jclass clazz = loadClass(jni, cl, desc_);
+
+  if (clazz != 0) {
+    Loaded *loaded = new Loaded;
+    loaded->loader = cl == 0 ? 0 : jni->NewWeakGlobalRef(cl);
+    loaded->ids = const_cast<Ids *>(&ids(jni, clazz));
+
+    ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+#ifdef ACE_HAS_CPP11
+    loaded->next = loaded_.load(std::memory_order_relaxed);
+    loaded_.store(loaded, std::memory_order_release);
+#else
+    loaded->next = loaded_;
+    loaded_ = loaded;
+#endif
+  }
+
+  if (cl != 0) jni->DeleteLocalRef(cl);
+  return clazz;
+}
@@ -14,10 +14,16 @@
 #include "tao/Basic_Types.h"
 
 #include "ace/Global_Macros.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Guard_T.h"
 
 #include <vector>
 #include <string>
 
+#ifdef ACE_HAS_CPP11
+#include <atomic>
+#endif
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace TAO {
@@ -268,6 +274,75 @@ struct idl2jni_runtime_Export JniArgv {
   }
 };
 
+/// Class, method and field IDs for one generated Java type, looked up
+/// the first time they are needed instead of on every copy.  Classes are
+/// held through weak global references so they can still be unloaded.
+/// There is one entry per distinct class (a type loaded by several class
+/// loaders has several), and find() remembers which class each context
+/// class loader resolved the type to.  Entries are only ever added, so
+/// with C++11 lookups don't take the lock; without it they fall back to
+/// the lock.
+class idl2jni_runtime_Export JavaClassCache {
+public:
+  struct Ids {
+    jweak clazz;
+    jmethodID method;
+    std::vector<jfieldID> fields;
+    Ids *next;
+  };
+
+  /// method is either a constructor ("<init>") or, if isStatic, a static
+  /// factory method.  fields and fieldSigs hold fieldCount entries.
+  JavaClassCache(const char *desc, const char *method, const char *methodSig,
+                 bool isStatic, size_t fieldCount, const char *const *fields,
+                 const char *const *fieldSigs);
+  ~JavaClassCache();
+
+  /// IDs for clazz, which must be the class named by desc.
+  const Ids &ids(JNIEnv *jni, jclass clazz);
+
+  /// Local reference to the class named by desc as seen by the current
+  /// thread's context class loader, found through that loader the first
+  /// time and whenever the class it returned has been unloaded.
+  jclass find(JNIEnv *jni);
+
+private:
+  /// Class found through one context class loader, loader is 0 for
+  /// threads without one.
+  struct Loaded {
+    jweak loader;
+    Ids *ids;
+    Loaded *next;
+  };
+
+  const Ids *findIds(JNIEnv *jni, jclass clazz);
+  Ids *idsHead();
+  Loaded *loadedHead();
+
+  const char *desc_;
+  const char *method_;
+  const char *methodSig_;
+  bool isStatic_;
+  size_t fieldCount_;
+  const char *const *fields_;
+  const char *const *fieldSigs_;
+
+  /// Serializes adding entries and, without C++11, reading the heads.
+  /// Entries are never freed while the cache exists since callers may
+  /// still be using them.
+  ACE_Thread_Mutex lock_;
+#ifdef ACE_HAS_CPP11
+  std::atomic<Ids *> ids_;
+  std::atomic<Loaded *> loaded_;
+#else
+  Ids *ids_;
+  Loaded *loaded_;
+#endif
+
+  ACE_UNIMPLEMENTED_FUNC(JavaClassCache(const JavaClassCache &))
+  ACE_UNIMPLEMENTED_FUNC(JavaClassCache &operator=(const JavaClassCache &))
+};
+
 ///Local guard object for attaching a C++ thread to the JVM
 class idl2jni_runtime_Export JNIThreadAttacher {
 public:
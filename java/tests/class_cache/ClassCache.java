@@ -0,0 +1,177 @@
+import DDS.*;
+import OpenDDS.DCPS.*;
+import org.omg.CORBA.StringSeqHolder;
+import Messenger.*;
+
+/**
+ * Checks that the JNI class cache resolves generated types through each
+ * thread's context class loader once, and then reuses the result for that
+ * loader instead of asking it again on every copy.
+ */
+public class ClassCache {
+    private static final int N_READS = 20;
+
+    private static class CountingLoader extends ClassLoader {
+        private int messageLoads;
+
+        CountingLoader(ClassLoader parent) {
+            super(parent);
+        }
+
+        public Class<?> loadClass(String name) throws ClassNotFoundException {
+            if (name.equals("Messenger.Message")) {
+                ++messageLoads;
+            }
+            return super.loadClass(name);
+        }
+
+        int messageLoads() {
+            return messageLoads;
+        }
+    }
+
+    private static void fail(String message) {
+        System.err.println("ERROR: " + message);
+        System.exit(1);
+    }
+
+    public static void main(String[] args) {
+
+        DomainParticipantFactory dpf =
+            TheParticipantFactory.WithArgs(new StringSeqHolder(args));
+        if (dpf == null) {
+            fail("Domain Participant Factory not found");
+        }
+        DomainParticipant dp = dpf.create_participant(4,
+            PARTICIPANT_QOS_DEFAULT.get(), null, DEFAULT_STATUS_MASK.value);
+        if (dp == null) {
+            fail("Domain Participant creation failed");
+        }
+
+        MessageTypeSupportImpl servant = new MessageTypeSupportImpl();
+        if (servant.register_type(dp, "") != RETCODE_OK.value) {
+            fail("register_type failed");
+        }
+
+        Publisher pub = dp.create_publisher(PUBLISHER_QOS_DEFAULT.get(), null,
+                                            DEFAULT_STATUS_MASK.value);
+        Subscriber sub = dp.create_subscriber(SUBSCRIBER_QOS_DEFAULT.get(),
+                                              null, DEFAULT_STATUS_MASK.value);
+        if (pub == null || sub == null) {
+            fail("Publisher or Subscriber creation failed");
+        }
+
+        Topic top = dp.create_topic("Class Cache",
+                                    servant.get_type_name(),
+                                    TOPIC_QOS_DEFAULT.get(),
+                                    null,
+                                    DEFAULT_STATUS_MASK.value);
+        if (top == null) {
+            fail("Topic creation failed");
+        }
+
+        DataWriter dw = pub.create_datawriter(top,
+                                              DATAWRITER_QOS_DEFAULT.get(),
+                                              null,
+                                              DEFAULT_STATUS_MASK.value);
+        DataReader dr = sub.create_datareader(top,
+                                              DATAREADER_QOS_DEFAULT.get(),
+                                              null,
+                                              DEFAULT_STATUS_MASK.value);
+        if (dw == null || dr == null) {
+            fail("DataWriter or DataReader creation failed");
+        }
+
+        StatusCondition sc = dw.get_statuscondition();
+        sc.set_enabled_statuses(PUBLICATION_MATCHED_STATUS.value);
+        WaitSet ws = new WaitSet();
+        ws.attach_condition(sc);
+        PublicationMatchedStatusHolder matched =
+            new PublicationMatchedStatusHolder(new PublicationMatchedStatus());
+        Duration_t timeout = new Duration_t(DURATION_INFINITE_SEC.value,
+                                            DURATION_INFINITE_NSEC.value);
+
+        while (true) {
+            if (dw.get_publication_matched_status(matched)
+                != RETCODE_OK.value) {
+                fail("get_publication_matched_status() failed");
+            }
+
+            if (matched.value.current_count >= 1) {
+                break;
+            }
+
+            ConditionSeqHolder cond = new ConditionSeqHolder(new Condition[]{});
+            if (ws.wait(cond, timeout) != RETCODE_OK.value) {
+                fail("wait() failed");
+            }
+        }
+
+        ws.detach_condition(sc);
+
+        MessageDataWriter mdw = MessageDataWriterHelper.narrow(dw);
+        Message msg = new Message();
+        msg.subject_id = 99;
+        msg.from = "OpenDDS-Java";
+        msg.subject = "Review";
+        msg.text = "Class cache";
+        msg.count = 0;
+        if (mdw.write(msg, HANDLE_NIL.value) != RETCODE_OK.value) {
+            fail("write() failed");
+        }
+
+        ReadCondition rc = dr.create_readcondition(ANY_SAMPLE_STATE.value,
+                                                   ANY_VIEW_STATE.value,
+                                                   ANY_INSTANCE_STATE.value);
+        ws.attach_condition(rc);
+        ConditionSeqHolder cond = new ConditionSeqHolder(new Condition[]{});
+        if (ws.wait(cond, timeout) != RETCODE_OK.value) {
+            fail("DataReader wait() failed");
+        }
+        ws.detach_condition(rc);
+
+        // Each read creates new Message objects, which finds the class
+        // through the context class loader of the reading thread.
+        Thread thread = Thread.currentThread();
+        ClassLoader original = thread.getContextClassLoader();
+        CountingLoader[] loaders = {
+            new CountingLoader(original), new CountingLoader(original)
+        };
+
+        MessageDataReader mdr = MessageDataReaderHelper.narrow(dr);
+        for (int i = 0; i < N_READS; ++i) {
+            thread.setContextClassLoader(loaders[i % loaders.length]);
+            MessageSeqHolder mholder = new MessageSeqHolder(new Message[]{});
+            SampleInfoSeqHolder infoholder =
+                new SampleInfoSeqHolder(new SampleInfo[]{});
+            if (mdr.read_w_condition(mholder, infoholder,
+                                     LENGTH_UNLIMITED.value, rc)
+                != RETCODE_OK.value) {
+                fail("read_w_condition failed");
+            }
+            if (mholder.value.length != 1
+                || mholder.value[0].getClass() != Message.class
+                || !mholder.value[0].text.equals(msg.text)) {
+                fail("unexpected sample on read " + i);
+            }
+        }
+        thread.setContextClassLoader(original);
+
+        for (int i = 0; i < loaders.length; ++i) {
+            if (loaders[i].messageLoads() != 1) {
+                fail("context class loader " + i + " was asked for "
+                     + "Messenger.Message " + loaders[i].messageLoads()
+                     + " times, expected once");
+            }
+        }
+        System.out.println("Each context class loader was asked once");
+
+        dr.delete_readcondition(rc);
+
+        // Clean up
+        dp.delete_contained_entities();
+        dpf.delete_participant(dp);
+        TheServiceParticipant.shutdown();
+    }
+
+}
@@ -0,0 +1,311 @@
+import DDS.*;
+import OpenDDS.DCPS.*;
+import org.omg.CORBA.StringSeqHolder;
+import Messenger.*;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Records the samples of a DataWriter in partition "One" with a RawRecorder
+ * and writes them again with a RawReplayer in partition "Two", where a
+ * DataReader has to receive them unchanged.
+ */
+public class RecorderReplayer {
+    private static final int N_MSGS = 5;
+    private static final int TIMEOUT_MS = 30000;
+
+    /// Keeps a copy of each recorded sample, the buffer passed to
+    /// on_sample is only valid during the call.
+    private static class Recorded implements RawSampleListener {
+        private final ByteBuffer[] data = new ByteBuffer[N_MSGS];
+        private final boolean[] littleEndian = new boolean[N_MSGS];
+        private final int[] sourceSec = new int[N_MSGS];
+        private final int[] sourceNanosec = new int[N_MSGS];
+        private int count;
+        private String error;
+
+        public synchronized void on_sample(ByteBuffer buffer,
+                                           boolean isLittleEndian,
+                                           int sec, int nanosec) {
+            if (!buffer.isDirect()) {
+                error = "recorded sample is not a direct buffer";
+            } else if (count < N_MSGS) {
+                ByteBuffer copy = ByteBuffer.allocateDirect(buffer.remaining());
+                copy.put(buffer);
+                copy.flip();
+                data[count] = copy;
+                littleEndian[count] = isLittleEndian;
+                sourceSec[count] = sec;
+                sourceNanosec[count] = nanosec;
+                ++count;
+            }
+            notifyAll();
+        }
+
+        synchronized void waitFor(int n) throws InterruptedException {
+            long deadline = System.currentTimeMillis() + TIMEOUT_MS;
+            while (count < n && error == null) {
+                long remaining = deadline - System.currentTimeMillis();
+                if (remaining <= 0) {
+                    fail("recorded " + count + " of " + n + " samples");
+                }
+                wait(remaining);
+            }
+            if (error != null) {
+                fail(error);
+            }
+        }
+
+        synchronized void replay(RawReplayer replayer, int i) {
+            if (replayer.write(data[i], littleEndian[i], sourceSec[i],
+                               sourceNanosec[i]) != RETCODE_OK.value) {
+                fail("RawReplayer write() failed for sample " + i);
+            }
+        }
+    }
+
+    private static void fail(String message) {
+        System.err.println("ERROR: " + message);
+        System.exit(1);
+    }
+
+    private static PresentationQosPolicy presentation() {
+        PresentationQosPolicy presentation = new PresentationQosPolicy();
+        presentation.access_scope =
+            PresentationQosPolicyAccessScopeKind.INSTANCE_PRESENTATION_QOS;
+        return presentation;
+    }
+
+    private static PartitionQosPolicy partition(String name) {
+        PartitionQosPolicy partition = new PartitionQosPolicy();
+        partition.name = new String[] {name};
+        return partition;
+    }
+
+    private static GroupDataQosPolicy groupData() {
+        GroupDataQosPolicy group_data = new GroupDataQosPolicy();
+        group_data.value = new byte[0];
+        return group_data;
+    }
+
+    private static EntityFactoryQosPolicy entityFactory() {
+        EntityFactoryQosPolicy entity_factory = new EntityFactoryQosPolicy();
+        entity_factory.autoenable_created_entities = true;
+        return entity_factory;
+    }
+
+    private static PublisherQos publisherQos(String name) {
+        PublisherQos qos = new PublisherQos();
+        qos.presentation = presentation();
+        qos.partition = partition(name);
+        qos.group_data = groupData();
+        qos.entity_factory = entityFactory();
+        return qos;
+    }
+
+    private static SubscriberQos subscriberQos(String name) {
+        SubscriberQos qos = new SubscriberQos();
+        qos.presentation = presentation();
+        qos.partition = partition(name);
+        qos.group_data = groupData();
+        qos.entity_factory = entityFactory();
+        return qos;
+    }
+
+    private static void waitForMatch(DataWriter dw) {
+        PublicationMatchedStatusHolder matched =
+            new PublicationMatchedStatusHolder(new PublicationMatchedStatus());
+        long deadline = System.currentTimeMillis() + TIMEOUT_MS;
+        while (true) {
+            if (dw.get_publication_matched_status(matched)
+                != RETCODE_OK.value) {
+                fail("get_publication_matched_status() failed");
+            }
+            if (matched.value.current_count >= 1) {
+                return;
+            }
+            if (System.currentTimeMillis() > deadline) {
+                fail("the DataWriter was not matched with the recorder");
+            }
+            try {
+                Thread.sleep(100);
+            } catch (InterruptedException e) {
+            }
+        }
+    }
+
+    private static void waitForMatch(DataReader dr) {
+        SubscriptionMatchedStatusHolder matched =
+            new SubscriptionMatchedStatusHolder(new SubscriptionMatchedStatus());
+        long deadline = System.currentTimeMillis() + TIMEOUT_MS;
+        while (true) {
+            if (dr.get_subscription_matched_status(matched)
+                != RETCODE_OK.value) {
+                fail("get_subscription_matched_status() failed");
+            }
+            if (matched.value.current_count >= 1) {
+                return;
+            }
+            if (System.currentTimeMillis() > deadline) {
+                fail("the DataReader was not matched with the replayer");
+            }
+            try {
+                Thread.sleep(100);
+            } catch (InterruptedException e) {
+            }
+        }
+    }
+
+    public static void main(String[] args) throws InterruptedException {
+
+        DomainParticipantFactory dpf =
+            TheParticipantFactory.WithArgs(new StringSeqHolder(args));
+        if (dpf == null) {
+            fail("Domain Participant Factory not found");
+        }
+        DomainParticipant dp = dpf.create_participant(4,
+            PARTICIPANT_QOS_DEFAULT.get(), null, DEFAULT_STATUS_MASK.value);
+        if (dp == null) {
+            fail("Domain Participant creation failed");
+        }
+
+        MessageTypeSupportImpl servant = new MessageTypeSupportImpl();
+        if (servant.register_type(dp, "") != RETCODE_OK.value) {
+            fail("register_type failed");
+        }
+
+        Topic top = dp.create_topic("Recorder Replayer",
+                                    servant.get_type_name(),
+                                    TOPIC_QOS_DEFAULT.get(),
+                                    null,
+                                    DEFAULT_STATUS_MASK.value);
+        if (top == null) {
+            fail("Topic creation failed");
+        }
+
+        // Partition "One": DataWriter --> RawRecorder
+        Publisher pub = dp.create_publisher(publisherQos("One"), null,
+                                            DEFAULT_STATUS_MASK.value);
+        if (pub == null) {
+            fail("Publisher creation failed");
+        }
+        DataWriter dw = pub.create_datawriter(top,
+                                              DATAWRITER_QOS_DEFAULT.get(),
+                                              null,
+                                              DEFAULT_STATUS_MASK.value);
+        if (dw == null) {
+            fail("DataWriter creation failed");
+        }
+
+        Recorded recorded = new Recorded();
+        RawRecorder recorder =
+            TheServiceParticipant.create_recorder(dp, top,
+                                                  subscriberQos("One"),
+                                                  DATAREADER_QOS_DEFAULT.get(),
+                                                  recorded);
+        if (recorder == null) {
+            fail("create_recorder failed");
+        }
+
+        // Partition "Two": RawReplayer --> DataReader
+        RawReplayer replayer =
+            TheServiceParticipant.create_replayer(dp, top,
+                                                  publisherQos("Two"),
+                                                  DATAWRITER_QOS_DEFAULT.get());
+        if (replayer == null) {
+            fail("create_replayer failed");
+        }
+
+        Subscriber sub = dp.create_subscriber(subscriberQos("Two"), null,
+                                              DEFAULT_STATUS_MASK.value);
+        if (sub == null) {
+            fail("Subscriber creation failed");
+        }
+        DataReader dr = sub.create_datareader(top,
+                                              DATAREADER_QOS_DEFAULT.get(),
+                                              null,
+                                              DEFAULT_STATUS_MASK.value);
+        if (dr == null) {
+            fail("DataReader creation failed");
+        }
+
+        waitForMatch(dw);
+        waitForMatch(dr);
+
+        MessageDataWriter mdw = MessageDataWriterHelper.narrow(dw);
+        Message msg = new Message();
+        msg.from = "OpenDDS-Java";
+        msg.subject = "Review";
+        msg.text = "Recorded and replayed";
+        for (int i = 0; i < N_MSGS; ++i) {
+            // One instance each, so that KEEP_LAST history keeps them all
+            msg.subject_id = i;
+            msg.count = i;
+            if (mdw.write(msg, HANDLE_NIL.value) != RETCODE_OK.value) {
+                fail("write() failed");
+            }
+        }
+
+        recorded.waitFor(N_MSGS);
+        for (int i = 0; i < N_MSGS; ++i) {
+            recorded.replay(replayer, i);
+        }
+
+        // The DataReader only sees what the replayer wrote
+        MessageDataReader mdr = MessageDataReaderHelper.narrow(dr);
+        ReadCondition rc = dr.create_readcondition(ANY_SAMPLE_STATE.value,
+                                                   ANY_VIEW_STATE.value,
+                                                   ANY_INSTANCE_STATE.value);
+        WaitSet ws = new WaitSet();
+        ws.attach_condition(rc);
+        Duration_t timeout = new Duration_t(TIMEOUT_MS / 1000, 0);
+        boolean[] seen = new boolean[N_MSGS];
+        int received = 0;
+        while (received < N_MSGS) {
+            ConditionSeqHolder cond = new ConditionSeqHolder(new Condition[]{});
+            if (ws.wait(cond, timeout) != RETCODE_OK.value) {
+                fail("received " + received + " of " + N_MSGS + " samples");
+            }
+            MessageSeqHolder mholder = new MessageSeqHolder(new Message[]{});
+            SampleInfoSeqHolder infoholder =
+                new SampleInfoSeqHolder(new SampleInfo[]{});
+            if (mdr.take_w_condition(mholder, infoholder,
+                                     LENGTH_UNLIMITED.value, rc)
+                != RETCODE_OK.value) {
+                fail("take_w_condition failed");
+            }
+            for (int i = 0; i < mholder.value.length; ++i) {
+                if (!infoholder.value[i].valid_data) {
+                    continue;
+                }
+                Message m = mholder.value[i];
+                if (m.count < 0 || m.count >= N_MSGS || seen[m.count]
+                    || m.subject_id != m.count || !m.from.equals(msg.from)
+                    || !m.subject.equals(msg.subject)
+                    || !m.text.equals(msg.text)) {
+                    fail("unexpected replayed sample, count " + m.count
+                         + " text \"" + m.text + "\"");
+                }
+                seen[m.count] = true;
+                ++received;
+            }
+        }
+        ws.detach_condition(rc);
+        dr.delete_readcondition(rc);
+        System.out.println("Replayed " + received + " recorded samples");
+
+        // Clean up
+        if (TheServiceParticipant.delete_recorder(recorder)
+            != RETCODE_OK.value) {
+            fail("delete_recorder failed");
+        }
+        if (TheServiceParticipant.delete_replayer(replayer)
+            != RETCODE_OK.value) {
+            fail("delete_replayer failed");
+        }
+        dp.delete_contained_entities();
+        dpf.delete_participant(dp);
+        TheServiceParticipant.shutdown();
+    }
+
+}
@@ -9,6 +9,8 @@ export TRANSPORT_UDP=$BENCHBASE/tests/shared/transport-udp.ini
 export TRANSPORT_MCAST_BE=$BENCHBASE/tests/shared/transport-mcast-be.ini
 export TRANSPORT_MCAST_REL=$BENCHBASE/tests/shared/transport-mcast-rel.ini
 export TRANSPORT_RTPS=$BENCHBASE/tests/shared/transport-rtps.ini
+export TRANSPORT_RTPS_BUNDLE=$BENCHBASE/tests/shared/transport-rtps-bundle.ini
+export TRANSPORT_RTPS_SHMEM=$BENCHBASE/tests/shared/transport-rtps-shmem.ini
 
 mkdir -p data
 
@@ -225,3 +227,94 @@ $REDUCECMD $TESTBASE/run/1-16/rtps-latency-s13.data > data/1-16-rtps-rel-s13.gpd
 $REDUCECMD $TESTBASE/run/1-16/rtps-latency-s14.data > data/1-16-rtps-rel-s14.gpd
 $REDUCECMD $TESTBASE/run/1-16/rtps-latency-s15.data > data/1-16-rtps-rel-s15.gpd
 $REDUCECMD $TESTBASE/run/1-16/rtps-latency-s16.data > data/1-16-rtps-rel-s16.gpd
+
+$REDUCECMD $TESTBASE/run/1-1/rtps-bundle-latency-s1.data > data/1-1-rtps-bundle-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/2-1/rtps-bundle-latency-s1.data > data/2-1-rtps-bundle-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/4-1/rtps-bundle-latency-s1.data > data/4-1-rtps-bundle-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/8-1/rtps-bundle-latency-s1.data > data/8-1-rtps-bundle-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/16-1/rtps-bundle-latency-s1.data > data/16-1-rtps-bundle-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/1-2/rtps-bundle-latency-s1.data > data/1-2-rtps-bundle-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/1-2/rtps-bundle-latency-s2.data > data/1-2-rtps-bundle-rel-s2.gpd
+$REDUCECMD $TESTBASE/run/1-4/rtps-bundle-latency-s1.data > data/1-4-rtps-bundle-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/1-4/rtps-bundle-latency-s2.data > data/1-4-rtps-bundle-rel-s2.gpd
+$REDUCECMD $TESTBASE/run/1-4/rtps-bundle-latency-s3.data > data/1-4-rtps-bundle-rel-s3.gpd
+$REDUCECMD $TESTBASE/run/1-4/rtps-bundle-latency-s4.data > data/1-4-rtps-bundle-rel-s4.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-bundle-latency-s1.data > data/1-8-rtps-bundle-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-bundle-latency-s2.data > data/1-8-rtps-bundle-rel-s2.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-bundle-latency-s3.data > data/1-8-rtps-bundle-rel-s3.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-bundle-latency-s4.data > data/1-8-rtps-bundle-rel-s4.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-bundle-latency-s5.data > data/1-8-rtps-bundle-rel-s5.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-bundle-latency-s6.data > data/1-8-rtps-bundle-rel-s6.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-bundle-latency-s7.data > data/1-8-rtps-bundle-rel-s7.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-bundle-latency-s8.data > data/1-8-rtps-bundle-rel-s8.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s1.data > data/1-16-rtps-bundle-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s2.data > data/1-16-rtps-bundle-rel-s2.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s3.data > data/1-16-rtps-bundle-rel-s3.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s4.data > data/1-16-rtps-bundle-rel-s4.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s5.data > data/1-16-rtps-bundle-rel-s5.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s6.data > data/1-16-rtps-bundle-rel-s6.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s7.data > data/1-16-rtps-bundle-rel-s7.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s8.data > data/1-16-rtps-bundle-rel-s8.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s9.data > data/1-16-rtps-bundle-rel-s9.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s10.data > data/1-16-rtps-bundle-rel-s10.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s11.data > data/1-16-rtps-bundle-rel-s11.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s12.data > data/1-16-rtps-bundle-rel-s12.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s13.data > data/1-16-rtps-bundle-rel-s13.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s14.data > data/1-16-rtps-bundle-rel-s14.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s15.data > data/1-16-rtps-bundle-rel-s15.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-bundle-latency-s16.data > data/1-16-rtps-bundle-rel-s16.gpd
+
+$REDUCECMD $TESTBASE/run/1-1/rtps-shmem-latency-s1.data > data/1-1-rtps-shmem-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/2-1/rtps-shmem-latency-s1.data > data/2-1-rtps-shmem-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/4-1/rtps-shmem-latency-s1.data > data/4-1-rtps-shmem-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/8-1/rtps-shmem-latency-s1.data > data/8-1-rtps-shmem-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/16-1/rtps-shmem-latency-s1.data > data/16-1-rtps-shmem-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/1-2/rtps-shmem-latency-s1.data > data/1-2-rtps-shmem-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/1-2/rtps-shmem-latency-s2.data > data/1-2-rtps-shmem-rel-s2.gpd
+$REDUCECMD $TESTBASE/run/1-4/rtps-shmem-latency-s1.data > data/1-4-rtps-shmem-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/1-4/rtps-shmem-latency-s2.data > data/1-4-rtps-shmem-rel-s2.gpd
+$REDUCECMD $TESTBASE/run/1-4/rtps-shmem-latency-s3.data > data/1-4-rtps-shmem-rel-s3.gpd
+$REDUCECMD $TESTBASE/run/1-4/rtps-shmem-latency-s4.data > data/1-4-rtps-shmem-rel-s4.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-shmem-latency-s1.data > data/1-8-rtps-shmem-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-shmem-latency-s2.data > data/1-8-rtps-shmem-rel-s2.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-shmem-latency-s3.data > data/1-8-rtps-shmem-rel-s3.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-shmem-latency-s4.data > data/1-8-rtps-shmem-rel-s4.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-shmem-latency-s5.data > data/1-8-rtps-shmem-rel-s5.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-shmem-latency-s6.data > data/1-8-rtps-shmem-rel-s6.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-shmem-latency-s7.data > data/1-8-rtps-shmem-rel-s7.gpd
+$REDUCECMD $TESTBASE/run/1-8/rtps-shmem-latency-s8.data > data/1-8-rtps-shmem-rel-s8.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s1.data > data/1-16-rtps-shmem-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s2.data > data/1-16-rtps-shmem-rel-s2.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s3.data > data/1-16-rtps-shmem-rel-s3.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s4.data > data/1-16-rtps-shmem-rel-s4.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s5.data > data/1-16-rtps-shmem-rel-s5.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s6.data > data/1-16-rtps-shmem-rel-s6.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s7.data > data/1-16-rtps-shmem-rel-s7.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s8.data > data/1-16-rtps-shmem-rel-s8.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s9.data > data/1-16-rtps-shmem-rel-s9.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s10.data > data/1-16-rtps-shmem-rel-s10.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s11.data > data/1-16-rtps-shmem-rel-s11.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s12.data > data/1-16-rtps-shmem-rel-s12.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s13.data > data/1-16-rtps-shmem-rel-s13.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s14.data > data/1-16-rtps-shmem-rel-s14.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s15.data > data/1-16-rtps-shmem-rel-s15.gpd
+$REDUCECMD $TESTBASE/run/1-16/rtps-shmem-latency-s16.data > data/1-16-rtps-shmem-rel-s16.gpd
+
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s1.data > data/1-16-small-rtps-rel-s1.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s2.data > data/1-16-small-rtps-rel-s2.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s3.data > data/1-16-small-rtps-rel-s3.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s4.data > data/1-16-small-rtps-rel-s4.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s5.data > data/1-16-small-rtps-rel-s5.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s6.data > data/1-16-small-rtps-rel-s6.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s7.data > data/1-16-small-rtps-rel-s7.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s8.data > data/1-16-small-rtps-rel-s8.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s9.data > data/1-16-small-rtps-rel-s9.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s10.data > data/1-16-small-rtps-rel-s10.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s11.data > data/1-16-small-rtps-rel-s11.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s12.data > data/1-16-small-rtps-rel-s12.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s13.data > data/1-16-small-rtps-rel-s13.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s14.data > data/1-16-small-rtps-rel-s14.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s15.data > data/1-16-small-rtps-rel-s15.gpd
+$REDUCECMD $TESTBASE/run/1-16-small/rtps-latency-s16.data > data/1-16-small-rtps-rel-s16.gpd
+
+$REDUCECMD $TESTBASE/run/1-64-readers/rtps-latency-s1.data > data/1-64-readers-rtps-rel-s1.gpd
@@ -10,6 +10,8 @@ export TRANSPORT_UDP=$TESTBASE/transport-udp.ini
 export TRANSPORT_MCAST_BE=$TESTBASE/transport-mcast-be.ini
 export TRANSPORT_MCAST_REL=$TESTBASE/transport-mcast-rel.ini
 export TRANSPORT_RTPS=$TESTBASE/transport-rtps.ini
+export TRANSPORT_RTPS_BUNDLE=$TESTBASE/transport-rtps-bundle.ini
+export TRANSPORT_RTPS_SHMEM=$TESTBASE/transport-rtps-shmem.ini
 
 mkdir -p run/1-1
 pushd run/1-1
@@ -25,6 +27,10 @@ $TESTCMD -i $TRANSPORT_MCAST_BE -s $TESTBASE/s1be.ini,$TESTBASE/p1be.ini
 mv latency-s1.data mcast-be-latency-s1.data
 $TESTCMD -i $TRANSPORT_RTPS -s $TESTBASE/s1.ini,$TESTBASE/p1.ini
 mv latency-s1.data rtps-latency-s1.data
+$TESTCMD -i $TRANSPORT_RTPS_BUNDLE -s $TESTBASE/s1.ini,$TESTBASE/p1.ini
+mv latency-s1.data rtps-bundle-latency-s1.data
+$TESTCMD -i $TRANSPORT_RTPS_SHMEM -s $TESTBASE/s1.ini,$TESTBASE/p1.ini
+mv latency-s1.data rtps-shmem-latency-s1.data
 popd
 
 mkdir -p run/2-1
@@ -41,6 +47,10 @@ $TESTCMD -i $TRANSPORT_MCAST_BE -s $TESTBASE/s1be.ini,$TESTBASE/p1be.ini,$TESTBA
 mv latency-s1.data mcast-be-latency-s1.data
 $TESTCMD -i $TRANSPORT_RTPS -s $TESTBASE/s1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini
 mv latency-s1.data rtps-latency-s1.data
+$TESTCMD -i $TRANSPORT_RTPS_BUNDLE -s $TESTBASE/s1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini
+mv latency-s1.data rtps-bundle-latency-s1.data
+$TESTCMD -i $TRANSPORT_RTPS_SHMEM -s $TESTBASE/s1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini
+mv latency-s1.data rtps-shmem-latency-s1.data
 popd
 
 mkdir -p run/4-1
@@ -57,6 +67,10 @@ $TESTCMD -i $TRANSPORT_MCAST_BE -s $TESTBASE/s1be.ini,$TESTBASE/p1be.ini,$TESTBA
 mv latency-s1.data mcast-be-latency-s1.data
 $TESTCMD -i $TRANSPORT_RTPS -s $TESTBASE/s1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini
 mv latency-s1.data rtps-latency-s1.data
+$TESTCMD -i $TRANSPORT_RTPS_BUNDLE -s $TESTBASE/s1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini
+mv latency-s1.data rtps-bundle-latency-s1.data
+$TESTCMD -i $TRANSPORT_RTPS_SHMEM -s $TESTBASE/s1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini
+mv latency-s1.data rtps-shmem-latency-s1.data
 popd
 
 mkdir -p run/8-1
@@ -73,6 +87,10 @@ $TESTCMD -i $TRANSPORT_MCAST_BE -s $TESTBASE/s1be.ini,$TESTBASE/p1be.ini,$TESTBA
 mv latency-s1.data mcast-be-latency-s1.data
 $TESTCMD -i $TRANSPORT_RTPS -s $TESTBASE/s1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini
 mv latency-s1.data rtps-latency-s1.data
+$TESTCMD -i $TRANSPORT_RTPS_BUNDLE -s $TESTBASE/s1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini
+mv latency-s1.data rtps-bundle-latency-s1.data
+$TESTCMD -i $TRANSPORT_RTPS_SHMEM -s $TESTBASE/s1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini
+mv latency-s1.data rtps-shmem-latency-s1.data
 popd
 
 mkdir -p run/16-1
@@ -89,6 +107,10 @@ $TESTCMD -i $TRANSPORT_MCAST_BE -s $TESTBASE/s1be.ini,$TESTBASE/p1be.ini,$TESTBA
 mv latency-s1.data mcast-be-latency-s1.data
 $TESTCMD -i $TRANSPORT_RTPS -s $TESTBASE/s1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini
 mv latency-s1.data rtps-latency-s1.data
+$TESTCMD -i $TRANSPORT_RTPS_BUNDLE -s $TESTBASE/s1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini
+mv latency-s1.data rtps-bundle-latency-s1.data
+$TESTCMD -i $TRANSPORT_RTPS_SHMEM -s $TESTBASE/s1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini,$TESTBASE/p1.ini
+mv latency-s1.data rtps-shmem-latency-s1.data
 popd
 
 mkdir -p run/1-2
@@ -111,6 +133,12 @@ mv latency-s2.data mcast-be-latency-s2.data
 $TESTCMD -i $TRANSPORT_RTPS -s $TESTBASE/s1.ini,$TESTBASE/s2.ini,$TESTBASE/p1-2.ini
 mv latency-s1.data rtps-latency-s1.data
 mv latency-s2.data rtps-latency-s2.data
+$TESTCMD -i $TRANSPORT_RTPS_BUNDLE -s $TESTBASE/s1.ini,$TESTBASE/s2.ini,$TESTBASE/p1-2.ini
+mv latency-s1.data rtps-bundle-latency-s1.data
+mv latency-s2.data rtps-bundle-latency-s2.data
+$TESTCMD -i $TRANSPORT_RTPS_SHMEM -s $TESTBASE/s1.ini,$TESTBASE/s2.ini,$TESTBASE/p1-2.ini
+mv latency-s1.data rtps-shmem-latency-s1.data
+mv latency-s2.data rtps-shmem-latency-s2.data
 popd
 
 mkdir -p run/1-4
@@ -145,6 +173,16 @@ mv latency-s1.data rtps-latency-s1.data
 mv latency-s2.data rtps-latency-s2.data
 mv latency-s3.data rtps-latency-s3.data
 mv latency-s4.data rtps-latency-s4.data
+$TESTCMD -i $TRANSPORT_RTPS_BUNDLE -s $TESTBASE/s1.ini,$TESTBASE/s2.ini,$TESTBASE/s3.ini,$TESTBASE/s4.ini,$TESTBASE/p1-4.ini
+mv latency-s1.data rtps-bundle-latency-s1.data
+mv latency-s2.data rtps-bundle-latency-s2.data
+mv latency-s3.data rtps-bundle-latency-s3.data
+mv latency-s4.data rtps-bundle-latency-s4.data
+$TESTCMD -i $TRANSPORT_RTPS_SHMEM -s $TESTBASE/s1.ini,$TESTBASE/s2.ini,$TESTBASE/s3.ini,$TESTBASE/s4.ini,$TESTBASE/p1-4.ini
+mv latency-s1.data rtps-shmem-latency-s1.data
+mv latency-s2.data rtps-shmem-latency-s2.data
+mv latency-s3.data rtps-shmem-latency-s3.data
+mv latency-s4.data rtps-shmem-latency-s4.data
 popd
 
 mkdir -p run/1-8
@@ -203,6 +241,24 @@ mv latency-s5.data rtps-latency-s5.data
 mv latency-s6.data rtps-latency-s6.data
 mv latency-s7.data rtps-latency-s7.data
 mv latency-s8.data rtps-latency-s8.data
+$TESTCMD -i $TRANSPORT_RTPS_BUNDLE -s $TESTBASE/s1.ini,$TESTBASE/s2.ini,$TESTBASE/s3.ini,$TESTBASE/s4.ini,$TESTBASE/s5.ini,$TESTBASE/s6.ini,$TESTBASE/s7.ini,$TESTBASE/s8.ini,$TESTBASE/p1-8.ini
+mv latency-s1.data rtps-bundle-latency-s1.data
+mv latency-s2.data rtps-bundle-latency-s2.data
+mv latency-s3.data rtps-bundle-latency-s3.data
+mv latency-s4.data rtps-bundle-latency-s4.data
+mv latency-s5.data rtps-bundle-latency-s5.data
+mv latency-s6.data rtps-bundle-latency-s6.data
+mv latency-s7.data rtps-bundle-latency-s7.data
+mv latency-s8.data rtps-bundle-latency-s8.data
+$TESTCMD -i $TRANSPORT_RTPS_SHMEM -s $TESTBASE/s1.ini,$TESTBASE/s2.ini,$TESTBASE/s3.ini,$TESTBASE/s4.ini,$TESTBASE/s5.ini,$TESTBASE/s6.ini,$TESTBASE/s7.ini,$TESTBASE/s8.ini,$TESTBASE/p1-8.ini
+mv latency-s1.data rtps-shmem-latency-s1.data
+mv latency-s2.data rtps-shmem-latency-s2.data
+mv latency-s3.data rtps-shmem-latency-s3.data
+mv latency-s4.data rtps-shmem-latency-s4.data
+mv latency-s5.data rtps-shmem-latency-s5.data
+mv latency-s6.data rtps-shmem-latency-s6.data
+mv latency-s7.data rtps-shmem-latency-s7.data
+mv latency-s8.data rtps-shmem-latency-s8.data
 popd
 
 mkdir -p run/1-16
@@ -309,5 +365,65 @@ mv latency-s13.data rtps-latency-s13.data
 mv latency-s14.data rtps-latency-s14.data
 mv latency-s15.data rtps-latency-s15.data
 mv latency-s16.data rtps-latency-s16.data
+$TESTCMD -i $TRANSPORT_RTPS_BUNDLE -s $TESTBASE/s1.ini,$TESTBASE/s2.ini,$TESTBASE/s3.ini,$TESTBASE/s4.ini,$TESTBASE/s5.ini,$TESTBASE/s6.ini,$TESTBASE/s7.ini,$TESTBASE/s16.ini,$TESTBASE/s9.ini,$TESTBASE/s10.ini,$TESTBASE/s11.ini,$TESTBASE/s12.ini,$TESTBASE/s13.ini,$TESTBASE/s14.ini,$TESTBASE/s15.ini,$TESTBASE/s16.ini,$TESTBASE/p1-16.ini
+mv latency-s1.data rtps-bundle-latency-s1.data
+mv latency-s2.data rtps-bundle-latency-s2.data
+mv latency-s3.data rtps-bundle-latency-s3.data
+mv latency-s4.data rtps-bundle-latency-s4.data
+mv latency-s5.data rtps-bundle-latency-s5.data
+mv latency-s6.data rtps-bundle-latency-s6.data
+mv latency-s7.data rtps-bundle-latency-s7.data
+mv latency-s8.data rtps-bundle-latency-s8.data
+mv latency-s9.data rtps-bundle-latency-s9.data
+mv latency-s10.data rtps-bundle-latency-s10.data
+mv latency-s11.data rtps-bundle-latency-s11.data
+mv latency-s12.data rtps-bundle-latency-s12.data
+mv latency-s13.data rtps-bundle-latency-s13.data
+mv latency-s14.data rtps-bundle-latency-s14.data
+mv latency-s15.data rtps-bundle-latency-s15.data
+mv latency-s16.data rtps-bundle-latency-s16.data
+$TESTCMD -i $TRANSPORT_RTPS_SHMEM -s $TESTBASE/s1.ini,$TESTBASE/s2.ini,$TESTBASE/s3.ini,$TESTBASE/s4.ini,$TESTBASE/s5.ini,$TESTBASE/s6.ini,$TESTBASE/s7.ini,$TESTBASE/s16.ini,$TESTBASE/s9.ini,$TESTBASE/s10.ini,$TESTBASE/s11.ini,$TESTBASE/s12.ini,$TESTBASE/s13.ini,$TESTBASE/s14.ini,$TESTBASE/s15.ini,$TESTBASE/s16.ini,$TESTBASE/p1-16.ini
+mv latency-s1.data rtps-shmem-latency-s1.data
+mv latency-s2.data rtps-shmem-latency-s2.data
+mv latency-s3.data rtps-shmem-latency-s3.data
+mv latency-s4.data rtps-shmem-latency-s4.data
+mv latency-s5.data rtps-shmem-latency-s5.data
+mv latency-s6.data rtps-shmem-latency-s6.data
+mv latency-s7.data rtps-shmem-latency-s7.data
+mv latency-s8.data rtps-shmem-latency-s8.data
+mv latency-s9.data rtps-shmem-latency-s9.data
+mv latency-s10.data rtps-shmem-latency-s10.data
+mv latency-s11.data rtps-shmem-latency-s11.data
+mv latency-s12.data rtps-shmem-latency-s12.data
+mv latency-s13.data rtps-shmem-latency-s13.data
+mv latency-s14.data rtps-shmem-latency-s14.data
+mv latency-s15.data rtps-shmem-latency-s15.data
+mv latency-s16.data rtps-shmem-latency-s16.data
 popd
 
+mkdir -p run/1-16-small
+pushd run/1-16-small
+$TESTCMD -i $TRANSPORT_RTPS -s $TESTBASE/s1.ini,$TESTBASE/s2.ini,$TESTBASE/s3.ini,$TESTBASE/s4.ini,$TESTBASE/s5.ini,$TESTBASE/s6.ini,$TESTBASE/s7.ini,$TESTBASE/s8.ini,$TESTBASE/s9.ini,$TESTBASE/s10.ini,$TESTBASE/s11.ini,$TESTBASE/s12.ini,$TESTBASE/s13.ini,$TESTBASE/s14.ini,$TESTBASE/s15.ini,$TESTBASE/s16.ini,$TESTBASE/p1-16-small.ini
+mv latency-s1.data rtps-latency-s1.data
+mv latency-s2.data rtps-latency-s2.data
+mv latency-s3.data rtps-latency-s3.data
+mv latency-s4.data rtps-latency-s4.data
+mv latency-s5.data rtps-latency-s5.data
+mv latency-s6.data rtps-latency-s6.data
+mv latency-s7.data rtps-latency-s7.data
+mv latency-s8.data rtps-latency-s8.data
+mv latency-s9.data rtps-latency-s9.data
+mv latency-s10.data rtps-latency-s10.data
+mv latency-s11.data rtps-latency-s11.data
+mv latency-s12.data rtps-latency-s12.data
+mv latency-s13.data rtps-latency-s13.data
+mv latency-s14.data rtps-latency-s14.data
+mv latency-s15.data rtps-latency-s15.data
+mv latency-s16.data rtps-latency-s16.data
+popd
+
+mkdir -p run/1-64-readers
+pushd run/1-64-readers
+$TESTCMD -i $TRANSPORT_RTPS -s $TESTBASE/s64-readers.ini,$TESTBASE/p1-64.ini
+mv latency-s1.data rtps-latency-s1.data
+popd
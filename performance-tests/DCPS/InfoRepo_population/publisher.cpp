@@ -47,6 +47,8 @@ private:
 
   std::string sync_server_;
 
+  bool time_partition_change_;
+
   DDS::DomainParticipantFactory_var dpf_;
   std::vector<DDS::DomainParticipant_var> participant_;
   std::vector<DDS::Topic_var> topic_;
@@ -59,12 +61,13 @@ private:
 bool
 Publisher::parse_args (int argc, ACE_TCHAR *argv[])
 {
-  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("t:n:p:c:s:i:"));
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("t:n:p:c:s:i:q"));
   int c;
   std::string usage = " -t <topic count>\n"
     " -n <participant count>\n -p <publisher count>\n"
     " -c <control file>\n -s <subscriber count>\n"
-    " -y <syncServer ior>";
+    " -y <syncServer ior>\n"
+    " -q (time a partition QoS change on every publisher)";
 
   while ((c = get_opts ()) != -1)
   {
@@ -88,6 +91,9 @@ Publisher::parse_args (int argc, ACE_TCHAR *argv[])
       case 'y':
         sync_server_ = ACE_TEXT_ALWAYS_CHAR (get_opts.opt_arg ());
         break;
+      case 'q':
+        time_partition_change_ = true;
+        break;
       case '?':
       default:
         ACE_ERROR_RETURN ((LM_ERROR,
@@ -104,6 +110,7 @@ Publisher::parse_args (int argc, ACE_TCHAR *argv[])
 Publisher::Publisher (int argc, ACE_TCHAR *argv[])
   : topic_count_ (1), participant_count_ (1), writer_count_ (1)
   , control_file_ ("barrier_file"), subscriber_count_(1)
+  , time_partition_change_ (false)
 {
   try
     {
@@ -272,6 +279,29 @@ Publisher::run (void)
       //ACE_DEBUG ((LM_DEBUG, "(%P|%t) Created %d publishers in %d secs.\n"
       //, writer_count_, tv.sec()));
 
+      if (time_partition_change_)
+        {
+          // Each partition change makes the repository reevaluate the
+          // associations of every writer of the publisher.
+          DDS::PublisherQos pub_qos;
+          ACE_High_Res_Timer partition_timer;
+          partition_timer.start();
+          for (size_t count = 0; count < writer_count_; count++)
+            {
+              pub_[count]->get_qos (pub_qos);
+              pub_qos.partition.name.length (1);
+              pub_qos.partition.name[0] = "InfoRepo_population";
+              if (DDS::RETCODE_OK != pub_[count]->set_qos (pub_qos)) {
+                cerr << "set_qos failed." << endl;
+                return false;
+              }
+            }
+          partition_timer.stop();
+          partition_timer.elapsed_time (tv);
+          ACE_DEBUG ((LM_INFO, "(%P|%t) Changed partition of %d publishers in %d ms.\n"
+                      , static_cast<int>(writer_count_), static_cast<int>(tv.msec())));
+        }
+
 
       for (size_t count = 0; count < participant_count_; count++)
         {
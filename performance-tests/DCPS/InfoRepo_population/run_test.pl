@@ -9,6 +9,7 @@ use lib "$DDS_ROOT/bin";
 use Env (ACE_ROOT);
 use lib "$ACE_ROOT/bin";
 use PerlDDS::Run_Test;
+use Time::HiRes qw(time);
 
 $status = 0;
 
@@ -39,6 +40,25 @@ $opts .= "-DCPSDebugLevel $debuglevel "   if $debuglevel;
 $opts .= "-ORBVerboseLogging 1 "          if $verbose;
 $opts .= "-ORBLogFile $debugfile "        if $debugfile;
 $pub_opts = "$opts -DCPSConfigFile pub.ini -DCPSBit 0 -t5 -n5 -p5 -s5";
+
+# Arguments:
+#   partition   also time the repository's reevaluation of a partition change
+#   persist     run the repository with a PersistenceUpdater, so the times
+#               include writing each change to its store
+#   flush=MSEC  like persist, with changes batched for MSEC milliseconds
+#               (the PersistenceUpdater's -flushInterval)
+my $persist;
+my $flush_interval = 0;
+foreach my $arg (@ARGV) {
+  if ($arg eq 'partition') {
+    $pub_opts .= " -q";
+  } elsif ($arg eq 'persist') {
+    $persist = 1;
+  } elsif ($arg =~ /^flush=(\d+)$/) {
+    $persist = 1;
+    $flush_interval = $1;
+  }
+}
 $sub_opts = "$opts -DCPSConfigFile sub.ini -DCPSBit 0 -t5 -n5 -s5 -p10";
 
 my $syncopts  = "-ORBDebugLevel $orbdebuglevel " if $orbdebuglevel;
@@ -51,6 +71,17 @@ $repo_bit_opt = "$opts -NOBITS";
 
 unlink $dcpsrepo_ior;
 
+my $persist_conf = "persist.conf";
+my $persist_file = "info.pr";
+if ($persist) {
+  unlink $persist_file;
+  open(my $conf, '>', $persist_conf) or die "ERROR: can't write $persist_conf\n";
+  print $conf "static PersistenceUpdaterSvc \"-file $persist_file -reset 1 "
+      . "-flushInterval $flush_interval\"\n";
+  close($conf);
+  $repo_bit_opt .= " -ORBSvcConf $persist_conf";
+}
+
 $DCPSREPO = PerlDDS::create_process ("$ENV{DDS_ROOT}/bin/DCPSInfoRepo",
                                      "$repo_bit_opt -o $dcpsrepo_ior");
 $Subscriber = PerlDDS::create_process ("subscriber", " $sub_opts");
@@ -158,11 +189,19 @@ if ($ss != 0) {
     $status = 1;
 }
 
+# the repository writes any changes still queued when it shuts down
+my $shutdown_start = time();
 $ir = $DCPSREPO->TerminateWaitKill(5);
 if ($ir != 0) {
     print STDERR "ERROR: DCPSInfoRepo returned $ir\n";
     $status = 1;
 }
+if ($persist) {
+  printf("DCPSInfoRepo shutdown with flushInterval $flush_interval took %.3f seconds\n",
+         time() - $shutdown_start);
+  unlink $persist_conf;
+  unlink $persist_file;
+}
 
 unlink $dcpsrepo_ior;
 # $SyncServer will clean-up $sync_ior
@@ -78,6 +78,16 @@ elsif ($test->flag('rtps_disc')) {
     $sub_opts .= " -DCPSConfigFile rtps_disc.ini";
     $is_rtps_disc = 1;
 }
+elsif ($test->flag('rtps_disc_bundle')) {
+    $pub_opts .= " -DCPSConfigFile rtps_disc_bundle.ini";
+    $sub_opts .= " -DCPSConfigFile rtps_disc_bundle.ini";
+    $is_rtps_disc = 1;
+}
+elsif ($test->flag('rtps_disc_shmem')) {
+    $pub_opts .= " -DCPSConfigFile rtps_disc_shmem.ini";
+    $sub_opts .= " -DCPSConfigFile rtps_disc_shmem.ini";
+    $is_rtps_disc = 1;
+}
 elsif ($test->flag('rtps_disc_tcp')) {
     $pub_opts .= " -DCPSConfigFile rtps_disc_tcp.ini";
     $sub_opts .= " -DCPSConfigFile rtps_disc_tcp.ini";
@@ -101,7 +111,8 @@ elsif ($test->flag('all')) {
     @original_ARGV = grep { $_ ne 'all' } @original_ARGV;
     my @tests = ('', qw/udp multicast default_tcp default_udp default_multicast
                         nobits stack shmem
-                        rtps rtps_disc rtps_unicast rtps_disc_tcp/);
+                        rtps rtps_disc rtps_disc_bundle rtps_disc_shmem rtps_unicast
+                        rtps_disc_tcp/);
     push(@tests, 'ipv6') if new PerlACE::ConfigList->check_config('IPV6');
     for my $test (@tests) {
         $status += system($^X, $0, @original_ARGV, $test);
@@ -21,6 +21,7 @@
 #include "model/Sync.h"
 #include "ace/Arg_Shifter.h"
 #include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_sys_time.h"
 
 class TestConfig {
 public:
@@ -932,6 +933,155 @@ bool run_test(DomainParticipant_var& dp_sub,
   return ok;
 }
 
+Topic_var bulk_topic(const DomainParticipant_var& dp, const char* name)
+{
+  TypeSupport_var ts = new TestMsgTypeSupportImpl;
+
+  if (ts->register_type(dp, "") != RETCODE_OK) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P failed to register type support\n"));
+    return 0;
+  }
+
+  CORBA::String_var type_name = ts->get_type_name();
+  Topic_var topic = dp->create_topic(name,
+                                     type_name,
+                                     TOPIC_QOS_DEFAULT,
+                                     0,
+                                     DEFAULT_STATUS_MASK);
+
+  if (!topic) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P failed to create topic %C\n", name));
+  }
+  return topic;
+}
+
+const int BULK_MATCH_TIMEOUT = 60;
+
+bool wait_matched(const DataReader_var& dr, int n)
+{
+  const ACE_Time_Value deadline =
+    ACE_OS::gettimeofday() + ACE_Time_Value(BULK_MATCH_TIMEOUT);
+  SubscriptionMatchedStatus ms = {0, 0, 0, 0, 0};
+  while (dr->get_subscription_matched_status(ms) == RETCODE_OK
+         && ms.current_count != n) {
+    if (ACE_OS::gettimeofday() > deadline) {
+      ACE_ERROR((LM_ERROR, "ERROR: %P reader matched %d of %d writers\n",
+                 ms.current_count, n));
+      return false;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  }
+  return ms.current_count == n;
+}
+
+bool wait_matched(const DataWriter_var& dw, int n)
+{
+  const ACE_Time_Value deadline =
+    ACE_OS::gettimeofday() + ACE_Time_Value(BULK_MATCH_TIMEOUT);
+  PublicationMatchedStatus ms = {0, 0, 0, 0, 0};
+  while (dw->get_publication_matched_status(ms) == RETCODE_OK
+         && ms.current_count != n) {
+    if (ACE_OS::gettimeofday() > deadline) {
+      ACE_ERROR((LM_ERROR, "ERROR: %P writer matched %d of %d readers\n",
+                 ms.current_count, n));
+      return false;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  }
+  return ms.current_count == n;
+}
+
+/// One reader of the "Bulk Publications" topic and one writer of the
+/// "Bulk Subscriptions" topic in a new participant of 'dpf'.
+DomainParticipant_var bulk_peer(const DomainParticipantFactory_var& dpf,
+                                DataReader_var& dr, DataWriter_var& dw)
+{
+  DomainParticipant_var dp = dpf->create_participant(9, PARTICIPANT_QOS_DEFAULT,
+                                                     0, DEFAULT_STATUS_MASK);
+  if (!dp) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P could not create bulk peer participant\n"));
+    return 0;
+  }
+
+  Topic_var pub_topic = bulk_topic(dp, "Bulk Publications");
+  Topic_var sub_topic = bulk_topic(dp, "Bulk Subscriptions");
+  Subscriber_var sub = dp->create_subscriber(SUBSCRIBER_QOS_DEFAULT,
+                                             0, DEFAULT_STATUS_MASK);
+  Publisher_var pub = dp->create_publisher(PUBLISHER_QOS_DEFAULT,
+                                           0, DEFAULT_STATUS_MASK);
+  if (!pub_topic || !sub_topic || !sub || !pub) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P failed to set up bulk peer\n"));
+    return dp;
+  }
+
+  dr = sub->create_datareader(pub_topic, DATAREADER_QOS_DEFAULT,
+                              0, DEFAULT_STATUS_MASK);
+  dw = pub->create_datawriter(sub_topic, DATAWRITER_QOS_DEFAULT,
+                              0, DEFAULT_STATUS_MASK);
+  if (!dr || !dw) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P failed to create bulk peer endpoints\n"));
+  }
+  return dp;
+}
+
+/// SEDP with many endpoints per participant: 'endpoints' writers and
+/// readers in 'dp' are announced to a participant discovered later, more
+/// than the SEDP task processes in one batch, and a participant that is
+/// deleted while those announcements are still queued shuts down cleanly.
+bool run_bulk_test(const DomainParticipantFactory_var& dpf,
+                   const DomainParticipant_var& dp, int endpoints)
+{
+  Topic_var pub_topic = bulk_topic(dp, "Bulk Publications");
+  Topic_var sub_topic = bulk_topic(dp, "Bulk Subscriptions");
+  Publisher_var pub = dp->create_publisher(PUBLISHER_QOS_DEFAULT,
+                                           0, DEFAULT_STATUS_MASK);
+  Subscriber_var sub = dp->create_subscriber(SUBSCRIBER_QOS_DEFAULT,
+                                             0, DEFAULT_STATUS_MASK);
+  if (!pub_topic || !sub_topic || !pub || !sub) {
+    ACE_ERROR((LM_ERROR, "ERROR: %P failed to set up bulk participant\n"));
+    return false;
+  }
+
+  DataWriter_var first_dw;
+  for (int i = 0; i < endpoints; ++i) {
+    DataWriter_var dw = pub->create_datawriter(pub_topic, DATAWRITER_QOS_DEFAULT,
+                                               0, DEFAULT_STATUS_MASK);
+    DataReader_var dr = sub->create_datareader(sub_topic, DATAREADER_QOS_DEFAULT,
+                                               0, DEFAULT_STATUS_MASK);
+    if (!dw || !dr) {
+      ACE_ERROR((LM_ERROR, "ERROR: %P failed to create bulk endpoint %d\n", i));
+      return false;
+    }
+    if (i == 0) {
+      first_dw = dw;
+    }
+  }
+
+  // The existing endpoints reach this participant as durable SEDP data
+  ACE_DEBUG((LM_INFO, "%P bulk test: matching %d writers and readers\n",
+             endpoints));
+  DataReader_var late_dr;
+  DataWriter_var late_dw;
+  DomainParticipant_var dp_late = bulk_peer(dpf, late_dr, late_dw);
+  bool ok = dp_late && late_dr && late_dw
+    && wait_matched(late_dr, endpoints) && wait_matched(late_dw, endpoints);
+
+  // Deleted before its SEDP task has worked through the announcements
+  ACE_DEBUG((LM_INFO, "%P bulk test: deleting a participant during discovery\n"));
+  DataReader_var gone_dr;
+  DataWriter_var gone_dw;
+  DomainParticipant_var dp_gone = bulk_peer(dpf, gone_dr, gone_dw);
+  gone_dr = 0;
+  gone_dw = 0;
+  cleanup(dpf, dp_gone);
+
+  // Its reader is removed again, only the late one is left
+  ok = ok && wait_matched(first_dw, 1);
+
+  cleanup(dpf, dp_late);
+  return ok;
+}
+
 int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
 {
   bool ok = false;
@@ -945,6 +1095,7 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
       ACE_ERROR((LM_ERROR, "ERROR: %P could not create Sub Domain Participant\n"));
 
     } else {
+      int endpoints = 0;
       {
         // New scope.
         ACE_Arg_Shifter shifter (argc, argv);
@@ -952,6 +1103,8 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
           const ACE_TCHAR* x = shifter.get_the_parameter (ACE_TEXT("-value_base"));
           if (x != NULL) {
             TestConfig::set (ACE_OS::atoi (x));
+          } else if ((x = shifter.get_the_parameter (ACE_TEXT("-endpoints"))) != NULL) {
+            endpoints = ACE_OS::atoi (x);
           }
 
           shifter.consume_arg ();
@@ -967,7 +1120,8 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
         ACE_ERROR((LM_ERROR, "ERROR: %P could not create Domain Participant 2\n"));
 
       } else {
-        ok = run_test(dp_sub, dp_pub);
+        ok = endpoints ? run_bulk_test(dpf, dp_pub, endpoints)
+                       : run_test(dp_sub, dp_pub);
 
         if (!ok) {
           ACE_ERROR((LM_ERROR, "ERROR: %P from run_test\n"));
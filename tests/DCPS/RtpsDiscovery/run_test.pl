@@ -32,6 +32,22 @@ for my $cfg (@configs) {
 
 exit $result if $PerlDDS::SafetyProfile;
 
+{
+  # More endpoints than Sedp::Task processes in one batch, with a
+  # participant deleted while their announcements are still queued
+  print "Running sedp bulk endpoint test\n";
+  my $test = new PerlDDS::TestFramework();
+  $test->enable_console_logging();
+  $test->process('test', 'RtpsDiscoveryTest',
+                 '-DCPSConfigFile rtps_disc_tcp.ini -endpoints 300');
+  $test->start_process('test');
+  my $res = $test->finish(300);
+  if ($res != 0) {
+    print STDERR "ERROR: sedp bulk endpoint test returned $res\n";
+    $result += $res;
+  }
+}
+
 sub run2proc {
   my $arg4proc2 = shift;
   my $description = shift;
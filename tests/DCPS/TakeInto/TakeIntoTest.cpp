@@ -0,0 +1,185 @@
+#include "dds/DdsDcpsInfrastructureC.h"
+#include "dds/DCPS/WaitSet.h"
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/Marked_Default_Qos.h"
+#include "dds/DCPS/PublisherImpl.h"
+#include "dds/DCPS/SubscriberImpl.h"
+#include "dds/DCPS/StaticIncludes.h"
+
+#include "GeneratedCode/MessengerTypeSupportImpl.h"
+
+#include <cstdio>
+#include <iostream>
+using namespace std;
+
+namespace {
+  const int N_INSTANCES = 4;
+  const int N_SAMPLES = 20;
+  const CORBA::ULong CAPACITY = 3;
+
+  string text_for(int count)
+  {
+    char buf[32];
+    sprintf(buf, "sample %d", count);
+    return buf;
+  }
+}
+
+int run_test(DDS::DomainParticipant_ptr dp)
+{
+  using namespace DDS;
+  using namespace OpenDDS::DCPS;
+  using namespace Messenger;
+  WaitSet_var ws = new WaitSet;
+  MessageTypeSupport_var ts = new MessageTypeSupportImpl;
+  ts->register_type(dp, "");
+  CORBA::String_var type_name = ts->get_type_name();
+  Topic_var topic = dp->create_topic("MyTopic", type_name,
+    TOPIC_QOS_DEFAULT, 0, ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+  Publisher_var pub = dp->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+    ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  DataWriterQos dw_qos;
+  pub->get_default_datawriter_qos(dw_qos);
+  dw_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  DataWriter_var dw = pub->create_datawriter(topic, dw_qos, 0,
+    ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+  Subscriber_var sub = dp->create_subscriber(SUBSCRIBER_QOS_DEFAULT, 0,
+    ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  DataReaderQos dr_qos;
+  sub->get_default_datareader_qos(dr_qos);
+  dr_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dr_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  DataReader_var dr = sub->create_datareader(topic, dr_qos, 0,
+    ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+  typedef DataReaderImpl_T<Message> MessageDataReaderImpl;
+  MessageDataReaderImpl* const impl = dynamic_cast<MessageDataReaderImpl*>(dr.in());
+  if (!impl) {
+    cout << "ERROR: reader is not a DataReaderImpl_T<Message>" << endl;
+    return 1;
+  }
+
+  StatusCondition_var dw_sc = dw->get_statuscondition();
+  dw_sc->set_enabled_statuses(PUBLICATION_MATCHED_STATUS);
+  ws->attach_condition(dw_sc);
+  Duration_t infinite = {DURATION_INFINITE_SEC, DURATION_INFINITE_NSEC};
+  ConditionSeq active;
+
+  ReturnCode_t ret = ws->wait(active, infinite);
+  if (ret != RETCODE_OK) return ret;
+
+  ret = ws->detach_condition(dw_sc);
+  if (ret != RETCODE_OK) return ret;
+
+  // Both arrays are owned here and reused by every call.
+  Message samples[CAPACITY];
+  SampleInfo infos[CAPACITY];
+  CORBA::ULong count = CAPACITY;
+  bool passed = true;
+
+  if (impl->take_into(samples, infos, 0, count) != RETCODE_BAD_PARAMETER
+      || count != 0) {
+    cout << "ERROR: take_into with no capacity should be rejected" << endl;
+    passed = false;
+  }
+
+  if (impl->take_into(samples, infos, CAPACITY, count) != RETCODE_NO_DATA
+      || count != 0) {
+    cout << "ERROR: take_into from an empty reader should return NO_DATA"
+         << endl;
+    passed = false;
+  }
+
+  MessageDataWriter_var mdw = MessageDataWriter::_narrow(dw);
+  for (int i = 0; i < N_SAMPLES; ++i) {
+    Message msg;
+    msg.subject_id = i % N_INSTANCES;
+    msg.count = i;
+    msg.text = text_for(i).c_str();
+    ret = mdw->write(msg, HANDLE_NIL);
+    if (ret != RETCODE_OK) return ret;
+  }
+
+  ReadCondition_var dr_rc = dr->create_readcondition(ANY_SAMPLE_STATE,
+    ANY_VIEW_STATE, ANY_INSTANCE_STATE);
+  ws->attach_condition(dr_rc);
+
+  // Samples of each instance must come out in the order they were written.
+  int next[N_INSTANCES] = {0, 1, 2, 3};
+  int received = 0;
+  while (passed && received < N_SAMPLES) {
+    ret = impl->take_into(samples, infos, CAPACITY, count);
+    if (ret == RETCODE_NO_DATA) {
+      if (count != 0) {
+        cout << "ERROR: NO_DATA with count " << count << endl;
+        passed = false;
+        break;
+      }
+      ret = ws->wait(active, infinite);
+      if (ret != RETCODE_OK) {
+        passed = false;
+      }
+      continue;
+    }
+    if (ret != RETCODE_OK || count == 0 || count > CAPACITY) {
+      cout << "ERROR: take_into returned " << ret << " with count "
+           << count << endl;
+      passed = false;
+      break;
+    }
+
+    for (CORBA::ULong i = 0; i < count; ++i) {
+      const Message& sample = samples[i];
+      cout << "took sample " << sample.count << endl;
+      if (!infos[i].valid_data || sample.subject_id < 0
+          || sample.subject_id >= N_INSTANCES
+          || sample.count != next[sample.subject_id]
+          || text_for(sample.count) != sample.text.in()) {
+        cout << "ERROR: unexpected sample " << sample.count
+             << " for instance " << sample.subject_id << endl;
+        passed = false;
+        break;
+      }
+      next[sample.subject_id] += N_INSTANCES;
+      ++received;
+    }
+  }
+
+  if (passed && (impl->take_into(samples, infos, CAPACITY, count)
+                 != RETCODE_NO_DATA || count != 0)) {
+    cout << "ERROR: samples left after taking all of them" << endl;
+    passed = false;
+  }
+
+  ws->detach_condition(dr_rc);
+  dr->delete_readcondition(dr_rc);
+
+  dp->delete_contained_entities();
+  return passed ? 0 : 1;
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int ret = 1;
+  try
+  {
+    using namespace DDS;
+    DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+    DomainParticipant_var dp = dpf->create_participant(23,
+      PARTICIPANT_QOS_DEFAULT, 0, ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+    ret = run_test(dp);
+
+    dpf->delete_participant(dp);
+    TheServiceParticipant->shutdown();
+    ACE_Thread_Manager::instance()->wait();
+  }
+  catch (const CORBA::BAD_PARAM& ex)
+  {
+    ex._tao_print_exception("Exception caught in TakeIntoTest.cpp:");
+    return 1;
+  }
+  return ret;
+}
@@ -0,0 +1,139 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+
+#include "dds/DCPS/transport/rtps_udp/HeldSamples.h"
+
+#include "../common/TestSupport.h"
+
+#include <algorithm>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  typedef SequenceNumber::Value Value;
+  typedef OPENDDS_VECTOR(Value) Values;
+
+  ReceivedDataSample sample(Value seq)
+  {
+    ReceivedDataSample s(0);
+    s.header_.sequence_ = seq;
+    return s;
+  }
+
+  Values pop_all(HeldSamples& held, Value ca)
+  {
+    Values popped;
+    ReceivedDataSample s(0);
+    while (held.pop(ca, s)) {
+      popped.push_back(s.header_.sequence_.getValue());
+    }
+    return popped;
+  }
+
+  bool equal(const Values& popped, const Value* expected, size_t n)
+  {
+    return popped.size() == n && std::equal(popped.begin(), popped.end(), expected);
+  }
+}
+
+int
+ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  const size_t depth = 256;
+
+  // No ring until a sample is held, and it is released when the gap fills
+  {
+    HeldSamples held;
+    TEST_CHECK(held.capacity() == 0);
+
+    held.hold(3, sample(3), depth);
+    held.hold(5, sample(5), depth);
+    held.hold(4, sample(4), depth);
+    held.hold(4, sample(4), depth); // duplicates are held once
+    TEST_CHECK(held.size() == 3);
+    TEST_CHECK(held.capacity() == size_t(HeldSamples::MIN_SLOTS));
+
+    TEST_CHECK(pop_all(held, 1).empty()); // 2 is still missing
+    TEST_CHECK(held.capacity() == size_t(HeldSamples::MIN_SLOTS));
+
+    const Value expected[] = {3, 4, 5};
+    TEST_CHECK(equal(pop_all(held, 5), expected, 3));
+    TEST_CHECK(held.size() == 0);
+    TEST_CHECK(held.capacity() == 0);
+  }
+
+  // The ring grows as far as the gap requires, beyond 'depth' samples are
+  // held outside of it
+  {
+    HeldSamples held;
+    held.hold(10, sample(10), 64);
+    held.hold(20, sample(20), 64);
+    TEST_CHECK(held.capacity() == 16);
+    held.hold(40, sample(40), 64);
+    TEST_CHECK(held.capacity() == 32);
+    held.hold(100, sample(100), 64);
+    TEST_CHECK(held.capacity() == 32);
+    TEST_CHECK(held.size() == 4);
+
+    const Value first[] = {10};
+    TEST_CHECK(equal(pop_all(held, 15), first, 1));
+    TEST_CHECK(held.capacity() == 32);
+
+    const Value rest[] = {20, 40, 100};
+    TEST_CHECK(equal(pop_all(held, 100), rest, 3));
+    TEST_CHECK(held.capacity() == 0);
+  }
+
+  // The ring never has more than 'depth' slots
+  {
+    HeldSamples held;
+    held.hold(5, sample(5), 20);
+    held.hold(30, sample(30), 20);
+    held.hold(20, sample(20), 20);
+    TEST_CHECK(held.capacity() == 16);
+    held.hold(24, sample(24), 20);
+    TEST_CHECK(held.capacity() == 20);
+
+    const Value expected[] = {5, 20, 24, 30};
+    TEST_CHECK(equal(pop_all(held, 30), expected, 4));
+    TEST_CHECK(held.capacity() == 0);
+  }
+
+  // Samples arriving below the window are delivered before it, in order
+  {
+    HeldSamples held;
+    for (Value seq = 41; seq > 1; --seq) {
+      held.hold(seq, sample(seq), depth);
+    }
+    TEST_CHECK(held.size() == 40);
+    TEST_CHECK(held.capacity() == size_t(HeldSamples::MIN_SLOTS));
+
+    const Values popped = pop_all(held, 41);
+    TEST_CHECK(popped.size() == 40);
+    for (size_t i = 0; i < popped.size(); ++i) {
+      TEST_CHECK(popped[i] == Value(i + 2));
+    }
+    TEST_CHECK(held.size() == 0);
+    TEST_CHECK(held.capacity() == 0);
+  }
+
+  // Without a ring everything is held in order outside of it
+  {
+    HeldSamples held;
+    held.hold(9, sample(9), 0);
+    held.hold(7, sample(7), 0);
+    held.hold(8, sample(8), 0);
+    TEST_CHECK(held.capacity() == 0);
+
+    const Value expected[] = {7, 8, 9};
+    TEST_CHECK(equal(pop_all(held, 9), expected, 3));
+  }
+
+  return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+
+#include "dds/DCPS/RTPS/LeaseIndex.h"
+#include "dds/DCPS/GuidUtils.h"
+
+#include "../common/TestSupport.h"
+
+using namespace OpenDDS::DCPS;
+using OpenDDS::RTPS::LeaseIndex;
+
+namespace {
+  RepoId participant(unsigned char n)
+  {
+    RepoId id = GUID_UNKNOWN;
+    id.guidPrefix[11] = n;
+    id.entityId = ENTITYID_PARTICIPANT;
+    return id;
+  }
+}
+
+int
+ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  const RepoId a = participant(1), b = participant(2), c = participant(3);
+  const ACE_Time_Value t0(1000);
+  ACE_Time_Value when;
+
+  // Checks come due in time order, not in the order they were scheduled
+  {
+    LeaseIndex index;
+    index.schedule(a, t0 + ACE_Time_Value(30));
+    index.schedule(b, t0 + ACE_Time_Value(10));
+    index.schedule(c, t0 + ACE_Time_Value(20));
+    TEST_CHECK(index.size() == 3);
+
+    OPENDDS_VECTOR(RepoId) due;
+    index.take_due(t0 + ACE_Time_Value(10), due);
+    TEST_CHECK(due.empty()); // only checks scheduled before 'now' are due
+
+    index.take_due(t0 + ACE_Time_Value(25), due);
+    TEST_CHECK(due.size() == 2);
+    TEST_CHECK(due.size() == 2 && due[0] == b && due[1] == c);
+    TEST_CHECK(index.size() == 1);
+    TEST_CHECK(!index.scheduled(b, when));
+    TEST_CHECK(index.scheduled(a, when) && when == t0 + ACE_Time_Value(30));
+
+    due.clear();
+    index.take_due(t0 + ACE_Time_Value(100), due);
+    TEST_CHECK(due.size() == 1 && due[0] == a);
+    TEST_CHECK(index.size() == 0);
+  }
+
+  // A participant has only one check, rescheduling replaces it
+  {
+    LeaseIndex index;
+    index.schedule(a, t0 + ACE_Time_Value(10));
+    index.schedule(a, t0 + ACE_Time_Value(50));
+    TEST_CHECK(index.size() == 1);
+    TEST_CHECK(index.scheduled(a, when) && when == t0 + ACE_Time_Value(50));
+
+    OPENDDS_VECTOR(RepoId) due;
+    index.take_due(t0 + ACE_Time_Value(20), due);
+    TEST_CHECK(due.empty());
+  }
+
+  // schedule_by() only moves a check earlier, as for a shortened lease
+  {
+    LeaseIndex index;
+    index.schedule_by(a, t0 + ACE_Time_Value(30));
+    TEST_CHECK(index.scheduled(a, when) && when == t0 + ACE_Time_Value(30));
+
+    index.schedule_by(a, t0 + ACE_Time_Value(40)); // renewed, no change
+    TEST_CHECK(index.scheduled(a, when) && when == t0 + ACE_Time_Value(30));
+
+    index.schedule_by(a, t0 + ACE_Time_Value(5)); // shortened
+    TEST_CHECK(index.scheduled(a, when) && when == t0 + ACE_Time_Value(5));
+    TEST_CHECK(index.size() == 1);
+
+    OPENDDS_VECTOR(RepoId) due;
+    index.take_due(t0 + ACE_Time_Value(6), due);
+    TEST_CHECK(due.size() == 1 && due[0] == a);
+  }
+
+  // Removed participants are never reported
+  {
+    LeaseIndex index;
+    index.schedule(a, t0 + ACE_Time_Value(10));
+    index.schedule(b, t0 + ACE_Time_Value(10));
+    index.remove(a);
+    index.remove(c); // not scheduled
+    TEST_CHECK(index.size() == 1);
+
+    OPENDDS_VECTOR(RepoId) due;
+    index.take_due(t0 + ACE_Time_Value(20), due);
+    TEST_CHECK(due.size() == 1 && due[0] == b);
+  }
+
+  return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Dynamic_Service.h"
+
+#include "dds/InfoRepo/PersistenceUpdater.h"
+#include "dds/InfoRepo/UpdateManager.h"
+#include "dds/DCPS/GuidUtils.h"
+
+#include "../common/TestSupport.h"
+
+using namespace OpenDDS::DCPS;
+using Update::PersistenceUpdater;
+using Update::UParticipant;
+using Update::UTopic;
+using Update::IdPath;
+
+namespace {
+  RepoId entity(unsigned char n, CORBA::Octet kind)
+  {
+    RepoId id = GUID_UNKNOWN;
+    id.guidPrefix[11] = 1;
+    id.entityId.entityKey[2] = n;
+    id.entityId.entityKind = kind;
+    return id;
+  }
+
+  const ACE_TCHAR* const store_file = ACE_TEXT("UnitTests_PersistenceUpdater.pr");
+}
+
+int
+ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  const RepoId participant_id = entity(0, ENTITYKIND_BUILTIN_PARTICIPANT);
+  const RepoId topic_id = entity(1, ENTITYKIND_OPENDDS_TOPIC);
+  const RepoId other_id = entity(2, ENTITYKIND_BUILTIN_PARTICIPANT);
+
+  PersistenceUpdater updater;
+
+  // Hold changes long enough that only explicit flushes write them
+  ACE_TCHAR* args[] = {
+    const_cast<ACE_TCHAR*>(ACE_TEXT("-file")),
+    const_cast<ACE_TCHAR*>(store_file),
+    const_cast<ACE_TCHAR*>(ACE_TEXT("-reset")),
+    const_cast<ACE_TCHAR*>(ACE_TEXT("1")),
+    const_cast<ACE_TCHAR*>(ACE_TEXT("-flushInterval")),
+    const_cast<ACE_TCHAR*>(ACE_TEXT("60000"))
+  };
+  TEST_CHECK(updater.init(sizeof(args) / sizeof(args[0]), args) == 0);
+  TEST_CHECK(updater.pending() == 0);
+
+  // Repeated changes to one entity are held as a single pending entry
+  {
+    DDS::DomainParticipantQos participant_qos;
+    const UParticipant participant(0, 0, participant_id, participant_qos);
+    updater.create(participant);
+
+    DDS::TopicQos topic_qos;
+    const UTopic topic(0, topic_id, participant_id, "Topic", "Type", topic_qos);
+    updater.create(topic);
+    TEST_CHECK(updater.pending() == 2);
+
+    for (int i = 0; i < 10; ++i) {
+      topic_qos.lifespan.duration.sec = i;
+      updater.update(IdPath(0, participant_id, topic_id), topic_qos);
+    }
+    TEST_CHECK(updater.pending() == 2);
+  }
+
+  // Destroying an entity whose creation is still pending cancels both
+  {
+    DDS::DomainParticipantQos participant_qos;
+    const UParticipant participant(0, 0, other_id, participant_qos);
+    updater.create(participant);
+    TEST_CHECK(updater.pending() == 3);
+
+    updater.destroy(IdPath(0, other_id, other_id), Update::Participant,
+                    Update::DataWriter);
+    TEST_CHECK(updater.pending() == 2);
+  }
+
+  updater.flush();
+  TEST_CHECK(updater.pending() == 0);
+
+  // Once written, a destroy has to be kept so it reaches the store
+  updater.destroy(IdPath(0, participant_id, topic_id), Update::Topic, Update::DataWriter);
+  TEST_CHECK(updater.pending() == 1);
+
+  // The image includes queued changes, and building it must not hold the
+  // store while the image is pushed back through the updaters
+  updater.requestImage();
+  TEST_CHECK(updater.pending() == 0);
+
+  TEST_CHECK(updater.fini() == 0);
+  ACE_Dynamic_Service<Update::Manager>::instance(ACE_TEXT("UpdateManagerSvc"))->remove(&updater);
+  ACE_OS::unlink(store_file);
+  return 0;
+}
@@ -0,0 +1,210 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+
+#include "dds/DCPS/transport/framework/PriorityQueue_T.h"
+
+#include "../common/TestSupport.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  /// An element of its own publication unless 'writer' is given.
+  struct Element {
+    Element(Priority priority, int id, int writer = 0)
+      : priority_(priority), id_(id), writer_(writer ? writer : -id) {}
+    Priority priority() const { return priority_; }
+    RepoId publication_id() const
+    {
+      RepoId pub = GUID_UNKNOWN;
+      std::memcpy(pub.guidPrefix, &writer_, sizeof writer_);
+      return pub;
+    }
+    Priority priority_;
+    int id_;
+    int writer_;
+  };
+
+  typedef PriorityQueue<Element> Queue;
+
+  /// Collects the ids of visited elements, removing the even ones and
+  /// stopping after 'limit' elements.
+  struct Collector : BasicQueueVisitor<Element> {
+    explicit Collector(size_t limit = 1000) : limit_(limit) {}
+
+    int visit_element(Element* element) {
+      ids_.push_back(element->id_);
+      return ids_.size() < limit_;
+    }
+
+    int visit_element_remove(Element* element, int& remove) {
+      remove = element->id_ % 2 == 0;
+      return visit_element(element);
+    }
+
+    size_t limit_;
+    std::vector<int> ids_;
+  };
+}
+
+int
+ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  // Higher priorities are served first, FIFO within one priority
+  {
+    Element a(0, 1), b(5, 2), c(0, 3), d(5, 4), e(-3, 5);
+    Queue queue;
+    TEST_CHECK(queue.get() == 0);
+    TEST_CHECK(queue.peek() == 0);
+
+    queue.put(&a);
+    queue.put(&b);
+    queue.put(&c);
+    queue.put(&d);
+    queue.put(&e);
+    TEST_CHECK(queue.size() == 5);
+
+    TEST_CHECK(queue.peek() == &b);
+    TEST_CHECK(queue.get() == &b);
+    TEST_CHECK(queue.get() == &d);
+    TEST_CHECK(queue.get() == &a);
+    TEST_CHECK(queue.get() == &c);
+    TEST_CHECK(queue.get() == &e);
+    TEST_CHECK(queue.get() == 0);
+    TEST_CHECK(queue.size() == 0);
+  }
+
+  // A level passed over FAIR_SHARE times in a row is served once
+  {
+    std::vector<Element> high, low;
+    for (int i = 0; i < 20; ++i) {
+      high.push_back(Element(10, i));
+    }
+    low.push_back(Element(0, 100));
+    low.push_back(Element(0, 101));
+
+    Queue queue;
+    for (size_t i = 0; i < high.size(); ++i) {
+      queue.put(&high[i]);
+    }
+    for (size_t i = 0; i < low.size(); ++i) {
+      queue.put(&low[i]);
+    }
+
+    std::vector<int> order;
+    while (Element* element = queue.get()) {
+      order.push_back(element->id_);
+    }
+
+    const size_t share = Queue::FAIR_SHARE;
+    TEST_CHECK(order.size() == 22);
+    TEST_CHECK(order.size() == 22 && order[share] == 100);
+    TEST_CHECK(order.size() == 22 && order[2 * share + 1] == 101);
+
+    // The high priority elements still come out in order
+    int next = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+      if (order[i] < 100) {
+        TEST_CHECK(order[i] == next);
+        ++next;
+      }
+    }
+    TEST_CHECK(next == 20);
+  }
+
+  // peek(), replace_head() and get() agree on the next element
+  {
+    Element a(1, 1), b(2, 2), c(2, 3);
+    Queue queue;
+    queue.put(&a);
+    queue.put(&b);
+    TEST_CHECK(queue.peek() == &b);
+    queue.replace_head(&c);
+    TEST_CHECK(queue.peek() == &c);
+    TEST_CHECK(queue.get() == &c);
+    TEST_CHECK(queue.get() == &a);
+  }
+
+  // Visitors see the elements from the highest to the lowest priority
+  {
+    Element a(1, 1), b(3, 2), c(2, 3), d(3, 4), e(1, 6);
+    Queue queue;
+    queue.put(&a);
+    queue.put(&b);
+    queue.put(&c);
+    queue.put(&d);
+    queue.put(&e);
+
+    Collector all;
+    queue.accept_visitor(all);
+    TEST_CHECK(all.ids_.size() == 5);
+    TEST_CHECK(all.ids_.size() == 5 && all.ids_[0] == 2 && all.ids_[1] == 4
+               && all.ids_[2] == 3 && all.ids_[3] == 1 && all.ids_[4] == 6);
+
+    // Stopping in one level leaves the lower levels alone
+    Collector first_three(3);
+    queue.accept_remove_visitor(first_three);
+    TEST_CHECK(first_three.ids_.size() == 3);
+    TEST_CHECK(queue.size() == 3);
+
+    TEST_CHECK(queue.get() == &c);
+    TEST_CHECK(queue.get() == &a);
+    TEST_CHECK(queue.get() == &e);
+    TEST_CHECK(queue.size() == 0);
+  }
+
+  // A writer whose priority changes stays in its level until drained
+  {
+    Element a(1, 1, 7), b(5, 2, 7), c(3, 3), d(5, 4, 7);
+    Queue queue;
+    queue.put(&a);
+    queue.put(&c);
+    queue.put(&b); // priority raised while 'a' is queued
+    TEST_CHECK(queue.get() == &c);
+    TEST_CHECK(queue.get() == &a);
+    TEST_CHECK(queue.get() == &b);
+
+    // Once drained the new priority applies
+    queue.put(&c);
+    queue.put(&d);
+    TEST_CHECK(queue.get() == &d);
+    TEST_CHECK(queue.get() == &c);
+    TEST_CHECK(queue.size() == 0);
+  }
+
+  // Removing a writer's last elements releases its level
+  {
+    Element a(1, 2, 7), b(1, 1), c(5, 4, 7);
+    Queue queue;
+    queue.put(&a);
+    queue.put(&b);
+    Collector evens;
+    queue.accept_remove_visitor(evens);
+    TEST_CHECK(queue.size() == 1);
+    queue.put(&c);
+    TEST_CHECK(queue.get() == &c);
+    TEST_CHECK(queue.get() == &b);
+  }
+
+  // swap() exchanges the contents
+  {
+    Element a(1, 1), b(2, 2);
+    Queue first, second;
+    first.put(&a);
+    first.put(&b);
+    first.swap(second);
+    TEST_CHECK(first.size() == 0 && first.get() == 0);
+    TEST_CHECK(second.size() == 2);
+    TEST_CHECK(second.get() == &b);
+  }
+
+  return 0;
+}
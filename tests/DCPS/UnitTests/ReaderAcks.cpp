@@ -0,0 +1,142 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+
+#include "dds/DCPS/transport/rtps_udp/ReaderAcks.h"
+#include "dds/DCPS/GuidUtils.h"
+
+#include "../common/TestSupport.h"
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  RepoId reader(unsigned char n)
+  {
+    RepoId id = GUID_UNKNOWN;
+    id.guidPrefix[11] = n;
+    id.entityId = ENTITYID_UNKNOWN;
+    id.entityId.entityKind = ENTITYKIND_USER_READER_WITH_KEY;
+    return id;
+  }
+
+  typedef OPENDDS_MAP_CMP(RepoId, SequenceNumber, GUID_tKeyLessThan) Model;
+
+  /// The per-reader acks and their minimum agree with 'model'.
+  bool consistent(const ReaderAcks& acks, const Model& model)
+  {
+    if (acks.size() != model.size()) {
+      return false;
+    }
+    SequenceNumber lowest = SequenceNumber::MAX_VALUE;
+    for (Model::const_iterator m = model.begin(); m != model.end(); ++m) {
+      SequenceNumber ack;
+      if (!acks.ack(m->first, ack) || ack != m->second) {
+        return false;
+      }
+      if (m->second < lowest) {
+        lowest = m->second;
+      }
+    }
+    return acks.acked_by_all() == lowest;
+  }
+}
+
+int
+ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  const RepoId a = reader(1), b = reader(2), c = reader(3);
+  SequenceNumber ack;
+
+  // The lowest ack is acked by all, new readers start with nothing acked
+  {
+    ReaderAcks acks;
+    TEST_CHECK(acks.acked_by_all() == SequenceNumber::MAX_VALUE);
+
+    TEST_CHECK(acks.add(a));
+    TEST_CHECK(acks.add(b));
+    TEST_CHECK(!acks.add(a)); // already tracked, its ack is kept
+    TEST_CHECK(acks.size() == 2);
+    TEST_CHECK(acks.acked_by_all() == SequenceNumber());
+
+    acks.update(a, 10);
+    TEST_CHECK(acks.acked_by_all() == SequenceNumber());
+    acks.update(b, 5);
+    TEST_CHECK(acks.acked_by_all() == 5);
+    acks.update(b, 12);
+    TEST_CHECK(acks.acked_by_all() == 10);
+
+    TEST_CHECK(!acks.add(a));
+    TEST_CHECK(acks.ack(a, ack) && ack == 10);
+
+    acks.add(c);
+    TEST_CHECK(acks.acked_by_all() == SequenceNumber());
+    acks.remove(c);
+    TEST_CHECK(acks.acked_by_all() == 10);
+    acks.remove(a);
+    TEST_CHECK(acks.acked_by_all() == 12);
+    acks.remove(b);
+    TEST_CHECK(acks.size() == 0);
+    TEST_CHECK(acks.acked_by_all() == SequenceNumber::MAX_VALUE);
+  }
+
+  // Readers with the same ack each count
+  {
+    ReaderAcks acks;
+    acks.add(a);
+    acks.add(b);
+    acks.update(a, 7);
+    acks.update(b, 7);
+    acks.update(b, 7); // unchanged
+    TEST_CHECK(acks.acked_by_all() == 7);
+    acks.update(a, 9);
+    TEST_CHECK(acks.acked_by_all() == 7);
+    acks.remove(b);
+    TEST_CHECK(acks.acked_by_all() == 9);
+  }
+
+  // Unknown readers are ignored
+  {
+    ReaderAcks acks;
+    acks.update(a, 3);
+    acks.remove(a);
+    TEST_CHECK(acks.size() == 0);
+    TEST_CHECK(!acks.ack(a, ack));
+    TEST_CHECK(acks.acked_by_all() == SequenceNumber::MAX_VALUE);
+  }
+
+  // Any mix of operations agrees with a map of each reader's ack
+  {
+    ReaderAcks acks;
+    Model model;
+    unsigned int state = 12345;
+    for (int i = 0; i < 5000; ++i) {
+      state = state * 1103515245 + 12345;
+      const RepoId id = reader(static_cast<unsigned char>((state >> 8) % 16));
+      const SequenceNumber seq(static_cast<SequenceNumber::Value>((state >> 16) % 100 + 1));
+      switch ((state >> 4) % 4) {
+      case 0:
+        TEST_CHECK(acks.add(id) == (model.find(id) == model.end()));
+        model.insert(Model::value_type(id, SequenceNumber()));
+        break;
+      case 1:
+        acks.remove(id);
+        model.erase(id);
+        break;
+      default:
+        acks.update(id, seq);
+        if (model.find(id) != model.end()) {
+          model[id] = seq;
+        }
+        break;
+      }
+      TEST_CHECK(consistent(acks, model));
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+
+#include "dds/DCPS/transport/framework/TransportInst.h"
+#include "dds/DCPS/transport/framework/TransportReceiveStrategy_T.h"
+#include "dds/DCPS/transport/framework/TransportImpl.h"
+
+#include "../common/TestSupport.h"
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  class Inst : public TransportInst {
+  public:
+    Inst() : TransportInst("test", "ReceivePool") {}
+
+    bool is_reliable() const { return false; }
+    size_t populate_locator(TransportLocator&) const { return 0; }
+
+  private:
+    TransportImpl_rch new_impl() { return TransportImpl_rch(); }
+  };
+
+  /// Receives nothing: each handle_dds_input() fills every receive buffer
+  /// slot from the pool and then sees a graceful disconnect.
+  class Strategy : public TransportReceiveStrategy<> {
+  public:
+    explicit Strategy(const TransportInst& config)
+      : TransportReceiveStrategy<>(config)
+    {
+      gracefully_disconnected_ = true;
+    }
+
+  private:
+    ssize_t receive_bytes(iovec[], int, ACE_INET_Addr&, ACE_HANDLE) { return 0; }
+    void deliver_sample(ReceivedDataSample&, const ACE_INET_Addr&) {}
+    int start_i() { return 0; }
+    void stop_i() {}
+  };
+
+  /// Receive buffers handle_dds_input() keeps ready for reading.
+  const size_t RECEIVE_BUFFERS = 16;
+}
+
+int
+ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  // By default the pool doesn't grow, the heap covers the rest
+  {
+    Inst config;
+    TEST_CHECK(config.receive_pool_buffers_ == DEFAULT_CONFIG_RECEIVE_POOL_BUFFERS);
+    TEST_CHECK(config.receive_pool_max_buffers_ == 0);
+
+    config.receive_pool_buffers_ = 4;
+    Strategy strategy(config);
+    ReceivePoolStats stats = strategy.receive_pool_stats();
+    TEST_CHECK(stats.buffers_ == 4);
+    TEST_CHECK(stats.buffers_available_ == 4);
+    TEST_CHECK(stats.pool_allocs_ == 0);
+    TEST_CHECK(stats.heap_allocs_ == 0);
+
+    TEST_CHECK(strategy.handle_dds_input(ACE_INVALID_HANDLE) == -1);
+    stats = strategy.receive_pool_stats();
+    TEST_CHECK(stats.buffers_ == 4);
+    TEST_CHECK(stats.buffers_available_ == 0);
+    TEST_CHECK(stats.pool_allocs_ == 4);
+    TEST_CHECK(stats.heap_allocs_ == RECEIVE_BUFFERS - 4);
+  }
+
+  // A larger receive_pool_max_buffers lets the pool grow instead
+  {
+    Inst config;
+    config.receive_pool_buffers_ = 4;
+    config.receive_pool_max_buffers_ = RECEIVE_BUFFERS;
+    Strategy strategy(config);
+    TEST_CHECK(strategy.receive_pool_stats().buffers_ == 4);
+
+    TEST_CHECK(strategy.handle_dds_input(ACE_INVALID_HANDLE) == -1);
+    const ReceivePoolStats stats = strategy.receive_pool_stats();
+    TEST_CHECK(stats.buffers_ == RECEIVE_BUFFERS);
+    TEST_CHECK(stats.buffers_available_ == 0);
+    TEST_CHECK(stats.pool_allocs_ == RECEIVE_BUFFERS);
+    TEST_CHECK(stats.heap_allocs_ == 0);
+  }
+
+  // Growth stops at receive_pool_max_buffers
+  {
+    Inst config;
+    config.receive_pool_buffers_ = 4;
+    config.receive_pool_max_buffers_ = 10;
+    Strategy strategy(config);
+
+    TEST_CHECK(strategy.handle_dds_input(ACE_INVALID_HANDLE) == -1);
+    const ReceivePoolStats stats = strategy.receive_pool_stats();
+    TEST_CHECK(stats.buffers_ == 10);
+    TEST_CHECK(stats.pool_allocs_ == 10);
+    TEST_CHECK(stats.heap_allocs_ == RECEIVE_BUFFERS - 10);
+  }
+
+  return 0;
+}
@@ -0,0 +1,241 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+
+#include "dds/DCPS/transport/rtps_udp/RtpsBundler.h"
+#include "dds/DCPS/transport/rtps_udp/RtpsSampleHeader.h"
+#include "dds/DCPS/RTPS/RtpsCoreTypeSupportImpl.h"
+#include "dds/DCPS/Serializer.h"
+
+#include "../common/TestSupport.h"
+
+#include <cstring>
+#include <string>
+
+using namespace OpenDDS::DCPS;
+using OpenDDS::RTPS::RTPSHDR_SZ;
+
+namespace {
+  struct Datagram {
+    ACE_INET_Addr addr_;
+    std::string bytes_;
+  };
+
+  struct Recorder : RtpsBundler::Sender {
+    void send_bundle(const iovec iov[], int n, const ACE_INET_Addr& addr)
+    {
+      Datagram datagram;
+      datagram.addr_ = addr;
+      for (int i = 0; i < n; ++i) {
+        datagram.bytes_.append(static_cast<const char*>(iov[i].iov_base),
+                               iov[i].iov_len);
+      }
+      sent_.push_back(datagram);
+    }
+
+    OPENDDS_VECTOR(Datagram) sent_;
+  };
+
+  /// An RTPS message of 'size' bytes: a header of 'h' followed by 'body'.
+  /// The header is split across two iovecs, as the bundler must skip it
+  /// wherever it ends.
+  struct Message {
+    Message(char body, size_t size)
+      : header_(RTPSHDR_SZ, 'h'), body_(size - RTPSHDR_SZ, body)
+    {
+      iov_[0].iov_base = &header_[0];
+      iov_[0].iov_len = 8;
+      iov_[1].iov_base = &header_[8];
+      iov_[1].iov_len = RTPSHDR_SZ - 8;
+      iov_[2].iov_base = &body_[0];
+      iov_[2].iov_len = static_cast<u_long>(body_.size());
+    }
+
+    size_t size() const { return header_.size() + body_.size(); }
+
+    std::string header_, body_;
+    iovec iov_[3];
+  };
+
+  const char rtps_header[RTPSHDR_SZ + 1] = "RTPS0123456789abcdef";
+  const size_t INFO_DST_SIZE = RtpsBundler::INFO_DST_TOTAL;
+
+  /// Add the RTPS message in 'mb' to 'bundler'.
+  bool add(RtpsBundler& bundler, const ACE_Message_Block& mb,
+           const ACE_INET_Addr& addr)
+  {
+    iovec iov[1];
+    iov[0].iov_base = mb.rd_ptr();
+    iov[0].iov_len = static_cast<u_long>(mb.length());
+    return bundler.add(iov, 1, mb.length(), addr);
+  }
+}
+
+int
+ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  const ACE_INET_Addr a(u_short(7400), "127.0.0.1"), b(u_short(7401), "127.0.0.1");
+
+  // Messages wait until they are flushed, then go out as one datagram
+  {
+    Recorder recorder;
+    RtpsBundler bundler(recorder, rtps_header, 1000);
+    Message first('a', RTPSHDR_SZ + 24), second('b', RTPSHDR_SZ + 32);
+
+    TEST_CHECK(bundler.add(first.iov_, 3, first.size(), a));
+    TEST_CHECK(!bundler.add(second.iov_, 3, second.size(), a));
+    TEST_CHECK(recorder.sent_.empty());
+    TEST_CHECK(bundler.pending(a) == RTPSHDR_SZ + 24 + INFO_DST_SIZE + 32);
+
+    bundler.send_all();
+    TEST_CHECK(recorder.sent_.size() == 1);
+    const Datagram& datagram = recorder.sent_[0];
+    TEST_CHECK(datagram.addr_ == a);
+    TEST_CHECK(datagram.bytes_ == std::string(rtps_header, RTPSHDR_SZ)
+               + std::string(24, 'a')
+               + datagram.bytes_.substr(RTPSHDR_SZ + 24, INFO_DST_SIZE)
+               + std::string(32, 'b'));
+    TEST_CHECK(datagram.bytes_.size() > RTPSHDR_SZ + 24 &&
+               datagram.bytes_[RTPSHDR_SZ + 24] == OpenDDS::RTPS::INFO_DST);
+    TEST_CHECK(bundler.pending(a) == 0);
+
+    // Nothing more to send, the next flush forgets the address
+    bundler.send_all();
+    TEST_CHECK(recorder.sent_.size() == 1);
+    TEST_CHECK(bundler.add(first.iov_, 3, first.size(), a));
+  }
+
+  // A message that doesn't fit sends the bundle it would have joined
+  {
+    Recorder recorder;
+    RtpsBundler bundler(recorder, rtps_header, 100);
+    Message message('m', 60);
+
+    TEST_CHECK(bundler.add(message.iov_, 3, message.size(), a));
+    TEST_CHECK(bundler.pending(a) == 60);
+    TEST_CHECK(bundler.add(message.iov_, 3, message.size(), a));
+    TEST_CHECK(recorder.sent_.size() == 1);
+    TEST_CHECK(recorder.sent_[0].bytes_.size() == 60);
+    TEST_CHECK(bundler.pending(a) == 60);
+
+    // Exactly max_size() bytes fit
+    Message small('s', 100 - 60 - INFO_DST_SIZE + RTPSHDR_SZ);
+    TEST_CHECK(!bundler.add(small.iov_, 3, small.size(), a));
+    TEST_CHECK(bundler.pending(a) == 100);
+    TEST_CHECK(recorder.sent_.size() == 1);
+
+    bundler.send_all();
+    TEST_CHECK(recorder.sent_.size() == 2);
+    for (size_t i = 0; i < recorder.sent_.size(); ++i) {
+      TEST_CHECK(recorder.sent_[i].bytes_.size() <= bundler.max_size());
+    }
+  }
+
+  // Each address has its own bundle
+  {
+    Recorder recorder;
+    RtpsBundler bundler(recorder, rtps_header, 1000);
+    Message message('m', RTPSHDR_SZ + 8);
+
+    TEST_CHECK(bundler.add(message.iov_, 3, message.size(), a));
+    TEST_CHECK(bundler.add(message.iov_, 3, message.size(), b));
+    TEST_CHECK(bundler.pending(a) == RTPSHDR_SZ + 8);
+    TEST_CHECK(bundler.pending(b) == RTPSHDR_SZ + 8);
+
+    bundler.send(a);
+    TEST_CHECK(recorder.sent_.size() == 1 && recorder.sent_[0].addr_ == a);
+    TEST_CHECK(bundler.pending(a) == 0);
+    TEST_CHECK(bundler.pending(b) == RTPSHDR_SZ + 8);
+
+    bundler.send(a); // empty, nothing is sent
+    TEST_CHECK(recorder.sent_.size() == 1);
+
+    bundler.send_all();
+    TEST_CHECK(recorder.sent_.size() == 2 && recorder.sent_[1].addr_ == b);
+  }
+
+  // A DATA submessage extends to the end of its message, it gets its
+  // length before anything is bundled after it
+  {
+    using namespace OpenDDS::RTPS;
+    const ACE_CDR::Octet flags = ACE_CDR_BYTE_ORDER, FLAG_D = 4;
+    const EntityId_t writer = {{0, 0, 1}, ENTITYKIND_USER_WRITER_WITH_KEY};
+    // CDR_LE encapsulation followed by a payload that isn't 4 byte aligned
+    const char payload[] = "\x00\x01\x00\x00hello";
+    const size_t payload_size = sizeof payload - 1;
+
+    ACE_Message_Block data_msg(256);
+    data_msg.copy(rtps_header, RTPSHDR_SZ);
+    {
+      Serializer ser(&data_msg, false, Serializer::ALIGN_CDR);
+      const InfoTimestampSubmessage ts = {{INFO_TS, flags, INFO_TS_SZ}, {1, 2}};
+      const DataSubmessage data = {
+        {DATA, static_cast<ACE_CDR::Octet>(flags | FLAG_D), 0},
+        0, DATA_OCTETS_TO_IQOS, ENTITYID_UNKNOWN, writer, {0, 7},
+        ParameterList()
+      };
+      TEST_CHECK(ser << ts);
+      TEST_CHECK(ser << data);
+    }
+    data_msg.copy(payload, payload_size);
+
+    ACE_Message_Block hb_msg(256);
+    hb_msg.copy(rtps_header, RTPSHDR_SZ);
+    {
+      Serializer ser(&hb_msg, false, Serializer::ALIGN_CDR);
+      const HeartBeatSubmessage hb = {
+        {HEARTBEAT, flags, HEARTBEAT_SZ},
+        ENTITYID_UNKNOWN, writer, {0, 1}, {0, 7}, {1}
+      };
+      TEST_CHECK(ser << hb);
+    }
+
+    Recorder recorder;
+    RtpsBundler bundler(recorder, rtps_header, 1000);
+    TEST_CHECK(add(bundler, data_msg, a));
+    TEST_CHECK(!add(bundler, hb_msg, a));
+    bundler.send_all();
+    TEST_CHECK(recorder.sent_.size() == 1);
+    const std::string& bytes = recorder.sent_[0].bytes_;
+    TEST_CHECK(bytes.size() % 4 == 0);
+
+    // Parse the bundle the way RtpsUdpReceiveStrategy does
+    ACE_Message_Block mb(bytes.size());
+    mb.copy(bytes.data(), bytes.size());
+    mb.rd_ptr(RTPSHDR_SZ);
+    OPENDDS_VECTOR(SubmessageKind) kinds;
+    while (mb.length()) {
+      RtpsSampleHeader header;
+      header.pdu_remaining(mb.length());
+      header = mb;
+      if (!header.valid()) {
+        break;
+      }
+      kinds.push_back(header.submessage_._d());
+      if (header.submessage_._d() == DATA) {
+        // The payload now ends with the padding
+        TEST_CHECK(header.message_length() == payload_size + 3);
+        TEST_CHECK(std::memcmp(mb.rd_ptr(), payload, payload_size) == 0);
+        TEST_CHECK(header.submessage_.data_sm().writerSN.low == 7);
+      } else if (header.submessage_._d() == HEARTBEAT) {
+        TEST_CHECK(header.submessage_.heartbeat_sm().lastSN.low == 7);
+      }
+      mb.rd_ptr(header.message_length());
+    }
+    TEST_CHECK(mb.length() == 0);
+    TEST_CHECK(kinds.size() == 4);
+    if (kinds.size() == 4) {
+      TEST_CHECK(kinds[0] == INFO_TS);
+      TEST_CHECK(kinds[1] == DATA);
+      TEST_CHECK(kinds[2] == INFO_DST);
+      TEST_CHECK(kinds[3] == HEARTBEAT);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+
+#include "dds/DCPS/DataSampleElement.h"
+#include "dds/DCPS/DataSampleHeader.h"
+#include "dds/DCPS/GuidUtils.h"
+#include "dds/DCPS/Serializer.h"
+
+#include "dds/DCPS/RTPS/MessageTypes.h"
+#include "dds/DCPS/RTPS/RtpsCoreTypeSupportImpl.h"
+
+#include "dds/DCPS/transport/rtps_udp/RtpsSampleHeader.h"
+
+#include "../common/TestSupport.h"
+
+#include <cstring>
+
+using namespace OpenDDS::DCPS;
+using namespace OpenDDS::RTPS;
+
+namespace {
+  RepoId guid(unsigned char participant, unsigned char entity,
+              unsigned char kind)
+  {
+    RepoId id = GUID_UNKNOWN;
+    for (unsigned char i = 0; i < sizeof(GuidPrefix_t); ++i) {
+      id.guidPrefix[i] = static_cast<CORBA::Octet>(participant + i);
+    }
+    id.entityId.entityKey[0] = 0x11;
+    id.entityId.entityKey[1] = 0x22;
+    id.entityId.entityKey[2] = entity;
+    id.entityId.entityKind = kind;
+    return id;
+  }
+
+  /// The submessages serialized the way RtpsUdpDataLink does for the
+  /// general case (in-line GAPs or QoS).
+  ACE_Message_Block* serialize(const SubmessageSeq& subm)
+  {
+    size_t size = 0, padding = 0;
+    for (CORBA::ULong i = 0; i < subm.length(); ++i) {
+      if ((size + padding) % 4) {
+        padding += 4 - ((size + padding) % 4);
+      }
+      gen_find_size(subm[i], size, padding);
+    }
+
+    ACE_Message_Block* hdr = new ACE_Message_Block(size + padding);
+    for (CORBA::ULong i = 0; i < subm.length(); ++i) {
+      Serializer ser(hdr, false, Serializer::ALIGN_CDR);
+      ser << subm[i];
+      const size_t len = hdr->length();
+      if (len % 4) {
+        hdr->wr_ptr(4 - (len % 4));
+      }
+    }
+    return hdr;
+  }
+
+  /// marshal_data_sample_header() writes the same bytes as
+  /// populate_data_sample_submessages() and the generic serialization.
+  bool same_bytes(const DataSampleElement& dsle)
+  {
+    ACE_Message_Block payload(64);
+    Message_Block_Ptr direct(
+      RtpsSampleHeader::marshal_data_sample_header(payload, dsle));
+
+    SubmessageSeq subm;
+    RtpsSampleHeader::populate_data_sample_submessages(subm, dsle, false);
+    Message_Block_Ptr generic(serialize(subm));
+
+    return direct && generic && direct->length() == generic->length()
+      && std::memcmp(direct->rd_ptr(), generic->rd_ptr(),
+                     generic->length()) == 0;
+  }
+}
+
+int
+ACE_TMAIN(int, ACE_TCHAR*[])
+{
+  const RepoId writer = guid(1, 1, ENTITYKIND_USER_WRITER_WITH_KEY);
+  const RepoId readers[] = {
+    guid(20, 2, ENTITYKIND_USER_READER_WITH_KEY),
+    guid(40, 3, ENTITYKIND_USER_READER_WITH_KEY),
+    guid(60, 4, ENTITYKIND_USER_READER_WITH_KEY)
+  };
+
+  for (int order = 0; order < 2; ++order) {
+    DataSampleElement dsle(writer, 0, PublicationInstance_rch());
+    DataSampleHeader& header = dsle.get_header();
+    header.message_id_ = SAMPLE_DATA;
+    header.byte_order_ = order == 1;
+    header.source_timestamp_sec_ = 0x01020304;
+    header.source_timestamp_nanosec_ = 123456789;
+    header.sequence_ = SequenceNumber(0x0506070809LL);
+
+    // No subscriber: DATA to ENTITYID_UNKNOWN, no INFO_DST
+    TEST_CHECK(same_bytes(dsle));
+
+    // One subscriber: INFO_DST with its prefix, DATA to its entityId
+    dsle.set_num_subs(1);
+    dsle.set_sub_id(0, readers[0]);
+    TEST_CHECK(same_bytes(dsle));
+
+    // Many subscribers: no INFO_DST, DATA to ENTITYID_UNKNOWN
+    dsle.set_num_subs(3);
+    dsle.set_sub_id(1, readers[1]);
+    dsle.set_sub_id(2, readers[2]);
+    TEST_CHECK(same_bytes(dsle));
+
+    // The fraction of a second is rounded the same way
+    header.source_timestamp_nanosec_ = 999999999;
+    TEST_CHECK(same_bytes(dsle));
+    dsle.set_num_subs(1);
+    TEST_CHECK(same_bytes(dsle));
+  }
+
+  return 0;
+}
@@ -0,0 +1,191 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ace/OS_main.h"
+
+#include "dds/DCPS/transport/rtps_udp/RtpsUdpShmem.h"
+
+#include "../common/TestSupport.h"
+
+#include "ace/Reactor.h"
+#include "ace/OS_NS_sys_time.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace OpenDDS::DCPS;
+
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+namespace {
+  const size_t POOL_SIZE = 64 * 1024;
+  const u_short PORT = 7410;
+
+  /// Number of 'size' byte messages 'outbox' sends before the inbox is full.
+  size_t fill(RtpsShmemOutbox& outbox, size_t size)
+  {
+    std::string message(size, 'm');
+    iovec iov[1];
+    iov[0].iov_base = &message[0];
+    iov[0].iov_len = static_cast<u_long>(size);
+    size_t sent = 0;
+    while (sent < POOL_SIZE && outbox.send(iov, 1, PORT)) {
+      ++sent;
+    }
+    return sent;
+  }
+
+  bool send(RtpsShmemOutbox& outbox, const char* message)
+  {
+    // In two pieces, as the transport gathers the header and the data
+    const size_t size = std::strlen(message);
+    iovec iov[2];
+    iov[0].iov_base = const_cast<char*>(message);
+    iov[0].iov_len = static_cast<u_long>(size / 2);
+    iov[1].iov_base = const_cast<char*>(message) + size / 2;
+    iov[1].iov_len = static_cast<u_long>(size - size / 2);
+    return outbox.send(iov, 2, PORT + 100);
+  }
+
+  /// Reads the inbox the way RtpsUdpReceiveStrategy::handle_input does
+  /// when the reactor delivers the inbox's notification.
+  struct Receiver : ACE_Event_Handler {
+    explicit Receiver(RtpsShmemInbox& inbox)
+      : inbox_(inbox), notifications_(0) {}
+
+    int handle_input(ACE_HANDLE fd)
+    {
+      if (fd != ACE_INVALID_HANDLE) {
+        return 0;
+      }
+      ++notifications_;
+      while (inbox_.readable()) {
+        char buffer[64];
+        iovec iov[1];
+        iov[0].iov_base = buffer;
+        iov[0].iov_len = sizeof buffer;
+        const ssize_t size = inbox_.read(iov, 1, from_);
+        messages_.push_back(std::string(buffer, size));
+      }
+      return 0;
+    }
+
+    /// Run 'reactor' until 'count' messages were read or 'seconds' passed.
+    void run(ACE_Reactor& reactor, size_t count, int seconds)
+    {
+      const ACE_Time_Value deadline =
+        ACE_OS::gettimeofday() + ACE_Time_Value(seconds);
+      while (messages_.size() < count && ACE_OS::gettimeofday() < deadline) {
+        ACE_Time_Value wait(0, 100000);
+        reactor.handle_events(wait);
+      }
+    }
+
+    RtpsShmemInbox& inbox_;
+    size_t notifications_;
+    std::vector<std::string> messages_;
+    ACE_INET_Addr from_;
+  };
+}
+#endif
+
+int
+ACE_TMAIN(int, ACE_TCHAR*[])
+{
+#ifdef OPENDDS_RTPS_UDP_SHMEM
+  // Looking for an inbox that doesn't exist doesn't create its pool
+  {
+    RtpsShmemInbox inbox;
+    TEST_CHECK(inbox.open(PORT, POOL_SIZE));
+    TEST_CHECK(shmem_inbox_exists(inbox.locator()));
+
+    Locator_t missing = inbox.locator();
+    missing.port = PORT + 1;
+    TEST_CHECK(!shmem_inbox_exists(missing));
+    RtpsShmemOutbox outbox(missing);
+    TEST_CHECK(!outbox.is_open());
+    TEST_CHECK(!shmem_inbox_exists(missing));
+  }
+
+  // Once the inbox is closed nothing more is queued
+  {
+    RtpsShmemInbox inbox;
+    TEST_CHECK(inbox.open(PORT + 2, POOL_SIZE));
+    RtpsShmemOutbox outbox(inbox.locator());
+    TEST_CHECK(outbox.is_open());
+
+    char data[] = "RTPS";
+    iovec iov[1];
+    iov[0].iov_base = data;
+    iov[0].iov_len = sizeof data;
+    TEST_CHECK(outbox.send(iov, 1, PORT));
+    inbox.close();
+    TEST_CHECK(!inbox.is_open());
+    TEST_CHECK(!outbox.send(iov, 1, PORT));
+  }
+
+  // A pool left behind with messages in it is replaced by an empty one
+  {
+    // Never closed, as if its process had died
+    RtpsShmemInbox* const stale = new RtpsShmemInbox;
+    TEST_CHECK(stale->open(PORT + 4, POOL_SIZE));
+    size_t capacity = 0;
+    {
+      RtpsShmemOutbox outbox(stale->locator());
+      capacity = fill(outbox, 1000);
+      TEST_CHECK(capacity > 0 && capacity < POOL_SIZE);
+    }
+
+    RtpsShmemInbox inbox;
+    TEST_CHECK(inbox.open(PORT + 4, POOL_SIZE));
+    RtpsShmemOutbox outbox(inbox.locator());
+    TEST_CHECK(outbox.is_open());
+    TEST_CHECK(fill(outbox, 1000) == capacity);
+  }
+
+  // Messages go through the inbox thread and the reactor to read()
+  {
+    RtpsShmemInbox inbox;
+    TEST_CHECK(inbox.open(PORT + 6, POOL_SIZE));
+    ACE_Reactor reactor;
+    Receiver receiver(inbox);
+    TEST_CHECK(inbox.start(&reactor, &receiver));
+
+    RtpsShmemOutbox outbox(inbox.locator());
+    TEST_CHECK(outbox.is_open());
+    TEST_CHECK(send(outbox, "first"));
+    TEST_CHECK(send(outbox, "second"));
+    TEST_CHECK(send(outbox, "third"));
+    receiver.run(reactor, 3, 5);
+    TEST_CHECK(receiver.messages_.size() == 3);
+    TEST_CHECK(receiver.messages_.size() == 3
+               && receiver.messages_[0] == "first"
+               && receiver.messages_[1] == "second"
+               && receiver.messages_[2] == "third");
+    TEST_CHECK(receiver.notifications_ >= 1);
+    TEST_CHECK(receiver.from_.get_port_number() == PORT + 100);
+    TEST_CHECK(receiver.from_.is_loopback());
+
+    // Once drained, the next message notifies the reactor again
+    const size_t notifications = receiver.notifications_;
+    TEST_CHECK(send(outbox, "fourth"));
+    receiver.run(reactor, 4, 5);
+    TEST_CHECK(receiver.messages_.size() == 4
+               && receiver.messages_[3] == "fourth");
+    TEST_CHECK(receiver.notifications_ > notifications);
+
+    // Nothing is delivered after stop()
+    inbox.stop();
+    TEST_CHECK(send(outbox, "fifth"));
+    receiver.run(reactor, 5, 1);
+    TEST_CHECK(receiver.messages_.size() == 4);
+    inbox.close();
+  }
+#endif
+
+  return 0;
+}
@@ -10,6 +10,11 @@
 #include "dds/DCPS/Service_Participant.h"
 #include "dds/DCPS/DataWriterImpl_T.h"
 #include "dds/DCPS/Message_Block_Ptr.h"
+#include "dds/DCPS/GuardCondition.h"
+#ifdef ACE_AS_STATIC_LIBS
+#include "dds/DCPS/RTPS/RtpsDiscovery.h"
+#include "dds/DCPS/transport/rtps_udp/RtpsUdp.h"
+#endif
 
 #include "../common/TestSupport.h"
 
@@ -137,6 +142,21 @@ public:
 
   ACE_Recursive_Thread_Mutex& lock_wdc(WriteDataContainer* wdc) { return wdc->lock_; }
 
+  DDS::GuardConditionInterf_ptr writable_condition(DataWriterImpl* dw) const
+  {
+    return dw->writable_condition_.in();
+  }
+
+  WriteDataContainer* data_container(DataWriterImpl* dw) const
+  {
+    return dw->data_container_.get();
+  }
+
+  DDS::GuardConditionInterf_ptr writable_condition(WriteDataContainer* wdc) const
+  {
+    return wdc->writable_condition_.in();
+  }
+
   WriteDataContainer* get_test_data_container(::DDS::DataWriterQos const & dw_qos,
     Test::SimpleDataWriterImpl* fast_dw)
   {
@@ -860,6 +880,135 @@ int run_test(int argc, ACE_TCHAR *argv[])
         } //End Test Case 4 scope
 
 
+
+        { //Test Case 5 scope
+          //=====================================================
+          ACE_DEBUG((LM_INFO,
+                     ACE_TEXT("\n\n==== TEST case 5 : Reliable, Keep All, max_samples_per_instance = 2, max_blocking_time = 0.\n")
+                     ACE_TEXT("Writable condition: triggered once a sample is dropped or delivered after obtain buffer gave up\n")
+                     ACE_TEXT("===============================================\n")));
+
+          // A writer of a real participant, created disabled so that the
+          // condition is set before enable() creates the container.
+          DDS::DomainParticipant_var dp =
+            dpf->create_participant(MY_DOMAIN,
+                                    PARTICIPANT_QOS_DEFAULT,
+                                    DDS::DomainParticipantListener::_nil(),
+                                    ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+          TEST_CHECK(!CORBA::is_nil(dp.in()));
+
+          Test::SimpleTypeSupport_var ts = new Test::SimpleTypeSupportImpl;
+          TEST_CHECK(ts->register_type(dp.in(), MY_TYPE) == DDS::RETCODE_OK);
+
+          DDS::Topic_var topic =
+            dp->create_topic(MY_TOPIC,
+                             MY_TYPE,
+                             TOPIC_QOS_DEFAULT,
+                             DDS::TopicListener::_nil(),
+                             ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+          TEST_CHECK(!CORBA::is_nil(topic.in()));
+
+          DDS::PublisherQos pub_qos;
+          dp->get_default_publisher_qos(pub_qos);
+          pub_qos.entity_factory.autoenable_created_entities = false;
+          DDS::Publisher_var pub =
+            dp->create_publisher(pub_qos,
+                                 DDS::PublisherListener::_nil(),
+                                 ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+          TEST_CHECK(!CORBA::is_nil(pub.in()));
+
+          DDS::DataWriterQos writer_qos;
+          pub->get_default_datawriter_qos(writer_qos);
+          writer_qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+          writer_qos.reliability.max_blocking_time.sec = 0;
+          writer_qos.reliability.max_blocking_time.nanosec = 0;
+          writer_qos.history.kind = ::DDS::KEEP_ALL_HISTORY_QOS;
+          writer_qos.resource_limits.max_samples_per_instance = MAX_SAMPLES_PER_INSTANCE;
+
+          DDS::DataWriter_var dw =
+            pub->create_datawriter(topic.in(),
+                                   writer_qos,
+                                   DDS::DataWriterListener::_nil(),
+                                   ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+          Test::SimpleDataWriterImpl* const fast_dw =
+            dynamic_cast<Test::SimpleDataWriterImpl*>(dw.in());
+          TEST_CHECK(fast_dw != 0);
+          TEST_CHECK(!fast_dw->is_enabled());
+          TEST_CHECK(test->data_container(fast_dw) == 0);
+          TEST_CHECK(fast_dw->pending_samples() == 0);
+
+          // The writer keeps the condition until enable() hands it to the
+          // container it creates.
+          DDS::GuardCondition_var writable = new DDS::GuardCondition;
+          fast_dw->set_writable_condition(writable.in());
+          TEST_CHECK(test->writable_condition(fast_dw) == writable.in());
+
+          TEST_CHECK(fast_dw->enable() == DDS::RETCODE_OK);
+          WriteDataContainer* const test_data_container = test->data_container(fast_dw);
+          TEST_CHECK(test_data_container != 0);
+          TEST_CHECK(test->writable_condition(test_data_container) == writable.in());
+
+          Test::Simple foo1;
+          foo1.key  = 1;
+          foo1.count = 1;
+
+          Message_Block_Ptr mb(test->dds_marshal(fast_dw.get(), foo1, OpenDDS::DCPS::KEY_ONLY_MARSHALING));
+
+          ::DDS::InstanceHandle_t handle1 = DDS::HANDLE_NIL;
+          TEST_CHECK(test_data_container->register_instance(handle1, mb) == DDS::RETCODE_OK);
+
+          ACE_GUARD_RETURN (ACE_Recursive_Thread_Mutex,
+                            guard,
+                            test->lock_wdc(test_data_container),
+                            ::DDS::RETCODE_ERROR);
+
+          DataSampleElement* elements[2] = {0, 0};
+          for (int i = 0; i < 2; ++i) {
+            Message_Block_Ptr sample(test->dds_marshal(fast_dw.get(), foo1, OpenDDS::DCPS::KEY_ONLY_MARSHALING));
+            TEST_CHECK(test_data_container->obtain_buffer(elements[i], handle1) == DDS::RETCODE_OK);
+            elements[i]->set_sample(OpenDDS::DCPS::move(sample));
+            TEST_CHECK(test_data_container->enqueue(elements[i], handle1) == DDS::RETCODE_OK);
+          }
+
+          TEST_CHECK(fast_dw->pending_samples() == 2);
+
+          SendStateDataSampleList temp;
+          test_data_container->get_unsent_data(temp);
+
+          // Nothing was refused yet, so delivery alone doesn't trigger it.
+          TEST_CHECK(!writable->get_trigger_value());
+
+          DataSampleElement* element_2 = 0;
+          TEST_CHECK(test_data_container->obtain_buffer(element_2, handle1) == DDS::RETCODE_TIMEOUT);
+          TEST_CHECK(!writable->get_trigger_value());
+
+          // A sample the transport gives back wakes blocked writers, so it
+          // has to trigger the condition as well.
+          test_data_container->data_dropped(elements[0], false);
+          TEST_CHECK(writable->get_trigger_value());
+          writable->set_trigger_value(false);
+
+          TEST_CHECK(test_data_container->obtain_buffer(element_2, handle1) == DDS::RETCODE_TIMEOUT);
+          temp.reset();
+          test_data_container->get_unsent_data(temp);
+          test_data_container->data_delivered(elements[1]);
+          TEST_CHECK(writable->get_trigger_value());
+          writable->set_trigger_value(false);
+
+          // Triggered once per refusal, not on every delivery.
+          test_data_container->data_delivered(elements[0]);
+          TEST_CHECK(!writable->get_trigger_value());
+
+          test_data_container->release_buffer(elements[0]);
+          test_data_container->release_buffer(elements[1]);
+          test_data_container->unregister_all();
+          guard.release();
+
+          // The container belongs to the writer.
+          dp->delete_contained_entities();
+          dpf->delete_participant(dp.in());
+        } //End Test Case 5 scope
+
       }//test scope
       catch (const TestException&)
       {
@@ -12,7 +12,7 @@ use PerlDDS::Run_Test;
 
 $status = 0;
 
-$parameters = "-DcpsBit 0 -ORBVerboseLogging 1 -DCPSDebugLevel 10";
+$parameters = "-DCPSConfigFile rtps.ini -DcpsBit 0 -ORBVerboseLogging 1 -DCPSDebugLevel 10";
 
 if ($ARGV[0] eq 'by_instance') {
   $parameters .= " -i";
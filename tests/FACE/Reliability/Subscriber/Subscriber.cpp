@@ -1,14 +1,37 @@
 #include "Idl/FaceMessage_TS.hpp"
+#include "Idl/FaceMessageTypeSupportImpl.h"
+#include "dds/FACE/FaceTSS.h"
 
 #ifdef ACE_AS_STATIC_LIBS
 # include "dds/DCPS/RTPS/RtpsDiscovery.h"
 # include "dds/DCPS/transport/rtps_udp/RtpsUdp.h"
 #endif
 
+#include "ace/OS_NS_string.h"
+
 #include <iostream>
 
-int ACE_TMAIN(int, ACE_TCHAR*[])
+namespace {
+  void check_order(const Messenger::Message& msg, long& expected,
+                   FACE::RETURN_CODE_TYPE& status)
+  {
+    std::cout << msg.text.in() << '\t' << msg.count << std::endl;
+    if ((msg.count != expected) && expected > 0) {
+      std::cerr << "ERROR: Expected count " << expected << ", got "
+                << msg.count << std::endl;
+      status = FACE::INVALID_PARAM;
+    } else {
+      expected = msg.count + 1;
+    }
+  }
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
 {
+  // "batch" receives with receive_messages() instead of Receive_Message()
+  const bool batch = argc > 1 && 0 == ACE_OS::strcmp(argv[1], ACE_TEXT("batch"));
+  const CORBA::Long max_batch = 8;
+
   FACE::RETURN_CODE_TYPE status = FACE::RC_NO_ERROR;
   FACE::TS::Initialize("face_config.ini", status);
   FACE::CONNECTION_ID_TYPE connId;
@@ -31,19 +54,30 @@ int ACE_TMAIN(int, ACE_TCHAR*[])
     FACE::TRANSACTION_ID_TYPE txn;
     Messenger::Message msg;
     long expected = 0;
-    std::cout << "Subscriber: about to receive_message()" << std::endl;
+    std::cout << "Subscriber: about to receive_message"
+              << (batch ? "s()" : "()") << std::endl;
     while (expected <= 19) {
-      FACE::TS::Receive_Message(connId, timeout, txn, msg, size, status);
-      if (status != FACE::RC_NO_ERROR) break;
-      std::cout << msg.text.in() << '\t' << msg.count << std::endl;
-      if ((msg.count != expected) && expected > 0) {
-        std::cerr << "ERROR: Expected count " << expected << ", got "
-                  << msg.count << std::endl;
-        status = FACE::INVALID_PARAM;
-        break;
+      if (batch) {
+        OpenDDS::DCPS::DDSTraits<Messenger::Message>::MessageSequenceType msgs;
+        OpenDDS::FaceTSS::receive_messages<Messenger::Message>(
+          connId, timeout, txn, msgs, max_batch, size, status);
+        if (status != FACE::RC_NO_ERROR) break;
+        if (msgs.length() == 0 ||
+            msgs.length() > static_cast<CORBA::ULong>(max_batch)) {
+          std::cerr << "ERROR: receive_messages() returned " << msgs.length()
+                    << " messages" << std::endl;
+          status = FACE::INVALID_PARAM;
+          break;
+        }
+        for (CORBA::ULong i = 0; i < msgs.length() && !status; ++i) {
+          check_order(msgs[i], expected, status);
+        }
       } else {
-        expected = msg.count + 1;
+        FACE::TS::Receive_Message(connId, timeout, txn, msg, size, status);
+        if (status != FACE::RC_NO_ERROR) break;
+        check_order(msg, expected, status);
       }
+      if (status != FACE::RC_NO_ERROR) break;
     }
   }
 
@@ -15,7 +15,9 @@ my $test = new PerlDDS::TestFramework();
 
 $test->enable_console_logging();
 
-$test->process('Subscriber', 'Subscriber/subscriber');
+my $sub_args = $test->flag('batch') ? 'batch' : '';
+
+$test->process('Subscriber', 'Subscriber/subscriber', $sub_args);
 $test->start_process('Subscriber');
 sleep 5;
 